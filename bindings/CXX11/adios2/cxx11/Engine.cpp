@@ -97,6 +97,12 @@ void Engine::PerformGets()
     m_Engine->PerformGets();
 }
 
+bool Engine::GetsCompleted()
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::GetsCompleted");
+    return m_Engine->GetsCompleted();
+}
+
 void Engine::LockWriterDefinitions()
 {
     helper::CheckForNullptr(m_Engine,
@@ -240,6 +240,15 @@ public:
      * collective call and can only be called between Begin/EndStep pairs. */
     void PerformDataWrite();
 
+    /**
+     * Non-blocking check whether the data of the last EndStep is in place.
+     * Engines that read in the background (BP5 with AsyncRead=true) return
+     * false while reads are in flight, all others return true. The next BeginStep, Get, PerformGets or Close waits for
+     * the reads to finish.
+     * @return true if the data of earlier Gets can be used
+     */
+    bool GetsCompleted();
+
     /**
      * Get data associated with a Variable from the Engine
      * @param variable contains variable metadata information
@@ -22,4 +22,11 @@ void QueryWorker::GetResultCoverage(
     if (m_Worker)
         return m_Worker->GetResultCoverage(outputSelection, touched_blocks);
 }
+
+void QueryWorker::GetResultPoints(adios2::Box<adios2::Dims> &outputSelection,
+                                  std::vector<adios2::Dims> &points)
+{
+    if (m_Worker)
+        return m_Worker->GetResultPoints(outputSelection, points);
+}
 }
@@ -32,6 +32,15 @@ public:
     GetResultCoverage(adios2::Box<adios2::Dims> &,
                       std::vector<adios2::Box<adios2::Dims>> &touched_blocks);
 
+    /**
+     * Evaluates the query on the elements of the current step instead of
+     * only on the min/max of the blocks. Reads the candidate blocks and
+     * performs any pending deferred Gets of the engine.
+     * @param points coordinates of the matching elements, in row-major order
+     */
+    void GetResultPoints(adios2::Box<adios2::Dims> &,
+                         std::vector<adios2::Dims> &points);
+
 private:
     std::shared_ptr<adios2::query::Worker> m_Worker;
 }; // class QueryWorker
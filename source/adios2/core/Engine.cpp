@@ -70,6 +70,7 @@ size_t Engine::CurrentStep() const
 void Engine::EndStep() { ThrowUp("EndStep"); }
 void Engine::PerformPuts() { ThrowUp("PerformPuts"); }
 void Engine::PerformGets() { ThrowUp("PerformGets"); }
+bool Engine::GetsCompleted() noexcept { return true; }
 void Engine::PerformDataWrite() { return; }
 
 void Engine::Close(const int transportIndex)
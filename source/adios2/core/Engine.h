@@ -377,6 +377,10 @@ public:
      * PerformGets, BeginStep or Open */
     virtual void PerformGets();
 
+    /** Non-blocking check whether the data of the last EndStep is in
+     * place. Only engines that read in the background return false */
+    virtual bool GetsCompleted() noexcept;
+
     /** Write array data to disk.  This may relieve memory pressure by clearing
      * ADIOS buffers.  It is a collective call. */
     virtual void PerformDataWrite();
@@ -114,6 +114,30 @@ std::string BP5Engine::GetBPVersionFileName(const std::string &name) const
     return bpVersionFileName;
 }
 
+unsigned int BP5Engine::GetDefaultThreads(helper::Comm const &comm) const
+{
+    helper::Comm nodeComm =
+        comm.GroupByShm("creating per-node comm at BP5 Open");
+    unsigned int NodeSize = static_cast<unsigned int>(nodeComm.Size());
+    unsigned int NodeThreadSize = helper::NumHardwareThreadsPerNode();
+    if (NodeThreadSize > 0)
+    {
+        return helper::SetWithinLimit(NodeThreadSize / NodeSize, 1U, 16U);
+    }
+    return helper::SetWithinLimit(8U / NodeSize, 1U, 8U);
+}
+
+std::vector<Params> BP5Engine::GetBPMetadataTransportsParameters(
+    const std::vector<Params> &transportsParameters) const
+{
+    std::vector<Params> metadataParameters = transportsParameters;
+    for (auto &parameters : metadataParameters)
+    {
+        parameters["FileRole"] = "metadata";
+    }
+    return metadataParameters;
+}
+
 std::string BP5Engine::GetBPSubStreamName(const std::string &name,
                                           const size_t id,
                                           const bool hasSubFiles,
@@ -30,6 +30,15 @@ namespace engine
  */
 constexpr size_t DefaultStatsBlockSize = 1125899906842624ULL;
 
+/**
+ * reads of one subfile closer than this many bytes are merged into one
+ * read by the reader, so the gap is read and thrown away
+ */
+constexpr size_t DefaultReadCoalesceGap = 64 * 1024;
+
+/** upper limit of a merged read, single requests may be larger */
+constexpr size_t DefaultMaxCoalescedReadSize = 16 * 1024 * 1024;
+
 class BP5Engine
 {
 public:
@@ -104,6 +113,21 @@ public:
 
     std::string GetBPVersionFileName(const std::string &name) const noexcept;
 
+    /**
+     * Number of threads a rank may use when the Threads parameter is 0,
+     * sharing the hardware threads of the node with the other ranks on it.
+     * Collective over comm
+     */
+    unsigned int GetDefaultThreads(helper::Comm const &comm) const;
+
+    /**
+     * Copy of the transport parameters for metadata files (md.idx, md.N,
+     * mmd.N), tagged with FileRole=metadata so transports can place them
+     * apart from the data files
+     */
+    std::vector<Params> GetBPMetadataTransportsParameters(
+        const std::vector<Params> &transportsParameters) const;
+
     enum class BufferVType
     {
         MallocVType,
@@ -134,6 +158,11 @@ public:
     MACRO(StreamReader, Bool, bool, false)                                     \
     MACRO(BurstBufferDrain, Bool, bool, true)                                  \
     MACRO(BurstBufferPath, String, std::string, "")                            \
+    MACRO(BurstBufferVerbose, Int, int, 0)                                     \
+    MACRO(BurstBufferDrainThreads, UInt, unsigned int, 4)                      \
+    MACRO(BurstBufferDrainBlockSize, SizeBytes, size_t, 16777216)              \
+    MACRO(BurstBufferDrainDirectIO, Bool, bool, false)                         \
+    MACRO(BurstBufferDrainMaxPending, SizeBytes, size_t, 0)                    \
     MACRO(NodeLocal, Bool, bool, false)                                        \
     MACRO(verbose, Int, int, 0)                                                \
     MACRO(CollectiveMetadata, Bool, bool, true)                                \
@@ -148,6 +177,8 @@ public:
           (int)AggregationType::TwoLevelShm)                                   \
     MACRO(AsyncOpen, Bool, bool, true)                                         \
     MACRO(AsyncWrite, AsyncWrite, int, (int)AsyncWrite::Sync)                  \
+    MACRO(AsyncCompression, Bool, bool, false)                                 \
+    MACRO(CompressionSubBlockSize, SizeBytes, size_t, 0)                       \
     MACRO(GrowthFactor, Float, float, DefaultBufferGrowthFactor)               \
     MACRO(InitialBufferSize, SizeBytes, size_t, DefaultInitialBufferSize)      \
     MACRO(MinDeferredSize, SizeBytes, size_t, DefaultMinDeferredSize)          \
@@ -161,7 +192,12 @@ public:
     MACRO(StatsBlockSize, SizeBytes, size_t, DefaultStatsBlockSize)            \
     MACRO(Threads, UInt, unsigned int, 0)                                      \
     MACRO(UseOneTimeAttributes, Bool, bool, true)                              \
-    MACRO(MaxOpenFilesAtOnce, UInt, unsigned int, UINT_MAX)
+    MACRO(MaxOpenFilesAtOnce, UInt, unsigned int, UINT_MAX)                    \
+    MACRO(ReadCoalesceGap, SizeBytes, size_t, DefaultReadCoalesceGap)          \
+    MACRO(AsyncRead, Bool, bool, false)                                        \
+    MACRO(MaxMetadataStepsInMemory, UInt, unsigned int, 0)                     \
+    MACRO(NumShmBuffers, UInt, unsigned int, 2)                                \
+    MACRO(ProfileTrace, Bool, bool, false)
 
     struct BP5Params
     {
@@ -12,8 +12,13 @@
 #include "adios2/helper/adiosMath.h" // SetWithinLimit
 #include <adios2-perfstubs-interface.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <errno.h>
+#include <functional> // std::ref
+#include <future>
 #include <mutex>
 #include <thread>
 
@@ -28,6 +33,11 @@ namespace core
 namespace engine
 {
 
+/* PerformGets() wakes one more thread for this much data or this many reads
+ */
+static constexpr size_t MinReadSizePerThread = 256 * 1024;
+static constexpr size_t MinReadsPerThread = 16;
+
 BP5Reader::BP5Reader(IO &io, const std::string &name, const Mode mode,
                      helper::Comm comm)
 : Engine("BP5Reader", io, name, mode, std::move(comm)),
@@ -42,6 +52,11 @@ BP5Reader::BP5Reader(IO &io, const std::string &name, const Mode mode,
 
 BP5Reader::~BP5Reader()
 {
+    if (m_PendingGets.valid())
+    {
+        m_PendingGets.wait();
+    }
+    StopReadThreads();
     if (m_BP5Deserializer)
         delete m_BP5Deserializer;
     if (m_IsOpen)
@@ -60,7 +75,44 @@ void BP5Reader::DestructorClose(bool Verbose) noexcept
 
 void BP5Reader::InstallMetadataForTimestep(size_t Step)
 {
-    size_t pgstart = m_MetadataIndexTable[Step][0];
+    if (m_Parameters.MaxMetadataStepsInMemory)
+    {
+        // rank 0 reads the step for everyone, the deserializer owns it
+        std::vector<char> &buffer = m_BP5Deserializer->MetadataStepBuffer(Step);
+        if (m_Comm.Rank() == 0)
+        {
+            ReadMetadataStep(Step, buffer);
+        }
+        m_Comm.BroadcastVector(buffer);
+        InstallMetadataFromBuffer(Step, buffer, 0, true);
+    }
+    else
+    {
+        InstallMetadataFromBuffer(Step, m_Metadata.m_Buffer,
+                                  m_MetadataIndexTable[Step][0], true);
+    }
+}
+
+void BP5Reader::ReadMetadataStep(size_t Step, std::vector<char> &buffer)
+{
+    const std::vector<uint64_t> &ptrs = m_MetadataIndexTable[Step];
+    buffer.resize(ptrs[1]);
+    m_MDFileManager.ReadFile(buffer.data(), ptrs[1], ptrs[4]);
+}
+
+void BP5Reader::LoadMetadataStep(size_t Step)
+{
+    // not collective, every process reads md.0 on its own
+    std::vector<char> &buffer = m_BP5Deserializer->MetadataStepBuffer(Step);
+    ReadMetadataStep(Step, buffer);
+    // the attributes are installed already
+    InstallMetadataFromBuffer(Step, buffer, 0, false);
+}
+
+void BP5Reader::InstallMetadataFromBuffer(size_t Step,
+                                          std::vector<char> &buffer,
+                                          size_t pgstart, bool withAttributes)
+{
     size_t Position = pgstart + sizeof(uint64_t); // skip total data size
     const uint64_t WriterCount =
         m_WriterMap[m_WriterMapIndex[Step]].WriterCount;
@@ -69,8 +121,8 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     {
         // variable metadata for timestep
         size_t ThisMDSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisMD = m_Metadata.m_Buffer.data() + MDPosition;
+            buffer, Position, m_Minifooter.IsLittleEndian);
+        char *ThisMD = buffer.data() + MDPosition;
         if (m_OpenMode == Mode::ReadRandomAccess)
         {
             m_BP5Deserializer->InstallMetaData(ThisMD, ThisMDSize, WriterRank,
@@ -82,12 +134,16 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
         }
         MDPosition += ThisMDSize;
     }
+    if (!withAttributes)
+    {
+        return;
+    }
     for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
     {
         // attribute metadata for timestep
         size_t ThisADSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisAD = m_Metadata.m_Buffer.data() + MDPosition;
+            buffer, Position, m_Minifooter.IsLittleEndian);
+        char *ThisAD = buffer.data() + MDPosition;
         if (ThisADSize > 0)
             m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
         MDPosition += ThisADSize;
@@ -110,6 +166,8 @@ StepStatus BP5Reader::BeginStep(StepMode mode, const float timeoutSeconds)
                                         "BeginStep() is called a second time "
                                         "without an intervening EndStep()");
     }
+    // the reads of the previous step use its metadata
+    WaitForGets();
 
     if (mode != StepMode::Read)
     {
@@ -200,45 +258,31 @@ void BP5Reader::EndStep()
     }
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER("BP5Reader::EndStep");
-    PerformGets();
+    WaitForGets();
+    if (m_Parameters.AsyncRead)
+    {
+        // WaitForGets() or GetsCompleted() picks up the result
+        m_PendingGets =
+            std::async(std::launch::async, &BP5Reader::DoPerformGets, this);
+    }
+    else
+    {
+        DoPerformGets();
+    }
 }
 
-std::pair<double, double>
-BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
-                    const size_t maxOpenFiles, const size_t WriterRank,
-                    const size_t Timestep, const size_t StartOffset,
-                    const size_t Length, char *Destination)
+std::pair<size_t, size_t>
+BP5Reader::GetDataFileLocation(const size_t WriterRank, const size_t Timestep,
+                               const size_t StartOffset)
 {
-    /*
-     * Warning: this function is called by multiple threads
-     */
     size_t FlushCount = m_MetadataIndexTable[Timestep][2];
     size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
     size_t SubfileNum = static_cast<size_t>(
         m_WriterMap[m_WriterMapIndex[Timestep]].RankToSubfile[WriterRank]);
 
-    // check if subfile is already opened
-    TP startSubfile = NOW();
-    if (FileManager.m_Transports.count(SubfileNum) == 0)
-    {
-        const std::string subFileName = GetBPSubStreamName(
-            m_Name, SubfileNum, m_Minifooter.HasSubFiles, true);
-        if (FileManager.m_Transports.size() >= maxOpenFiles)
-        {
-            auto m = FileManager.m_Transports.begin();
-            FileManager.CloseFiles((int)m->first);
-        }
-        FileManager.OpenFileID(subFileName, SubfileNum, Mode::Read,
-                               m_IO.m_TransportsParameters[0],
-                               /*{{"transport", "File"}},*/ false);
-    }
-    TP endSubfile = NOW();
-    double timeSubfile = DURATION(startSubfile, endSubfile);
-
     /* Each block is in exactly one flush. The StartOffset was calculated
        as if all the flushes were in a single contiguous block in file.
     */
-    TP startRead = NOW();
     size_t InfoStartPos =
         DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
     size_t SumDataSize = 0; // count in contiguous space
@@ -255,11 +299,7 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
         {
             // discount offsets of skipped flushes
             size_t Offset = StartOffset - SumDataSize;
-            FileManager.ReadFile(Destination, Length, ThisDataPos + Offset,
-                                 SubfileNum);
-            TP endRead = NOW();
-            double timeRead = DURATION(startRead, endRead);
-            return std::make_pair(timeSubfile, timeRead);
+            return std::make_pair(SubfileNum, ThisDataPos + Offset);
         }
         SumDataSize += ThisDataSize;
     }
@@ -267,8 +307,47 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
     size_t ThisDataPos = helper::ReadValue<uint64_t>(
         m_MetadataIndex.m_Buffer, InfoStartPos, m_Minifooter.IsLittleEndian);
     size_t Offset = StartOffset - SumDataSize;
-    FileManager.ReadFile(Destination, Length, ThisDataPos + Offset, SubfileNum);
+    return std::make_pair(SubfileNum, ThisDataPos + Offset);
+}
+
+void BP5Reader::OpenDataFile(adios2::transportman::TransportMan &FileManager,
+                             const size_t maxOpenFiles, const size_t SubfileNum)
+{
+    // check if subfile is already opened
+    if (FileManager.m_Transports.count(SubfileNum) == 0)
+    {
+        const std::string subFileName = GetBPSubStreamName(
+            m_Name, SubfileNum, m_Minifooter.HasSubFiles, true);
+        if (FileManager.m_Transports.size() >= maxOpenFiles)
+        {
+            auto m = FileManager.m_Transports.begin();
+            FileManager.CloseFiles((int)m->first);
+        }
+        FileManager.OpenFileID(subFileName, SubfileNum, Mode::Read,
+                               m_IO.m_TransportsParameters[0],
+                               /*{{"transport", "File"}},*/ false);
+    }
+}
+
+std::pair<double, double>
+BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
+                    const size_t maxOpenFiles, const size_t WriterRank,
+                    const size_t Timestep, const size_t StartOffset,
+                    const size_t Length, char *Destination)
+{
+    /*
+     * Warning: this function is called by multiple threads
+     */
+    const std::pair<size_t, size_t> location =
+        GetDataFileLocation(WriterRank, Timestep, StartOffset);
 
+    TP startSubfile = NOW();
+    OpenDataFile(FileManager, maxOpenFiles, location.first);
+    TP endSubfile = NOW();
+    double timeSubfile = DURATION(startSubfile, endSubfile);
+
+    TP startRead = NOW();
+    FileManager.ReadFile(Destination, Length, location.second, location.first);
     TP endRead = NOW();
     double timeRead = DURATION(startRead, endRead);
     return std::make_pair(timeSubfile, timeRead);
@@ -276,18 +355,33 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
 
 void BP5Reader::PerformGets()
 {
-    auto lf_CompareReqSubfile =
-        [&](adios2::format::BP5Deserializer::ReadRequest &r1,
-            adios2::format::BP5Deserializer::ReadRequest &r2) -> bool {
-        return (m_WriterMap[m_WriterMapIndex[r1.Timestep]]
-                    .RankToSubfile[r1.WriterRank] <
-                m_WriterMap[m_WriterMapIndex[r2.Timestep]]
-                    .RankToSubfile[r2.WriterRank]);
-    };
+    WaitForGets();
+    DoPerformGets();
+}
+
+void BP5Reader::WaitForGets()
+{
+    if (m_PendingGets.valid())
+    {
+        // rethrows what the reads threw
+        m_PendingGets.get();
+    }
+}
 
+bool BP5Reader::GetsCompleted() noexcept
+{
+    return !m_PendingGets.valid() ||
+           m_PendingGets.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+}
+
+void BP5Reader::DoPerformGets()
+{
     // TP start = NOW();
     PERFSTUBS_SCOPED_TIMER("BP5Reader::PerformGets");
     size_t maxReadSize;
+    // the steps the requests install stay until FinalizeGets()
+    m_BP5Deserializer->HoldMetadataSteps(true);
 
     // TP startGenerate = NOW();
     auto ReadRequests =
@@ -296,127 +390,204 @@ void BP5Reader::PerformGets()
     // TP endGenerate = NOW();
     // double generateTime = DURATION(startGenerate, endGenerate);
 
-    size_t nextRequest = 0;
-    std::mutex mutexReadRequests;
+    /* Order the requests by subfile and by position in it, so each subfile
+       is read front to back and its transport can fetch ahead of the reads
+    */
+    std::vector<std::pair<size_t, size_t>> locations(nRequest);
+    {
+        std::vector<size_t> order(nRequest);
+        for (size_t i = 0; i < nRequest; ++i)
+        {
+            const auto &Req = ReadRequests[i];
+            locations[i] = GetDataFileLocation(Req.WriterRank, Req.Timestep,
+                                               Req.StartOffset);
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t i1, size_t i2) {
+            return locations[i1] < locations[i2];
+        });
+
+        std::vector<format::BP5Deserializer::ReadRequest> sortedRequests;
+        std::vector<std::pair<size_t, size_t>> sortedLocations;
+        sortedRequests.reserve(nRequest);
+        sortedLocations.reserve(nRequest);
+        for (const size_t i : order)
+        {
+            sortedRequests.push_back(ReadRequests[i]);
+            sortedLocations.push_back(locations[i]);
+        }
+        ReadRequests.swap(sortedRequests);
+        locations.swap(sortedLocations);
+    }
+
+    /* Merge neighbours in a subfile whose gap is small enough into one read
+       into a staging buffer, FinalizeGet() picks the pieces from there.
+       groups[g] is the range of requests read at once */
+    std::vector<std::pair<size_t, size_t>> groups;
+    std::vector<size_t> groupLengths;
+    size_t maxGroupLength = 0;
+    for (size_t i = 0; i < nRequest; ++i)
+    {
+        const size_t reqEnd = locations[i].second + ReadRequests[i].ReadLength;
+        if (!groups.empty())
+        {
+            const size_t first = groups.back().first;
+            const size_t groupEnd =
+                locations[first].second + groupLengths.back();
+            const size_t mergedLength =
+                std::max(groupEnd, reqEnd) - locations[first].second;
+            const size_t maxStart = groupEnd + m_Parameters.ReadCoalesceGap;
+            if (locations[i].first == locations[first].first &&
+                locations[i].second <= maxStart &&
+                mergedLength <= DefaultMaxCoalescedReadSize)
+            {
+                groups.back().second = i + 1;
+                groupLengths.back() = mergedLength;
+                continue;
+            }
+        }
+        groups.emplace_back(i, i + 1);
+        groupLengths.push_back(ReadRequests[i].ReadLength);
+    }
+    const size_t nGroup = groups.size();
+    for (size_t g = 0; g < nGroup; ++g)
+    {
+        if (groups[g].second - groups[g].first > 1)
+        {
+            maxGroupLength = std::max(maxGroupLength, groupLengths[g]);
+        }
+    }
+
+    /* Only wake as many threads as there is work for, by the number and
+       by the total size of the reads */
+    size_t nThreads = 1;
+    if (m_Threads > 1 && nGroup > 1)
+    {
+        size_t totalLength = 0;
+        for (const size_t length : groupLengths)
+        {
+            totalLength += length;
+        }
+        nThreads = 1 + std::max(totalLength / MinReadSizePerThread,
+                                nGroup / MinReadsPerThread);
+        nThreads = std::min({nThreads, (size_t)m_Threads, nGroup});
+    }
 
-    auto lf_GetNextRequest = [&]() -> size_t {
-        std::lock_guard<std::mutex> lockGuard(mutexReadRequests);
-        size_t reqidx = MaxSizeT;
-        if (nextRequest < nRequest)
+    /* Threads take batches of consecutive reads of the same subfile.
+       Several batches per thread keep the load balanced */
+    const size_t batchSize =
+        nThreads > 1
+            ? helper::SetWithinLimit(nGroup / (4 * nThreads), (size_t)1,
+                                     MaxSizeT)
+            : MaxSizeT;
+    std::vector<std::pair<size_t, size_t>> batches;
+    for (size_t begin = 0; begin < nGroup;)
+    {
+        size_t end = begin;
+        while (end < nGroup && end - begin < batchSize &&
+               locations[groups[end].first].first ==
+                   locations[groups[begin].first].first)
         {
-            reqidx = nextRequest;
-            ++nextRequest;
+            ++end;
         }
-        return reqidx;
-    };
+        batches.emplace_back(begin, end);
+        begin = end;
+    }
+    std::atomic<size_t> nextBatch(0);
+    // idle threads help copy into user memory when only one of them reads
+    const unsigned int copyThreads = nThreads > 1 ? 1 : m_Threads;
 
-    auto lf_Reader = [&](const int FileManagerID, const size_t maxOpenFiles)
+    auto lf_Reader = [&](adios2::transportman::TransportMan &FileManager,
+                         const size_t maxOpenFiles, std::vector<char> &buf)
         -> std::tuple<double, double, double, size_t> {
         double copyTotal = 0.0;
         double readTotal = 0.0;
         double subfileTotal = 0.0;
         size_t nReads = 0;
-        std::vector<char> buf(maxReadSize);
+        const size_t bufSize = std::max(maxReadSize, maxGroupLength);
+        if (buf.size() < bufSize)
+        {
+            buf.resize(bufSize);
+        }
+        std::vector<std::pair<size_t, size_t>> ranges;
 
-        while (true)
+        for (size_t b = nextBatch++; b < batches.size(); b = nextBatch++)
         {
-            const auto reqidx = lf_GetNextRequest();
-            if (reqidx > nRequest)
+            const auto &batch = batches[b];
+            if (batch.second - batch.first > 1)
             {
-                break;
+                const size_t SubfileNum =
+                    locations[groups[batch.first].first].first;
+                ranges.clear();
+                for (size_t g = batch.first; g < batch.second; ++g)
+                {
+                    ranges.emplace_back(locations[groups[g].first].second,
+                                        groupLengths[g]);
+                }
+                OpenDataFile(FileManager, maxOpenFiles, SubfileNum);
+                FileManager.PrefetchFile(ranges, SubfileNum);
             }
-            auto &Req = ReadRequests[reqidx];
-            if (!Req.DestinationAddr)
+
+            for (size_t g = batch.first; g < batch.second; ++g)
             {
-                Req.DestinationAddr = buf.data();
+                const size_t first = groups[g].first;
+                auto &FirstReq = ReadRequests[first];
+                const bool merged = groups[g].second - first > 1;
+                char *Destination = buf.data();
+                if (!merged && FirstReq.DestinationAddr)
+                {
+                    Destination = FirstReq.DestinationAddr;
+                }
+                std::pair<double, double> t =
+                    ReadData(FileManager, maxOpenFiles, FirstReq.WriterRank,
+                             FirstReq.Timestep, FirstReq.StartOffset,
+                             groupLengths[g], Destination);
+                subfileTotal += t.first;
+                readTotal += t.second;
+                ++nReads;
+
+                TP startCopy = NOW();
+                for (size_t reqidx = first; reqidx < groups[g].second;
+                     ++reqidx)
+                {
+                    auto &Req = ReadRequests[reqidx];
+                    char *Piece = Destination + (locations[reqidx].second -
+                                                 locations[first].second);
+                    if (!Req.DestinationAddr)
+                    {
+                        Req.DestinationAddr = Piece;
+                    }
+                    else if (Req.DestinationAddr != Piece)
+                    {
+                        // direct read into user memory, merged away
+                        std::memcpy(Req.DestinationAddr, Piece,
+                                    Req.ReadLength);
+                    }
+                    m_BP5Deserializer->FinalizeGet(Req, false, copyThreads);
+                }
+                TP endCopy = NOW();
+                copyTotal += DURATION(startCopy, endCopy);
             }
-            std::pair<double, double> t =
-                ReadData(fileManagers[FileManagerID], maxOpenFiles,
-                         Req.WriterRank, Req.Timestep, Req.StartOffset,
-                         Req.ReadLength, Req.DestinationAddr);
-
-            TP startCopy = NOW();
-            m_BP5Deserializer->FinalizeGet(Req, false);
-            TP endCopy = NOW();
-            subfileTotal += t.first;
-            readTotal += t.second;
-            copyTotal += DURATION(startCopy, endCopy);
-            ++nReads;
         }
         return std::make_tuple(subfileTotal, readTotal, copyTotal, nReads);
     };
 
     // TP startRead = NOW();
-    // double sortTime = 0.0;
-    if (m_Threads > 1 && nRequest > 1)
+    if (nThreads > 1)
     {
-        // TP startSort = NOW();
-        std::sort(ReadRequests.begin(), ReadRequests.end(),
-                  lf_CompareReqSubfile);
-        // TP endSort = NOW();
-        // sortTime = DURATION(startSort, endSort);
-        size_t nThreads = (m_Threads < nRequest ? m_Threads : nRequest);
-
+        // the files stay open in all threads between calls
         size_t maxOpenFiles = helper::SetWithinLimit(
-            (size_t)m_Parameters.MaxOpenFilesAtOnce / nThreads, (size_t)1,
+            (size_t)m_Parameters.MaxOpenFilesAtOnce / m_Threads, (size_t)1,
             MaxSizeT);
-
-        std::vector<std::future<std::tuple<double, double, double, size_t>>>
-            futures(nThreads - 1);
-
-        // launch Threads-1 threads to process subsets of requests,
-        // then main thread process the last subset
-        for (size_t tid = 0; tid < nThreads - 1; ++tid)
-        {
-            futures[tid] = std::async(std::launch::async, lf_Reader, tid + 1,
-                                      maxOpenFiles);
-        }
-        // main thread runs last subset of reads
-        /*auto tMain = */ lf_Reader(0, maxOpenFiles);
-        /*{
-            double tSubfile = std::get<0>(tMain);
-            double tRead = std::get<1>(tMain);
-            double tCopy = std::get<2>(tMain);
-            size_t nReads = std::get<3>(tMain);
-            std::cout << " -> PerformGets() thread MAIN total = "
-                      << tSubfile + tRead + tCopy << "s, subfile = " << tSubfile
-                      << "s, read = " << tRead << "s, copy = " << tCopy
-                      << ", nReads = " << nReads << std::endl;
-        }*/
-
-        // wait for all async threads
-        int tid = 1;
-        for (auto &f : futures)
-        {
-            /*auto t = */ f.get();
-            /*double tSubfile = std::get<0>(t);
-            double tRead = std::get<1>(t);
-            double tCopy = std::get<2>(t);
-            size_t nReads = std::get<3>(t);
-            std::cout << " -> PerformGets() thread " << tid
-                      << " total = " << tSubfile + tRead + tCopy
-                      << "s, subfile = " << tSubfile << "s, read = " << tRead
-                      << "s, copy = " << tCopy << ", nReads = " << nReads
-                      << std::endl;*/
-            ++tid;
-        }
+        RunReadJob(nThreads, [&](size_t tid) {
+            lf_Reader(fileManagers[tid], maxOpenFiles, m_ReadBuffers[tid]);
+        });
     }
     else
     {
         size_t maxOpenFiles = helper::SetWithinLimit(
             (size_t)m_Parameters.MaxOpenFilesAtOnce, (size_t)1, MaxSizeT);
-        std::vector<char> buf(maxReadSize);
-        for (auto &Req : ReadRequests)
-        {
-            if (!Req.DestinationAddr)
-            {
-                Req.DestinationAddr = buf.data();
-            }
-            ReadData(m_DataFileManager, maxOpenFiles, Req.WriterRank,
-                     Req.Timestep, Req.StartOffset, Req.ReadLength,
-                     Req.DestinationAddr);
-            m_BP5Deserializer->FinalizeGet(Req, false);
-        }
+        lf_Reader(m_DataFileManager, maxOpenFiles, m_ReadBuffers[0]);
     }
 
     // clear pending requests inside deserializer
@@ -424,15 +595,117 @@ void BP5Reader::PerformGets()
         std::vector<adios2::format::BP5Deserializer::ReadRequest> empty;
         m_BP5Deserializer->FinalizeGets(empty);
     }
+    m_BP5Deserializer->HoldMetadataSteps(false);
 
     /*TP end = NOW();
     double t1 = DURATION(start, end);
     double t2 = DURATION(startRead, end);
     std::cout << " -> PerformGets() total = " << t1 << "s, Read loop = " << t2
-              << "s, sort = " << sortTime << "s, generate = " << generateTime
+              << "s, generate = " << generateTime
               << ", nRequests = " << nRequest << std::endl;*/
 }
 
+void BP5Reader::ReadThread(const size_t tid, size_t generation)
+{
+    std::unique_lock<std::mutex> lock(m_ReadPoolMutex);
+    while (true)
+    {
+        m_ReadPoolWake.wait(lock, [&]() {
+            return m_ReadPoolStop || m_ReadJobGeneration != generation;
+        });
+        if (m_ReadPoolStop)
+        {
+            return;
+        }
+        generation = m_ReadJobGeneration;
+        if (tid >= m_ReadJobThreads)
+        {
+            continue; // not needed for this job
+        }
+
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            m_ReadJob(tid);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !m_ReadJobError)
+        {
+            m_ReadJobError = error;
+        }
+        if (--m_ReadJobPending == 0)
+        {
+            m_ReadPoolDone.notify_one();
+        }
+    }
+}
+
+void BP5Reader::RunReadJob(const size_t nThreads,
+                           const std::function<void(size_t)> &job)
+{
+    // start the threads at first use, they live until Close()
+    while (m_ReadThreads.size() + 1 < nThreads)
+    {
+        m_ReadThreads.emplace_back(&BP5Reader::ReadThread, this,
+                                   m_ReadThreads.size() + 1,
+                                   m_ReadJobGeneration);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_ReadPoolMutex);
+        m_ReadJob = job;
+        m_ReadJobThreads = nThreads;
+        m_ReadJobPending = nThreads - 1;
+        m_ReadJobError = nullptr;
+        ++m_ReadJobGeneration;
+    }
+    m_ReadPoolWake.notify_all();
+
+    std::exception_ptr error;
+    try
+    {
+        job(0);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(m_ReadPoolMutex);
+    m_ReadPoolDone.wait(lock, [&]() { return m_ReadJobPending == 0; });
+    m_ReadJob = nullptr;
+    if (!error)
+    {
+        error = m_ReadJobError;
+    }
+    lock.unlock();
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void BP5Reader::StopReadThreads() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_ReadPoolMutex);
+        m_ReadPoolStop = true;
+    }
+    m_ReadPoolWake.notify_all();
+    for (auto &thread : m_ReadThreads)
+    {
+        thread.join();
+    }
+    m_ReadThreads.clear();
+    m_ReadPoolStop = false;
+}
+
 // PRIVATE
 void BP5Reader::Init()
 {
@@ -488,19 +761,7 @@ void BP5Reader::InitParameters()
     m_Threads = m_Parameters.Threads;
     if (m_Threads == 0)
     {
-        helper::Comm m_NodeComm =
-            m_Comm.GroupByShm("creating per-node comm at BP5 Open(read)");
-        unsigned int NodeSize = static_cast<unsigned int>(m_NodeComm.Size());
-        unsigned int NodeThreadSize = helper::NumHardwareThreadsPerNode();
-        if (NodeThreadSize > 0)
-        {
-            m_Threads =
-                helper::SetWithinLimit(NodeThreadSize / NodeSize, 1U, 16U);
-        }
-        else
-        {
-            m_Threads = helper::SetWithinLimit(8U / NodeSize, 1U, 8U);
-        }
+        m_Threads = GetDefaultThreads(m_Comm);
     }
 
     // Create m_Threads-1  extra file managers to be used by threads
@@ -511,6 +772,13 @@ void BP5Reader::InitParameters()
         fileManagers.push_back(transportman::TransportMan(
             transportman::TransportMan(m_IO, singleComm)));
     }
+    m_ReadBuffers.resize(m_Threads);
+
+    if (m_OpenMode != Mode::ReadRandomAccess)
+    {
+        // streaming installs one step at a time anyway
+        m_Parameters.MaxMetadataStepsInMemory = 0;
+    }
 
     size_t limit = helper::RaiseLimitNoFile();
     if (m_Parameters.MaxOpenFilesAtOnce > limit - 8)
@@ -551,8 +819,11 @@ size_t BP5Reader::OpenWithTimeout(transportman::TransportMan &tm,
             errno = 0;
             const bool profile =
                 false; // m_BP4Deserializer.m_Profiler.m_IsActive;
+            // Only used for the metadata files
             tm.OpenFiles(fileNames, adios2::Mode::Read,
-                         m_IO.m_TransportsParameters, profile);
+                         GetBPMetadataTransportsParameters(
+                             m_IO.m_TransportsParameters),
+                         profile);
             flag = 0; // found file
             break;
         }
@@ -673,6 +944,19 @@ void BP5Reader::OpenFiles(TimePoint &timeoutInstant, const Seconds &pollSeconds,
         }
     }
 
+    if (m_Parameters.MaxMetadataStepsInMemory && m_Comm.Rank() != 0)
+    {
+        /* Evicted steps are read back from md.0 by every process */
+        const std::string metadataFile(GetBPMetadataFileName(m_Name));
+        if (OpenWithTimeout(m_MDFileManager, {metadataFile}, timeoutInstant,
+                            pollSeconds, lasterrmsg) != 0)
+        {
+            helper::Throw<std::ios_base::failure>(
+                "Engine", "BP5Reader", "OpenFiles",
+                "File " + m_Name + " cannot be opened: " + lasterrmsg);
+        }
+    }
+
     /* At this point we may have an empty index table.
      * The writer has created the file but no content may have been stored yet.
      */
@@ -811,15 +1095,20 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant,
 
             if (actualFileSize >= expectedMinFileSize)
             {
-                m_Metadata.Resize(fileFilteredSize,
-                                  "allocating metadata buffer, "
-                                  "in call to BP5Reader Open");
-                size_t mempos = 0;
-                for (auto p : m_FilteredMetadataInfo)
+                // otherwise the steps are read one by one when installed
+                if (!m_Parameters.MaxMetadataStepsInMemory)
                 {
-                    m_MDFileManager.ReadFile(
-                        m_Metadata.m_Buffer.data() + mempos, p.second, p.first);
-                    mempos += p.second;
+                    m_Metadata.Resize(fileFilteredSize,
+                                      "allocating metadata buffer, "
+                                      "in call to BP5Reader Open");
+                    size_t mempos = 0;
+                    for (auto p : m_FilteredMetadataInfo)
+                    {
+                        m_MDFileManager.ReadFile(
+                            m_Metadata.m_Buffer.data() + mempos, p.second,
+                            p.first);
+                        mempos += p.second;
+                    }
                 }
                 m_MDFileAlreadyReadSize = expectedMinFileSize;
             }
@@ -871,6 +1160,12 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant,
 
         if (m_OpenMode == Mode::ReadRandomAccess)
         {
+            if (m_Parameters.MaxMetadataStepsInMemory)
+            {
+                m_BP5Deserializer->SetMaxMetadataSteps(
+                    m_Parameters.MaxMetadataStepsInMemory,
+                    [this](size_t Step) { LoadMetadataStep(Step); });
+            }
             for (size_t Step = 0; Step < m_MetadataIndexTable.size(); Step++)
             {
                 m_BP5Deserializer->SetupForStep(
@@ -1236,10 +1531,12 @@ void BP5Reader::DoClose(const int transportIndex)
     {
         EndStep();
     }
+    WaitForGets();
     m_DataFileManager.CloseFiles();
     m_MDFileManager.CloseFiles();
     m_MDIndexFileManager.CloseFiles();
     m_FileMetaMetadataManager.CloseFiles();
+    StopReadThreads();
     for (unsigned int i = 1; i < m_Threads; ++i)
     {
         fileManagers[i].CloseFiles();
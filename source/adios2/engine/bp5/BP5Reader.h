@@ -21,7 +21,13 @@
 #include "adios2/toolkit/transportman/TransportMan.h"
 
 #include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace adios2
@@ -56,6 +62,8 @@ public:
 
     void PerformGets() final;
 
+    bool GetsCompleted() noexcept final;
+
     MinVarInfo *MinBlocksInfo(const VariableBase &, const size_t Step) const;
     bool VarShape(const VariableBase &Var, const size_t Step,
                   Dims &Shape) const;
@@ -238,6 +246,23 @@ private:
 
     void InstallMetaMetaData(format::BufferSTL MetaMetadata);
     void InstallMetadataForTimestep(size_t Step);
+    /** Installs the metadata of Step starting at pgstart in buffer */
+    void InstallMetadataFromBuffer(size_t Step, std::vector<char> &buffer,
+                                   size_t pgstart, bool withAttributes);
+    /** Reads the metadata of Step alone from md.0 */
+    void ReadMetadataStep(size_t Step, std::vector<char> &buffer);
+    /** Installs a step again that the deserializer evicted in random access
+     * mode with MaxMetadataStepsInMemory */
+    void LoadMetadataStep(size_t Step);
+    /** Subfile holding the data of a writer at a step, and the position in
+     * it of StartOffset */
+    std::pair<size_t, size_t> GetDataFileLocation(const size_t WriterRank,
+                                                  const size_t Timestep,
+                                                  const size_t StartOffset);
+    /** Opens subfile SubfileNum unless already open, closing another one if
+     * maxOpenFiles are open */
+    void OpenDataFile(adios2::transportman::TransportMan &FileManager,
+                      const size_t maxOpenFiles, const size_t SubfileNum);
     std::pair<double, double>
     ReadData(adios2::transportman::TransportMan &FileManager,
              const size_t maxOpenFiles, const size_t WriterRank,
@@ -265,6 +290,36 @@ private:
     helper::Comm singleComm;
     unsigned int m_Threads;
     std::vector<transportman::TransportMan> fileManagers; // manager per thread
+
+    /* Reader threads kept across PerformGets() calls. Thread tid (>= 1)
+       reads through fileManagers[tid], the caller of RunReadJob is tid 0.
+       m_ReadBuffers[tid] is the scratch buffer of each, kept between calls */
+    std::vector<std::thread> m_ReadThreads;
+    std::vector<std::vector<char>> m_ReadBuffers;
+    std::mutex m_ReadPoolMutex;
+    std::condition_variable m_ReadPoolWake;
+    std::condition_variable m_ReadPoolDone;
+    std::function<void(size_t)> m_ReadJob;
+    size_t m_ReadJobGeneration = 0;
+    size_t m_ReadJobThreads = 0; // threads running the job, incl. tid 0
+    size_t m_ReadJobPending = 0;
+    std::exception_ptr m_ReadJobError;
+    bool m_ReadPoolStop = false;
+
+    /** Body of reader thread tid, runs the jobs started after generation */
+    void ReadThread(const size_t tid, size_t generation);
+    /** Runs job(tid) for tid in [0, nThreads) and waits for all of them.
+     * Rethrows the first exception of a job */
+    void RunReadJob(const size_t nThreads,
+                    const std::function<void(size_t)> &job);
+    void StopReadThreads() noexcept;
+
+    /* Reads started by EndStep() with AsyncRead */
+    std::future<void> m_PendingGets;
+    /** Reads all queued Gets before returning */
+    void DoPerformGets();
+    /** Waits for the reads of an earlier EndStep() */
+    void WaitForGets();
 };
 
 } // end namespace engine
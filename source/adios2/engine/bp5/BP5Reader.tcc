@@ -24,13 +24,15 @@ namespace engine
 
 inline void BP5Reader::GetSyncCommon(VariableBase &variable, void *data)
 {
+    WaitForGets();
     bool need_sync = m_BP5Deserializer->QueueGet(variable, data);
     if (need_sync)
-        PerformGets();
+        DoPerformGets();
 }
 
 void BP5Reader::GetDeferredCommon(VariableBase &variable, void *data)
 {
+    WaitForGets();
     (void)m_BP5Deserializer->QueueGet(variable, data);
 }
 
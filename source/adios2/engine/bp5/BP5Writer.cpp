@@ -91,8 +91,17 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
         TimePoint wait_start = Now();
         if (m_WriteFuture.valid())
         {
-            m_Profiler.Start("WaitOnAsync");
+            m_Profiler.Start(profiling::JSONProfiler::WaitOnAsync);
             m_WriteFuture.get();
+            for (const auto &range : m_AsyncDrainRanges)
+            {
+                DrainData(range.first, range.second);
+            }
+            m_AsyncDrainRanges.clear();
+            if (m_DrainBB)
+            {
+                MarkDrainIndexRecord();
+            }
             m_Comm.Barrier();
             AsyncWriteDataCleanup();
             Seconds wait = Now() - wait_start;
@@ -110,7 +119,7 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
                               << std::endl;
                 }
             }
-            m_Profiler.Stop("WaitOnAsync");
+            m_Profiler.Stop(profiling::JSONProfiler::WaitOnAsync);
         }
     }
 
@@ -139,16 +148,17 @@ size_t BP5Writer::CurrentStep() const { return m_WriterStep; }
 void BP5Writer::PerformPuts()
 {
     PERFSTUBS_SCOPED_TIMER("BP5Writer::PerformPuts");
-    m_Profiler.Start("PP");
+    m_Profiler.Start(profiling::JSONProfiler::PP);
     m_BP5Serializer.PerformPuts(m_Parameters.AsyncWrite ||
                                 m_Parameters.DirectIO);
-    m_Profiler.Stop("PP");
+    m_Profiler.Stop(profiling::JSONProfiler::PP);
     return;
 }
 
 void BP5Writer::WriteMetaMetadata(
     const std::vector<format::BP5Base::MetaMetaInfoBlock> MetaMetaBlocks)
 {
+    size_t MetaMetaDataSize = 0;
     for (auto &b : MetaMetaBlocks)
     {
         m_FileMetaMetadataManager.WriteFiles((char *)&b.MetaMetaIDLen,
@@ -159,6 +169,19 @@ void BP5Writer::WriteMetaMetadata(
                                              b.MetaMetaIDLen);
         m_FileMetaMetadataManager.WriteFiles((char *)b.MetaMetaInfo,
                                              b.MetaMetaInfoLen);
+        MetaMetaDataSize +=
+            2 * sizeof(size_t) + b.MetaMetaIDLen + b.MetaMetaInfoLen;
+    }
+
+    if (m_DrainBB && MetaMetaDataSize)
+    {
+        m_FileMetaMetadataManager.FlushFiles();
+        for (size_t i = 0; i < m_MetaMetadataFileNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationCopy(m_MetaMetadataFileNames[i],
+                                           m_DrainMetaMetadataFileNames[i],
+                                           MetaMetaDataSize);
+        }
     }
 }
 
@@ -206,6 +229,17 @@ BP5Writer::WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks,
         MetaDataSize += b.iov_len;
     }
 
+    if (m_DrainBB)
+    {
+        m_FileMetadataManager.FlushFiles();
+        for (size_t i = 0; i < m_MetadataFileNames.size(); ++i)
+        {
+            m_FileDrainer.AddOperationCopyAt(
+                m_MetadataFileNames[i], m_DrainMetadataFileNames[i],
+                m_MetaDataPos, m_MetaDataPos, MetaDataSize);
+        }
+    }
+
     m_MetaDataPos += MetaDataSize;
     return MetaDataSize;
 }
@@ -251,6 +285,12 @@ void BP5Writer::WriteData(format::BufferV *Data)
                     std::to_string(m_Parameters.AggregationType) +
                     "is not supported in BP5");
         }
+        if (m_DrainBB && m_IAmWritingData)
+        {
+            // drained when the writing thread has completed
+            m_AsyncDrainRanges.emplace_back(m_AsyncWriteInfo->startPos,
+                                            m_AsyncWriteInfo->totalSize);
+        }
     }
     else
     {
@@ -308,6 +348,7 @@ void BP5Writer::WriteData_EveryoneWrites(format::BufferV *Data,
     std::vector<core::iovec> DataVec = Data->DataVec();
     m_FileDataManager.WriteFileAt(DataVec.data(), DataVec.size(),
                                   m_StartDataPos);
+    DrainData(m_StartDataPos, Data->Size());
 
     if (SerializedWriters && a->m_Comm.Rank() < a->m_Comm.Size() - 1)
     {
@@ -407,6 +448,11 @@ void BP5Writer::WriteMetadataFileIndex(uint64_t MetaDataPos,
     }
 
     m_FileMetadataIndexManager.WriteFiles((char *)buf.data(), buf.size());
+    if (m_DrainBB)
+    {
+        // drained by DrainMetadataIndex() after the data it points to
+        m_DrainIndexRecords.push_back(buf);
+    }
 
 #ifdef DUMPDATALOCINFO
     std::cout << "Flush count is :" << FlushPosSizeInfo.size() << std::endl;
@@ -529,9 +575,9 @@ void BP5Writer::EndStep()
       std::cout << "END STEP starts at: " << ts.count() << std::endl; */
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER("BP5Writer::EndStep");
-    m_Profiler.Start("endstep");
+    m_Profiler.Start(profiling::JSONProfiler::EndStep);
 
-    m_Profiler.Start("close_ts");
+    m_Profiler.Start(profiling::JSONProfiler::CloseTS);
     MarshalAttributes();
 
     // true: advances step
@@ -542,9 +588,9 @@ void BP5Writer::EndStep()
      * AttributeEncodeBuffer and the data encode Vector */
 
     m_ThisTimestepDataSize += TSInfo.DataBuffer->Size();
-    m_Profiler.Stop("close_ts");
+    m_Profiler.Stop(profiling::JSONProfiler::CloseTS);
 
-    m_Profiler.Start("AWD");
+    m_Profiler.Start(profiling::JSONProfiler::AWD);
     // TSInfo destructor would delete the DataBuffer so we need to save it
     // for async IO and let the writer free it up when not needed anymore
     adios2::format::BufferV *databuf = TSInfo.DataBuffer;
@@ -553,12 +599,12 @@ void BP5Writer::EndStep()
     m_flagRush = false;
     m_AsyncWriteLock.unlock();
     WriteData(databuf);
-    m_Profiler.Stop("AWD");
+    m_Profiler.Stop(profiling::JSONProfiler::AWD);
 
     /*
      * Two-step metadata aggregation
      */
-    m_Profiler.Start("meta_lvl1");
+    m_Profiler.Start(profiling::JSONProfiler::MetaLvl1);
     std::vector<char> MetaBuffer;
     core::iovec m{TSInfo.MetaEncodeBuffer->Data(),
                   TSInfo.MetaEncodeBuffer->m_FixedSize};
@@ -574,7 +620,7 @@ void BP5Writer::EndStep()
 
     if (m_Aggregator->m_Comm.Size() > 1)
     { // level 1
-        m_Profiler.Start("meta_gather1");
+        m_Profiler.Start(profiling::JSONProfiler::MetaGather1);
         size_t LocalSize = MetaBuffer.size();
         std::vector<size_t> RecvCounts =
             m_Aggregator->m_Comm.GatherValues(LocalSize, 0);
@@ -592,7 +638,7 @@ void BP5Writer::EndStep()
         m_Aggregator->m_Comm.GathervArrays(MetaBuffer.data(), LocalSize,
                                            RecvCounts.data(), RecvCounts.size(),
                                            RecvBuffer.data(), 0);
-        m_Profiler.Stop("meta_gather1");
+        m_Profiler.Stop(profiling::JSONProfiler::MetaGather1);
         if (m_Aggregator->m_Comm.Rank() == 0)
         {
             std::vector<format::BP5Base::MetaMetaInfoBlock>
@@ -610,8 +656,8 @@ void BP5Writer::EndStep()
                 WriterDataPositions);
         }
     } // level 1
-    m_Profiler.Stop("meta_lvl1");
-    m_Profiler.Start("meta_lvl2");
+    m_Profiler.Stop(profiling::JSONProfiler::MetaLvl1);
+    m_Profiler.Start(profiling::JSONProfiler::MetaLvl2);
     // level 2
     if (m_Aggregator->m_Comm.Rank() == 0)
     {
@@ -621,7 +667,7 @@ void BP5Writer::EndStep()
         size_t LocalSize = MetaBuffer.size();
         if (m_CommAggregators.Size() > 1)
         {
-            m_Profiler.Start("meta_gather2");
+            m_Profiler.Start(profiling::JSONProfiler::MetaGather2);
             RecvCounts = m_CommAggregators.GatherValues(LocalSize, 0);
             if (m_CommAggregators.Rank() == 0)
             {
@@ -638,7 +684,7 @@ void BP5Writer::EndStep()
                 MetaBuffer.data(), LocalSize, RecvCounts.data(),
                 RecvCounts.size(), RecvBuffer.data(), 0);
             buf = &RecvBuffer;
-            m_Profiler.Stop("meta_gather2");
+            m_Profiler.Stop(profiling::JSONProfiler::MetaGather2);
         }
         else
         {
@@ -668,7 +714,16 @@ void BP5Writer::EndStep()
             }
         }
     } // level 2
-    m_Profiler.Stop("meta_lvl2");
+    m_Profiler.Stop(profiling::JSONProfiler::MetaLvl2);
+
+    if (m_DrainBB)
+    {
+        if (!m_Parameters.AsyncWrite)
+        {
+            MarkDrainIndexRecord();
+        }
+        DrainMetadataIndex(false);
+    }
 
     if (m_Parameters.AsyncWrite)
     {
@@ -683,7 +738,7 @@ void BP5Writer::EndStep()
         }
     }
 
-    m_Profiler.Stop("endstep");
+    m_Profiler.Stop(profiling::JSONProfiler::EndStep);
     m_WriterStep++;
     m_EndStepEnd = Now();
     /* Seconds ts2 = Now() - m_EngineStart;
@@ -704,7 +759,23 @@ void BP5Writer::Init()
 void BP5Writer::InitParameters()
 {
     ParseParams(m_IO, m_Parameters);
+    if (m_Parameters.ProfileTrace)
+    {
+        m_Profiler.EnableTrace();
+    }
     m_WriteToBB = !(m_Parameters.BurstBufferPath.empty());
+    if (m_WriteToBB && m_OpenMode == Mode::Append)
+    {
+        // the burst buffer would only hold the new steps, and draining them
+        // would overwrite the existing files on the target
+        helper::Log("Engine", "BP5Writer", "Open",
+                    "BurstBufferPath is ignored in Append mode, writing "
+                    "directly to " +
+                        m_Name,
+                    0, m_Comm.Rank(), 0, m_Parameters.verbose,
+                    helper::WARNING);
+        m_WriteToBB = false;
+    }
     m_DrainBB = m_WriteToBB && m_Parameters.BurstBufferDrain;
 
     unsigned int nproc = (unsigned int)m_Comm.Size();
@@ -762,6 +833,67 @@ void BP5Writer::InitParameters()
     }
 
     m_BP5Serializer.m_StatsLevel = m_Parameters.StatsLevel;
+    // Min/max of large blocks is split over threads
+    m_BP5Serializer.m_StatsThreads = m_Parameters.Threads;
+    if (m_BP5Serializer.m_StatsThreads == 0)
+    {
+        m_BP5Serializer.m_StatsThreads =
+            m_Parameters.StatsLevel > 0 ? GetDefaultThreads(m_Comm) : 1;
+    }
+    // Operators of deferred Puts and of sub-blocks run on the same number
+    // of threads
+    m_BP5Serializer.m_AsyncCompression = m_Parameters.AsyncCompression;
+    if (m_Parameters.AsyncCompression || m_Parameters.CompressionSubBlockSize)
+    {
+        m_BP5Serializer.m_CompressionThreads =
+            m_Parameters.Threads > 0 ? m_Parameters.Threads
+                                     : GetDefaultThreads(m_Comm);
+    }
+    // Sub-blocks are rows of the slowest dimension, which is only
+    // contiguous in row-major memory
+    if (m_IO.m_ArrayOrder == ArrayOrdering::RowMajor)
+    {
+        m_BP5Serializer.m_CompressionSubBlockSize =
+            m_Parameters.CompressionSubBlockSize;
+    }
+}
+
+void BP5Writer::InitTransportAlignment()
+{
+    // Only data writers open data files, but every rank fills buffers that
+    // end up in them, so agree on the largest preference
+    uint64_t preferred[2] = {0, 0};
+    if (m_IAmWritingData)
+    {
+        preferred[0] = m_FileDataManager.GetPreferredBlockSize();
+        preferred[1] = m_FileDataManager.GetPreferredStripeSize();
+    }
+    uint64_t agreed[2];
+    m_Comm.Allreduce(preferred, agreed, 2, helper::Comm::Op::Max);
+
+    const size_t blockSize = static_cast<size_t>(agreed[0]);
+    const size_t stripeSize = static_cast<size_t>(agreed[1]);
+
+    // Limiting to max 64MB page size, as for the StripeSize parameter
+    if (stripeSize > m_Parameters.StripeSize && stripeSize <= 67108864U)
+    {
+        m_Parameters.StripeSize = static_cast<unsigned int>(stripeSize);
+    }
+
+    if (blockSize <= m_BP5Serializer.m_BufferBlockSize)
+    {
+        return;
+    }
+
+    m_BP5Serializer.m_BufferBlockSize = blockSize;
+    if (m_BP5Serializer.m_BufferAlign < blockSize)
+    {
+        m_BP5Serializer.m_BufferAlign = blockSize;
+    }
+    m_Parameters.StripeSize += static_cast<unsigned int>(
+        helper::PaddingToAlignOffset(m_Parameters.StripeSize, blockSize));
+    m_Parameters.BufferChunkSize +=
+        helper::PaddingToAlignOffset(m_Parameters.BufferChunkSize, blockSize);
 }
 
 uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
@@ -1083,22 +1215,29 @@ void BP5Writer::InitTransports()
     m_SubStreamNames =
         GetBPSubStreamNames(transportsNames, m_Aggregator->m_SubStreamIndex);
 
-    if (m_IAmDraining)
+    if (m_DrainBB && m_IAmWritingData)
     {
-        // Only (master)aggregators will run draining processes
-        if (m_DrainBB)
-        {
-            const std::vector<std::string> drainTransportNames =
-                m_FileDataManager.GetFilesBaseNames(
-                    m_Name, m_IO.m_TransportsParameters);
-            m_DrainSubStreamNames = GetBPSubStreamNames(
-                drainTransportNames, m_Aggregator->m_SubStreamIndex);
-            /* start up BB thread */
-            //            m_FileDrainer.SetVerbose(
-            //				     m_Parameters.BurstBufferVerbose,
-            //				     m_Comm.Rank());
-            m_FileDrainer.Start();
-        }
+        // Everyone writing data drains its own part of the subfile, because
+        // the burst buffer may be node-local
+        const std::vector<std::string> drainTransportNames =
+            m_FileDataManager.GetFilesBaseNames(m_Name,
+                                                m_IO.m_TransportsParameters);
+        m_DrainSubStreamNames = GetBPSubStreamNames(
+            drainTransportNames, m_Aggregator->m_SubStreamIndex);
+    }
+
+    if (m_DrainBB && (m_IAmWritingData || m_Comm.Rank() == 0))
+    {
+        /* start up BB threads, rank 0 also drains the metadata files */
+        m_FileDrainer.SetVerbose(m_Parameters.BurstBufferVerbose,
+                                 m_Comm.Rank());
+        m_FileDrainer.SetStreams(m_Parameters.BurstBufferDrainThreads);
+        m_FileDrainer.SetBlockSize(m_Parameters.BurstBufferDrainBlockSize);
+        m_FileDrainer.SetDirectIO(m_Parameters.BurstBufferDrainDirectIO,
+                                  m_Parameters.DirectIOAlignOffset);
+        m_FileDrainer.SetMaxPendingBytes(
+            m_Parameters.BurstBufferDrainMaxPending);
+        m_FileDrainer.Start();
     }
 
     /* Create the directories either on target or burst buffer if used */
@@ -1120,6 +1259,18 @@ void BP5Writer::InitTransports()
         m_FileDataManager.MkDirsBarrier(m_DrainSubStreamNames,
                                         m_IO.m_TransportsParameters,
                                         m_Parameters.NodeLocal);
+        /* The first writer of each subfile creates the target, the
+         * collective InitTransportAlignment() below orders this before
+         * anyone drains into it */
+        if (m_IAmDraining && m_OpenMode == Mode::Write)
+        {
+            for (const auto &name : m_DrainSubStreamNames)
+            {
+                transport::FileFStream targetFile(m_Comm);
+                targetFile.Open(name, Mode::Write);
+                targetFile.Close();
+            }
+        }
     }
 
     /* Everyone opens its data file. Each aggregation chain opens
@@ -1140,6 +1291,14 @@ void BP5Writer::InitTransports()
         }
     }
 
+    if (m_Parameters.ProfileTrace)
+    {
+        for (size_t i = 0; i < m_IO.m_TransportsParameters.size(); ++i)
+        {
+            m_IO.m_TransportsParameters[i]["profiletrace"] = "true";
+        }
+    }
+
     bool useProfiler = true;
 
     if (m_IAmWritingData)
@@ -1149,14 +1308,14 @@ void BP5Writer::InitTransports()
                                     *DataWritingComm);
     }
 
-    if (m_IAmDraining)
+    InitTransportAlignment();
+
+    if (m_DrainBB && m_IAmWritingData)
     {
-        if (m_DrainBB)
+        // never truncate, the target is shared by all writers of the subfile
+        for (const auto &name : m_DrainSubStreamNames)
         {
-            for (const auto &name : m_DrainSubStreamNames)
-            {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
-            }
+            m_FileDrainer.AddOperationOpen(name, Mode::Append);
         }
     }
 
@@ -1167,17 +1326,21 @@ void BP5Writer::InitTransports()
         {
             m_IO.m_TransportsParameters[i]["DirectIO"] = "false";
         }
+        const std::vector<Params> metadataTransportsParameters =
+            GetBPMetadataTransportsParameters(m_IO.m_TransportsParameters);
+
         m_FileMetaMetadataManager.OpenFiles(m_MetaMetadataFileNames, m_OpenMode,
-                                            m_IO.m_TransportsParameters,
+                                            metadataTransportsParameters,
                                             useProfiler);
 
         m_FileMetadataManager.OpenFiles(m_MetadataFileNames, m_OpenMode,
-                                        m_IO.m_TransportsParameters,
+                                        metadataTransportsParameters,
                                         useProfiler);
 
-        m_FileMetadataIndexManager.OpenFiles(
-            m_MetadataIndexFileNames, m_OpenMode, m_IO.m_TransportsParameters,
-            useProfiler);
+        m_FileMetadataIndexManager.OpenFiles(m_MetadataIndexFileNames,
+                                             m_OpenMode,
+                                             metadataTransportsParameters,
+                                             useProfiler);
 
         if (m_DrainBB)
         {
@@ -1186,6 +1349,8 @@ void BP5Writer::InitTransports()
                     m_Name, m_IO.m_TransportsParameters);
             m_DrainMetadataFileNames =
                 GetBPMetadataFileNames(drainTransportNames);
+            m_DrainMetaMetadataFileNames =
+                GetBPMetaMetadataFileNames(drainTransportNames);
             m_DrainMetadataIndexFileNames =
                 GetBPMetadataIndexFileNames(drainTransportNames);
 
@@ -1193,6 +1358,10 @@ void BP5Writer::InitTransports()
             {
                 m_FileDrainer.AddOperationOpen(name, m_OpenMode);
             }
+            for (const auto &name : m_DrainMetaMetadataFileNames)
+            {
+                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+            }
             for (const auto &name : m_DrainMetadataIndexFileNames)
             {
                 m_FileDrainer.AddOperationOpen(name, m_OpenMode);
@@ -1348,6 +1517,68 @@ void BP5Writer::UpdateActiveFlag(const bool active)
     }
 }
 
+void BP5Writer::DrainData(const uint64_t startPos, const uint64_t size)
+{
+    if (!m_DrainBB || !size)
+    {
+        return;
+    }
+    m_FileDataManager.FlushFiles();
+    // data goes to the same offsets, so writers of a subfile drain
+    // concurrently and each only needs its own part of the local file
+    for (size_t i = 0; i < m_SubStreamNames.size(); ++i)
+    {
+        m_FileDrainer.AddOperationCopyAt(m_SubStreamNames[i],
+                                         m_DrainSubStreamNames[i], startPos,
+                                         startPos, size);
+    }
+}
+
+void BP5Writer::MarkDrainIndexRecord()
+{
+    if (m_IAmWritingData || m_Comm.Rank() == 0)
+    {
+        m_DrainIndexMarks.push_back(m_FileDrainer.GetAdded());
+    }
+    else
+    {
+        // nothing to drain on this process
+        ++m_DrainIndexDrained;
+    }
+}
+
+void BP5Writer::DrainMetadataIndex(const bool wait)
+{
+    if (m_IAmWritingData || m_Comm.Rank() == 0)
+    {
+        if (wait && !m_DrainIndexMarks.empty())
+        {
+            m_FileDrainer.WaitDrained(m_DrainIndexMarks.back());
+        }
+        const uint64_t done = m_FileDrainer.GetDrained();
+        while (!m_DrainIndexMarks.empty() && m_DrainIndexMarks.front() <= done)
+        {
+            m_DrainIndexMarks.pop_front();
+            ++m_DrainIndexDrained;
+        }
+    }
+    const size_t drained =
+        m_Comm.ReduceValues(m_DrainIndexDrained, helper::Comm::Op::Min, 0);
+
+    if (m_Comm.Rank() == 0)
+    {
+        for (; m_DrainIndexQueued < drained; ++m_DrainIndexQueued)
+        {
+            const std::vector<char> &buf = m_DrainIndexRecords.front();
+            for (const auto &name : m_DrainMetadataIndexFileNames)
+            {
+                m_FileDrainer.AddOperationWrite(name, buf.size(), buf.data());
+            }
+            m_DrainIndexRecords.pop_front();
+        }
+    }
+}
+
 void BP5Writer::InitBPBuffer()
 {
     if (m_OpenMode == Mode::Append)
@@ -1595,17 +1826,21 @@ void BP5Writer::DoClose(const int transportIndex)
     Seconds wait(0.0);
     if (m_WriteFuture.valid())
     {
-        m_Profiler.Start("WaitOnAsync");
+        m_Profiler.Start(profiling::JSONProfiler::WaitOnAsync);
         m_AsyncWriteLock.lock();
         m_flagRush = true;
         m_AsyncWriteLock.unlock();
         m_WriteFuture.get();
+        for (const auto &range : m_AsyncDrainRanges)
+        {
+            DrainData(range.first, range.second);
+        }
+        m_AsyncDrainRanges.clear();
         wait += Now() - wait_start;
-        m_Profiler.Stop("WaitOnAsync");
+        m_Profiler.Stop(profiling::JSONProfiler::WaitOnAsync);
     }
 
     m_FileDataManager.CloseFiles(transportIndex);
-    // Delete files from temporary storage if draining was on
 
     if (m_Comm.Rank() == 0)
     {
@@ -1619,7 +1854,7 @@ void BP5Writer::DoClose(const int transportIndex)
     if (m_Parameters.AsyncWrite)
     {
         // wait until all process' writing thread completes
-        m_Profiler.Start("WaitOnAsync");
+        m_Profiler.Start(profiling::JSONProfiler::WaitOnAsync);
         wait_start = Now();
         m_Comm.Barrier();
         AsyncWriteDataCleanup();
@@ -1629,21 +1864,69 @@ void BP5Writer::DoClose(const int transportIndex)
             std::cout << "Close waited " << wait.count()
                       << " seconds on async threads" << std::endl;
         }
-        m_Profiler.Stop("WaitOnAsync");
+        m_Profiler.Stop(profiling::JSONProfiler::WaitOnAsync);
     }
 
-    if (m_Comm.Rank() == 0)
+    if (m_Comm.Rank() == 0 && m_Parameters.AsyncWrite)
+    {
+        WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
+    }
+    if (m_DrainBB)
     {
         if (m_Parameters.AsyncWrite)
         {
-            WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
+            MarkDrainIndexRecord();
         }
+        // the target is complete once the drainers are done with the rest
+        DrainMetadataIndex(true);
+    }
+
+    if (m_Comm.Rank() == 0)
+    {
         // close metadata index file
         UpdateActiveFlag(false);
         m_FileMetadataIndexManager.CloseFiles();
     }
 
     FlushProfiler();
+
+    // Delete files from temporary storage once they are drained
+    if (m_DrainBB && (m_IAmWritingData || m_Comm.Rank() == 0))
+    {
+        if (m_IAmWritingData)
+        {
+            // writers on the same node share the local subfile, the drainers
+            // keep it open, so it can go away once everyone has queued all
+            // copies from it
+            DataWritingComm->Barrier();
+            for (const auto &name : m_SubStreamNames)
+            {
+                m_FileDrainer.AddOperationDelete(name);
+            }
+        }
+        if (m_Comm.Rank() == 0)
+        {
+            for (const auto *names :
+                 {&m_MetadataFileNames, &m_MetaMetadataFileNames,
+                  &m_MetadataIndexFileNames})
+            {
+                for (const auto &name : *names)
+                {
+                    m_FileDrainer.AddOperationDelete(name);
+                }
+            }
+        }
+        // the directory goes away with the last file in it on this node
+        const std::vector<std::string> transportsNames =
+            m_FileDataManager.GetFilesBaseNames(m_BBName,
+                                                m_IO.m_TransportsParameters);
+        for (const auto &name : transportsNames)
+        {
+            m_FileDrainer.AddOperationDelete(name);
+        }
+        /* Signal the BB threads that no more work is coming */
+        m_FileDrainer.Finish();
+    }
 }
 
 void BP5Writer::FlushProfiler()
@@ -1681,46 +1964,61 @@ void BP5Writer::FlushProfiler()
     const std::vector<char> profilingJSON(
         m_Profiler.AggregateProfilingJSON(lineJSON));
 
+    std::vector<char> traceJSON;
+    if (m_Parameters.ProfileTrace)
+    {
+        traceJSON = m_Profiler.AggregateTraceJSON(
+            m_Profiler.GetRankTraceJSON(transportTypes, transportProfilers));
+    }
+
     if (m_RankMPI == 0)
     {
-        // std::cout << "write profiling file!" << std::endl;
-        std::string profileFileName;
-        if (m_DrainBB)
-        {
-            // auto bpTargetNames =
-            // m_BP4Serializer.GetBPBaseNames({m_Name});
-            std::vector<std::string> bpTargetNames = {m_Name};
-            if (fileTransportIdx > -1)
+        auto lf_WriteProfile = [&](const std::string &suffix,
+                                   const std::vector<char> &json) {
+            // std::cout << "write profiling file!" << std::endl;
+            std::string profileFileName;
+            if (m_DrainBB)
             {
-                profileFileName =
-                    bpTargetNames[fileTransportIdx] + "/profiling.json";
+                // auto bpTargetNames =
+                // m_BP4Serializer.GetBPBaseNames({m_Name});
+                std::vector<std::string> bpTargetNames = {m_Name};
+                if (fileTransportIdx > -1)
+                {
+                    profileFileName =
+                        bpTargetNames[fileTransportIdx] + "/" + suffix;
+                }
+                else
+                {
+                    profileFileName = bpTargetNames[0] + "_" + suffix;
+                }
+                m_FileDrainer.AddOperationWrite(profileFileName, json.size(),
+                                                json.data());
             }
             else
             {
-                profileFileName = bpTargetNames[0] + "_profiling.json";
+                transport::FileFStream profilingJSONStream(m_Comm);
+                // auto bpBaseNames =
+                // m_BP4Serializer.GetBPBaseNames({m_BBName});
+                std::vector<std::string> bpBaseNames = {m_Name};
+                if (fileTransportIdx > -1)
+                {
+                    profileFileName =
+                        bpBaseNames[fileTransportIdx] + "/" + suffix;
+                }
+                else
+                {
+                    profileFileName = bpBaseNames[0] + "_" + suffix;
+                }
+                profilingJSONStream.Open(profileFileName, Mode::Write);
+                profilingJSONStream.Write(json.data(), json.size());
+                profilingJSONStream.Close();
             }
-            m_FileDrainer.AddOperationWrite(
-                profileFileName, profilingJSON.size(), profilingJSON.data());
-        }
-        else
+        };
+
+        lf_WriteProfile("profiling.json", profilingJSON);
+        if (m_Parameters.ProfileTrace)
         {
-            transport::FileFStream profilingJSONStream(m_Comm);
-            // auto bpBaseNames =
-            // m_BP4Serializer.GetBPBaseNames({m_BBName});
-            std::vector<std::string> bpBaseNames = {m_Name};
-            if (fileTransportIdx > -1)
-            {
-                profileFileName =
-                    bpBaseNames[fileTransportIdx] + "/profiling.json";
-            }
-            else
-            {
-                profileFileName = bpBaseNames[0] + "_profiling.json";
-            }
-            profilingJSONStream.Open(profileFileName, Mode::Write);
-            profilingJSONStream.Write(profilingJSON.data(),
-                                      profilingJSON.size());
-            profilingJSONStream.Close();
+            lf_WriteProfile("profiling_trace.json", traceJSON);
         }
     }
 }
@@ -1775,9 +2073,12 @@ void BP5Writer::PutCommon(VariableBase &variable, const void *values, bool sync)
     if (!sync)
     {
         /* If arrays is small, force copying to internal buffer to aggregate
-         * small writes */
+         * small writes. Blocks compressed in the background are copied
+         * anyway */
         size_t n = helper::GetTotalSize(variable.m_Count) * ObjSize;
-        if (n < m_Parameters.MinDeferredSize)
+        const bool asyncCompression = m_BP5Serializer.m_AsyncCompression &&
+                                      !variable.m_Operations.empty();
+        if (n < m_Parameters.MinDeferredSize && !asyncCompression)
         {
             sync = true;
         }
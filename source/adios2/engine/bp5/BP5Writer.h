@@ -17,13 +17,15 @@
 #include "adios2/helper/adiosMemory.h" // PaddingToAlignOffset
 #include "adios2/toolkit/aggregator/mpi/MPIChain.h"
 #include "adios2/toolkit/aggregator/mpi/MPIShmChain.h"
-#include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiStream.h"
 #include "adios2/toolkit/format/bp5/BP5Serializer.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 #include "adios2/toolkit/shm/Spinlock.h"
 #include "adios2/toolkit/shm/TokenChain.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 
+#include <deque>
+
 namespace adios2
 {
 namespace core
@@ -79,8 +81,20 @@ private:
     bool m_WriteToBB = false;
     /** true if burst buffer is drained to disk  */
     bool m_DrainBB = true;
-    /** File drainer thread if burst buffer is used */
-    burstbuffer::FileDrainerSingleThread m_FileDrainer;
+    /** File drainer threads if burst buffer is used */
+    burstbuffer::FileDrainerMultiStream m_FileDrainer;
+    /** Subfile ranges being written by the async thread, drained when it
+     * has completed */
+    std::vector<std::pair<uint64_t, uint64_t>> m_AsyncDrainRanges;
+    /** Drainer positions (GetAdded()) of the metadata index records not yet
+     * known to be drained on this process */
+    std::deque<uint64_t> m_DrainIndexMarks;
+    /** Records known to be drained on this process */
+    size_t m_DrainIndexDrained = 0;
+    /** Metadata index records waiting for all processes to drain what they
+     * point to, and records handed to the drainer (rank 0 only) */
+    std::deque<std::vector<char>> m_DrainIndexRecords;
+    size_t m_DrainIndexQueued = 0;
     /** m_Name modified with burst buffer path if BB is used,
      * == m_Name otherwise.
      * m_Name is a constant of Engine and is the user provided target path
@@ -95,6 +109,7 @@ private:
     std::vector<std::string> m_MetadataFileNames;
     std::vector<std::string> m_DrainMetadataFileNames;
     std::vector<std::string> m_MetaMetadataFileNames;
+    std::vector<std::string> m_DrainMetaMetadataFileNames;
     std::vector<std::string> m_MetadataIndexFileNames;
     std::vector<std::string> m_DrainMetadataIndexFileNames;
     std::vector<std::string> m_ActiveFlagFileNames;
@@ -109,6 +124,9 @@ private:
     void InitAggregator();
     /** Complete opening/createing metadata and data files */
     void InitTransports() final;
+    /** Aligns buffers and subfile offsets to what the data transports
+     * prefer, collective over m_Comm */
+    void InitTransportAlignment();
     /** Allocates memory and starts a PG group */
     void InitBPBuffer();
     void NotifyEngineAttribute(std::string name, DataType type) noexcept;
@@ -181,13 +199,27 @@ private:
 
     void UpdateActiveFlag(const bool active);
 
+    /** Hand a range of the subfile written by this process to the drainer.
+     * The burst buffer may be node-local, so everyone drains what it wrote */
+    void DrainData(const uint64_t startPos, const uint64_t size);
+
+    /** Mark the end of the drain operations the next metadata index record
+     * points to. Called by all processes wherever rank 0 makes a record */
+    void MarkDrainIndexRecord();
+
+    /** Collective. Rank 0 hands the metadata index records to its drainer
+     * once the data and metadata they point to have drained on all
+     * processes, so that the index on the target never refers to missing
+     * data. With wait, block until all marked operations have drained */
+    void DrainMetadataIndex(const bool wait);
+
     void WriteCollectiveMetadataFile(const bool isFinal = false);
 
     void MarshalAttributes();
 
     /* Two-level-shm aggregator functions */
     void WriteMyOwnData(format::BufferV *Data);
-    void SendDataToAggregator(format::BufferV *Data);
+    void SendDataToAggregator(format::BufferV *Data, size_t chunk);
     void WriteOthersData(const size_t TotalSize);
 
     template <class T>
@@ -199,6 +231,7 @@ private:
     aggregator::MPIAggregator *m_Aggregator; // points to one of these below
     aggregator::MPIShmChain m_AggregatorTwoLevelShm;
     aggregator::MPIChain m_AggregatorEveroneWrites;
+    /** first writer of the subfile, creates it on target if BB is drained */
     bool m_IAmDraining = false;
     bool m_IAmWritingData = false;
     helper::Comm *DataWritingComm; // processes that write the same data file
@@ -302,6 +335,7 @@ private:
         adios2::format::BufferV *Data;
         uint64_t startPos;
         uint64_t totalSize;
+        size_t firstChunk;        // first shm chunk of a TwoLevelShm producer
         double deadline;          // wall-clock time available in seconds
         bool *flagRush;           // flipped from false to true by main thread
         bool *inComputationBlock; // flipped back and forth by main thread
@@ -331,7 +365,7 @@ private:
     static int AsyncWriteThread_TwoLevelShm(AsyncWriteInfo *info);
     static void AsyncWriteThread_TwoLevelShm_Aggregator(AsyncWriteInfo *info);
     static void AsyncWriteThread_TwoLevelShm_SendDataToAggregator(
-        aggregator::MPIShmChain *a, format::BufferV *Data);
+        aggregator::MPIShmChain *a, format::BufferV *Data, size_t chunk);
 
     /* write own data used by both
        EveryoneWrites and TwoLevelShm  async threads  */
@@ -13,7 +13,6 @@
 #include "adios2/helper/adiosFunctions.h" //CheckIndexRange, PaddingToAlignOffset
 #include "adios2/toolkit/format/buffer/chunk/ChunkV.h"
 #include "adios2/toolkit/format/buffer/malloc/MallocV.h"
-#include "adios2/toolkit/shm/TokenChain.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #include <adios2-perfstubs-interface.h>
 
@@ -43,9 +42,9 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
     m_DataPos +=
         helper::PaddingToAlignOffset(m_DataPos, m_Parameters.StripeSize);
 
-    // Each aggregator needs to know the total size they write
-    // This calculation is valid on aggregators only
-    std::vector<uint64_t> mySizes = a->m_Comm.GatherValues(Data->Size());
+    // Each aggregator needs to know the total size they write, and each
+    // non-aggregator needs to know where its data goes in the shm ring
+    std::vector<uint64_t> mySizes = a->m_Comm.AllGatherValues(Data->Size());
     uint64_t myTotalSize = 0;
     uint64_t maxSize = 0;
     for (auto s : mySizes)
@@ -59,17 +58,12 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
 
     if (a->m_Comm.Size() > 1)
     {
-        size_t alignment_size = sizeof(max_align_t);
-        if (m_Parameters.DirectIO)
-        {
-            alignment_size = m_Parameters.DirectIOAlignOffset;
-        }
+        // DirectIOAlignOffset or the transport block size, if any
+        size_t alignment_size = m_BP5Serializer.m_BufferBlockSize;
         a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize,
-                     alignment_size);
+                     alignment_size, m_Parameters.NumShmBuffers);
     }
 
-    shm::TokenChain<uint64_t> tokenChain(&a->m_Comm);
-
     if (a->m_IsAggregator)
     {
         // In each aggregator chain, send from master down the line
@@ -106,10 +100,9 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
                   << " to subfile " << a->m_SubStreamIndex << " at pos "
                   << m_DataPos << " totalsize " << myTotalSize << std::endl;*/
 
-        // Send token to first non-aggregator to start filling shm
-        // Also informs next process its starting offset (for correct metadata)
-        uint64_t nextWriterPos = m_DataPos + Data->Size();
-        tokenChain.SendToken(nextWriterPos);
+        // Informs the non-aggregators about their starting offset
+        // (for correct metadata)
+        a->m_Comm.BroadcastValue(m_DataPos);
 
         WriteMyOwnData(Data);
 
@@ -118,6 +111,7 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
         {
             WriteOthersData(myTotalSize - Data->Size());
         }
+        DrainData(m_StartDataPos, m_DataPos - m_StartDataPos);
 
         // Master aggregator needs to know where the last writing ended by the
         // last aggregator in the chain, so that it can start from the correct
@@ -132,18 +126,19 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
     }
     else
     {
-        // non-aggregators fill shared buffer in marching order
-        // they also receive their starting offset this way
-        m_StartDataPos = tokenChain.RecvToken();
+        // non-aggregators fill the shared buffers concurrently, each one
+        // at its own place in the ring
+        m_StartDataPos = a->m_Comm.BroadcastValue<uint64_t>(0);
+        for (int r = 0; r < a->m_Comm.Rank(); ++r)
+        {
+            m_StartDataPos += mySizes[r];
+        }
 
         /*std::cout << "Rank " << m_Comm.Rank()
-                  << " non-aggregator recv token to fill shm = "
+                  << " non-aggregator starts filling shm at pos "
                   << m_StartDataPos << std::endl;*/
 
-        SendDataToAggregator(Data);
-
-        uint64_t nextWriterPos = m_StartDataPos + Data->Size();
-        tokenChain.SendToken(nextWriterPos);
+        SendDataToAggregator(Data, a->FirstProducerChunk(mySizes));
     }
 
     if (a->m_Comm.Size() > 1)
@@ -181,28 +176,29 @@ void BP5Writer::WriteMyOwnData(format::BufferV *Data)
     return out.str();
 }*/
 
-void BP5Writer::SendDataToAggregator(format::BufferV *Data)
+void BP5Writer::SendDataToAggregator(format::BufferV *Data, size_t chunk)
 {
-    /* Only one process is running this function at once
-       See shmFillerToken in the caller function
+    /* Other processes are running this function at the same time,
+       filling other chunks of the shared memory ring
 
-       In a loop, copy the local data into the shared memory, alternating
-       between the two segments.
+       In a loop, copy the local data into the shared memory, one chunk
+       after the other, starting from 'chunk'.
     */
 
     aggregator::MPIShmChain *a =
         dynamic_cast<aggregator::MPIShmChain *>(m_Aggregator);
 
     std::vector<core::iovec> DataVec = Data->DataVec();
-    size_t nBlocks = DataVec.size();
+    const uint64_t size = Data->Size();
 
-    // size_t sent = 0;
+    uint64_t sent = 0;
     size_t block = 0;
     size_t temp_offset = 0;
-    while (block < nBlocks)
+    while (sent < size)
     {
         // potentially blocking call waiting on Aggregator
-        aggregator::MPIShmChain::ShmDataBuffer *b = a->LockProducerBuffer();
+        aggregator::MPIShmChain::ShmDataBuffer *b =
+            a->LockProducerBuffer(chunk);
         // b->max_size: how much we can copy
         // b->actual_size: how much we actually copy
         b->actual_size = 0;
@@ -236,26 +232,22 @@ void BP5Writer::SendDataToAggregator(format::BufferV *Data)
             {
                 break;
             }
-            if (block >= nBlocks)
+            if (block >= DataVec.size())
             {
                 break;
             }
         }
-        // sent += b->actual_size;
+        sent += b->actual_size;
 
-        /*if (m_RankMPI >= 42)
-        {
-            std::cout << "Rank " << m_Comm.Rank()
-                      << " filled shm, data_size = " << b->actual_size
-                      << " block = " << block
-                      << " temp offset = " << temp_offset << " sent = " << sent
-                      << " buf = " << static_cast<void *>(b->buf) << " = "
-                      << DoubleBufferToString((double *)b->buf,
-                                              b->actual_size / sizeof(double))
-                      << std::endl;
-        }*/
-
-        a->UnlockProducerBuffer();
+        /*std::cout << "Rank " << m_Comm.Rank()
+                  << " filled shm chunk " << chunk
+                  << ", data_size = " << b->actual_size
+                  << " block = " << block
+                  << " temp offset = " << temp_offset << " sent = " << sent
+                  << std::endl;*/
+
+        a->UnlockProducerBuffer(chunk);
+        ++chunk;
     }
 }
 void BP5Writer::WriteOthersData(size_t TotalSize)
@@ -265,10 +257,12 @@ void BP5Writer::WriteOthersData(size_t TotalSize)
         dynamic_cast<aggregator::MPIShmChain *>(m_Aggregator);
 
     size_t wrote = 0;
+    size_t chunk = 0;
     while (wrote < TotalSize)
     {
         // potentially blocking call waiting on some non-aggr process
-        aggregator::MPIShmChain::ShmDataBuffer *b = a->LockConsumerBuffer();
+        aggregator::MPIShmChain::ShmDataBuffer *b =
+            a->LockConsumerBuffer(chunk);
 
         /*std::cout << "Rank " << m_Comm.Rank()
                   << " write from shm, data_size = " << b->actual_size
@@ -287,7 +281,8 @@ void BP5Writer::WriteOthersData(size_t TotalSize)
 
         wrote += b->actual_size;
 
-        a->UnlockConsumerBuffer();
+        a->UnlockConsumerBuffer(chunk);
+        ++chunk;
     }
     m_DataPos += TotalSize;
 }
@@ -52,42 +52,46 @@ void BP5Writer::AsyncWriteThread_TwoLevelShm_Aggregator(AsyncWriteInfo *info)
     /* Write from shm until every non-aggr sent all data */
     std::vector<core::iovec> DataVec(1);
     size_t wrote = 0;
+    size_t chunk = 0;
     while (wrote < totalSize)
     {
         /* Write the next shm block now */
         // potentially blocking call waiting on some non-aggr process
-        aggregator::MPIShmChain::ShmDataBuffer *b = a->LockConsumerBuffer();
+        aggregator::MPIShmChain::ShmDataBuffer *b =
+            a->LockConsumerBuffer(chunk);
         // b->actual_size: how much we need to write
         DataVec[0].iov_base = b->buf;
         DataVec[0].iov_len = b->actual_size;
         AsyncWriteOwnData(info, DataVec, b->actual_size, false);
         wrote += b->actual_size;
-        a->UnlockConsumerBuffer();
+        a->UnlockConsumerBuffer(chunk);
+        ++chunk;
     }
 }
 
 /* Non-aggregator part of the async two level aggregation.
    This process passes data to Aggregator through SHM segment.
-   tokenChain in caller ensures only one process (per aggregator chain)
-   is running this function at a time
+   Other non-aggregators are running this function at the same time, filling
+   other chunks of the shm ring.
 */
 void BP5Writer::AsyncWriteThread_TwoLevelShm_SendDataToAggregator(
-    aggregator::MPIShmChain *a, format::BufferV *Data)
+    aggregator::MPIShmChain *a, format::BufferV *Data, size_t chunk)
 {
-    /* In a loop, copy the local data into the shared memory, alternating
-       between the two segments.
+    /* In a loop, copy the local data into the shared memory, one chunk
+       after the other, starting from 'chunk'.
     */
 
     std::vector<core::iovec> DataVec = Data->DataVec();
-    size_t nBlocks = DataVec.size();
+    const uint64_t size = Data->Size();
 
-    // size_t sent = 0;
+    uint64_t sent = 0;
     size_t block = 0;
     size_t temp_offset = 0;
-    while (block < nBlocks)
+    while (sent < size)
     {
         // potentially blocking call waiting on Aggregator
-        aggregator::MPIShmChain::ShmDataBuffer *b = a->LockProducerBuffer();
+        aggregator::MPIShmChain::ShmDataBuffer *b =
+            a->LockProducerBuffer(chunk);
         // b->max_size: how much we can copy
         // b->actual_size: how much we actually copy
         b->actual_size = 0;
@@ -121,20 +125,21 @@ void BP5Writer::AsyncWriteThread_TwoLevelShm_SendDataToAggregator(
             {
                 break;
             }
-            if (block >= nBlocks)
+            if (block >= DataVec.size())
             {
                 break;
             }
         }
-        // sent += b->actual_size;
-        a->UnlockProducerBuffer();
+        sent += b->actual_size;
+        a->UnlockProducerBuffer(chunk);
+        ++chunk;
     }
 }
 
 int BP5Writer::AsyncWriteThread_TwoLevelShm(AsyncWriteInfo *info)
 {
     /* DO NOT use MPI in this separate thread, including destroying
-       shm segments explicitely (a->DestroyShm) or implicitely (tokenChain) */
+       shm segments explicitely (a->DestroyShm) */
     Seconds ts = Now() - info->tstart;
     // std::cout << "ASYNC rank " << info->rank_global
     //          << " starts at: " << ts.count() << std::endl;
@@ -142,22 +147,14 @@ int BP5Writer::AsyncWriteThread_TwoLevelShm(AsyncWriteInfo *info)
         dynamic_cast<aggregator::MPIShmChain *>(info->aggregator);
     if (a->m_IsAggregator)
     {
-        // Send token to first non-aggregator to start filling shm
-        // Also informs next process its starting offset (for correct
-        // metadata)
-        uint64_t nextWriterPos = info->startPos + info->Data->Size();
-        info->tokenChain->SendToken(nextWriterPos);
         AsyncWriteThread_TwoLevelShm_Aggregator(info);
-        info->tokenChain->RecvToken();
     }
     else
     {
-        // non-aggregators fill shared buffer in marching order
-        // they also receive their starting offset this way
-        uint64_t startPos = info->tokenChain->RecvToken();
-        AsyncWriteThread_TwoLevelShm_SendDataToAggregator(a, info->Data);
-        uint64_t nextWriterPos = startPos + info->Data->Size();
-        info->tokenChain->SendToken(nextWriterPos);
+        // non-aggregators fill the shared buffers concurrently, each one
+        // at its own place in the ring
+        AsyncWriteThread_TwoLevelShm_SendDataToAggregator(a, info->Data,
+                                                          info->firstChunk);
     }
     delete info->Data;
 
@@ -180,9 +177,9 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
     m_DataPos +=
         helper::PaddingToAlignOffset(m_DataPos, m_Parameters.StripeSize);
 
-    // Each aggregator needs to know the total size they write
-    // This calculation is valid on aggregators only
-    std::vector<uint64_t> mySizes = a->m_Comm.GatherValues(Data->Size());
+    // Each aggregator needs to know the total size they write, and each
+    // non-aggregator needs to know where its data goes in the shm ring
+    std::vector<uint64_t> mySizes = a->m_Comm.AllGatherValues(Data->Size());
     uint64_t myTotalSize = 0;
     uint64_t maxSize = 0;
     for (auto s : mySizes)
@@ -196,13 +193,10 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
 
     if (a->m_Comm.Size() > 1)
     {
-        size_t alignment_size = sizeof(max_align_t);
-        if (m_Parameters.DirectIO)
-        {
-            alignment_size = m_Parameters.DirectIOAlignOffset;
-        }
+        // DirectIOAlignOffset or the transport block size, if any
+        size_t alignment_size = m_BP5Serializer.m_BufferBlockSize;
         a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize,
-                     alignment_size);
+                     alignment_size, m_Parameters.NumShmBuffers);
     }
 
     if (a->m_IsAggregator)
@@ -265,7 +259,7 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
     m_AsyncWriteInfo->nproc_chain = a->m_Comm.Size();
     m_AsyncWriteInfo->comm_chain = helper::Comm(); // unused in this aggregation
     m_AsyncWriteInfo->tstart = m_EngineStart;
-    m_AsyncWriteInfo->tokenChain = new shm::TokenChain<uint64_t>(&a->m_Comm);
+    m_AsyncWriteInfo->tokenChain = nullptr; // unused in this aggregation
     m_AsyncWriteInfo->tm = &m_FileDataManager;
     m_AsyncWriteInfo->Data = Data;
     m_AsyncWriteInfo->flagRush = &m_flagRush;
@@ -275,18 +269,19 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
     // every process before we call the async writing thread
     if (a->m_IsAggregator)
     {
-        // Informs next process its starting offset (for correct metadata)
-        uint64_t nextWriterPos = m_StartDataPos + Data->Size();
-        m_AsyncWriteInfo->tokenChain->SendToken(nextWriterPos);
-        m_AsyncWriteInfo->tokenChain->RecvToken();
+        // Informs the non-aggregators about their starting offset
+        // (for correct metadata)
+        a->m_Comm.BroadcastValue(m_StartDataPos);
+        m_AsyncWriteInfo->firstChunk = 0;
     }
     else
     {
-        // non-aggregators fill shared buffer in marching order
-        // they also receive their starting offset this way
-        m_StartDataPos = m_AsyncWriteInfo->tokenChain->RecvToken();
-        uint64_t nextWriterPos = m_StartDataPos + Data->Size();
-        m_AsyncWriteInfo->tokenChain->SendToken(nextWriterPos);
+        m_StartDataPos = a->m_Comm.BroadcastValue<uint64_t>(0);
+        for (int r = 0; r < a->m_Comm.Rank(); ++r)
+        {
+            m_StartDataPos += mySizes[r];
+        }
+        m_AsyncWriteInfo->firstChunk = a->FirstProducerChunk(mySizes);
     }
 
     // Launch data writing thread, m_StartDataPos is valid
@@ -346,7 +341,6 @@ void BP5Writer::AsyncWriteDataCleanup_TwoLevelShm()
     {
         a->DestroyShm();
     }
-    delete m_AsyncWriteInfo->tokenChain;
     delete m_AsyncWriteInfo;
     m_AsyncWriteInfo = nullptr;
 }
@@ -10,12 +10,16 @@
 
 #include "adiosMath.h"
 #include "adiosLog.h"
+#include "adiosMemory.h" //StreamCopy
 
 #include <algorithm> //std::transform, std::reverse
 #include <cmath>
+#include <cstdint>
+#include <cstring>    //std::memcpy
 #include <functional> //std::minus<T>
 #include <iterator>   //std::back_inserter
 #include <numeric>    //std::accumulate
+#include <thread>
 #include <utility>    //std::pair
 
 #include "adios2/common/ADIOSMacros.h"
@@ -523,5 +527,253 @@ Box<Dims> GetSubBlock(const Dims &count, const BlockDivisionInfo &info,
     return std::make_pair(sbStart, sbCount);
 }
 
+namespace
+{
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADIOS2_MINMAX_DISPATCH
+#define ADIOS2_MINMAX_INLINE inline __attribute__((always_inline))
+#else
+#define ADIOS2_MINMAX_INLINE inline
+#endif
+
+/*
+ * Min/max over one 64 byte register worth of independent lanes, which the
+ * compiler maps onto the vector registers of the instruction set the caller
+ * is built for. The (a < b ? a : b) form matches what minps/minpd compute,
+ * so floating point types vectorize without -ffast-math. min and max come in
+ * as the running result, so blocks of one array can be fed in one by one
+ */
+template <class T>
+ADIOS2_MINMAX_INLINE void MinMaxLanes(const T *values, const size_t size,
+                                      T &min, T &max) noexcept
+{
+    constexpr size_t Lanes = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+    T mins[Lanes];
+    T maxs[Lanes];
+    for (size_t l = 0; l < Lanes; ++l)
+    {
+        mins[l] = min;
+        maxs[l] = max;
+    }
+
+    size_t i = 0;
+    for (; i + Lanes <= size; i += Lanes)
+    {
+        for (size_t l = 0; l < Lanes; ++l)
+        {
+            const T v = values[i + l];
+            mins[l] = v < mins[l] ? v : mins[l];
+            maxs[l] = maxs[l] < v ? v : maxs[l];
+        }
+    }
+
+    T vmin = mins[0];
+    T vmax = maxs[0];
+    for (size_t l = 1; l < Lanes; ++l)
+    {
+        vmin = mins[l] < vmin ? mins[l] : vmin;
+        vmax = vmax < maxs[l] ? maxs[l] : vmax;
+    }
+    for (; i < size; ++i)
+    {
+        vmin = values[i] < vmin ? values[i] : vmin;
+        vmax = vmax < values[i] ? values[i] : vmax;
+    }
+
+    min = vmin;
+    max = vmax;
+}
+
+#ifdef ADIOS2_MINMAX_DISPATCH
+template <class T>
+__attribute__((target("avx512f,avx512bw"))) void
+MinMaxAVX512(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxLanes(values, size, min, max);
+}
+
+template <class T>
+__attribute__((target("avx2"))) void
+MinMaxAVX2(const T *values, const size_t size, T &min, T &max) noexcept
+{
+    MinMaxLanes(values, size, min, max);
+}
+
+enum class MinMaxISA
+{
+    Baseline,
+    AVX2,
+    AVX512
+};
+
+MinMaxISA DetectMinMaxISA() noexcept
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return MinMaxISA::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return MinMaxISA::AVX2;
+    }
+    return MinMaxISA::Baseline;
+}
+#endif
+
+template <class T>
+void MinMaxDispatch(const T *values, const size_t size, T &min,
+                    T &max) noexcept
+{
+#ifdef ADIOS2_MINMAX_DISPATCH
+    static const MinMaxISA isa = DetectMinMaxISA();
+    switch (isa)
+    {
+    case MinMaxISA::AVX512:
+        MinMaxAVX512(values, size, min, max);
+        return;
+    case MinMaxISA::AVX2:
+        MinMaxAVX2(values, size, min, max);
+        return;
+    default:
+        break;
+    }
+#endif
+    MinMaxLanes(values, size, min, max);
+}
+
+/* copies of at least this many bytes use non-temporal stores */
+constexpr size_t StreamingCopySize = 1024 * 1024;
+/* CopyMinMax works in blocks that stay in L1 from min/max to copy */
+constexpr size_t CopyMinMaxBlockSize = 16 * 1024;
+
+/* Copies values to dest and folds them into min and max, which come in
+ * seeded like for MinMaxDispatch */
+template <class T>
+void CopyMinMaxBlocks(const T *values, const size_t size, char *dest, T &min,
+                      T &max) noexcept
+{
+    const bool streaming = size * sizeof(T) >= StreamingCopySize;
+    const size_t blockSize =
+        std::max<size_t>(CopyMinMaxBlockSize / sizeof(T), 1);
+    for (size_t i = 0; i < size; i += blockSize)
+    {
+        const size_t n = std::min(blockSize, size - i);
+        MinMaxDispatch(values + i, n, min, max);
+        if (streaming)
+        {
+            StreamCopy(dest + i * sizeof(T),
+                       reinterpret_cast<const char *>(values + i),
+                       n * sizeof(T));
+        }
+        else
+        {
+            std::memcpy(dest + i * sizeof(T), values + i, n * sizeof(T));
+        }
+    }
+    if (streaming)
+    {
+        // make the non-temporal stores visible before the buffer is handed on
+        StreamCopyFence();
+    }
+}
+
+template <class T>
+void CopyMinMaxThreads(const T *values, const size_t size, char *dest, T &min,
+                       T &max, const unsigned int threads) noexcept
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    min = values[0];
+    max = values[0];
+    if (threads <= 1 || size < 1000000)
+    {
+        CopyMinMaxBlocks(values, size, dest, min, max);
+        return;
+    }
+
+    const size_t stride = size / threads;
+    std::vector<T> mins(threads);
+    std::vector<T> maxs(threads);
+    // not vector<bool>, each thread sets its own entry
+    std::vector<char> hasValue(threads, 0);
+    auto lf_CopyChunk = [&](const unsigned int t) {
+        const size_t position = stride * t;
+        const size_t count = (t == threads - 1) ? size - position : stride;
+        const T *chunk = values + position;
+        // The single sweep only keeps a NaN that is values[0], so the other
+        // chunks are seeded from their first non-NaN value
+        size_t seed = 0;
+        if (t > 0)
+        {
+            while (seed < count && chunk[seed] != chunk[seed])
+            {
+                ++seed;
+            }
+        }
+        if (seed < count)
+        {
+            hasValue[t] = 1;
+            mins[t] = chunk[seed];
+            maxs[t] = chunk[seed];
+        }
+        CopyMinMaxBlocks(chunk, count, dest + position * sizeof(T), mins[t],
+                         maxs[t]);
+    };
+
+    std::vector<std::thread> copyThreads;
+    copyThreads.reserve(threads - 1);
+    for (unsigned int t = 1; t < threads; ++t)
+    {
+        copyThreads.emplace_back(lf_CopyChunk, t);
+    }
+    lf_CopyChunk(0);
+    for (auto &copyThread : copyThreads)
+    {
+        copyThread.join();
+    }
+
+    // chunk 0 starts from values[0] like the single sweep, chunks of only
+    // NaN are skipped, so the result matches a single CopyMinMaxBlocks
+    min = mins[0];
+    max = maxs[0];
+    for (unsigned int t = 1; t < threads; ++t)
+    {
+        if (hasValue[t])
+        {
+            min = mins[t] < min ? mins[t] : min;
+            max = max < maxs[t] ? maxs[t] : max;
+        }
+    }
+}
+
+} // end anonymous namespace
+
+#define declare_type(T, N)                                                     \
+    void GetMinMaxVectorized(const T *values, const size_t size, T &min,       \
+                             T &max) noexcept                                  \
+    {                                                                          \
+        if (size == 0)                                                         \
+        {                                                                      \
+            return;                                                            \
+        }                                                                      \
+        min = values[0];                                                       \
+        max = values[0];                                                       \
+        MinMaxDispatch(values, size, min, max);                                \
+    }                                                                          \
+                                                                               \
+    void CopyMinMax(const T *values, const size_t size, void *dest, T &min,    \
+                    T &max, const unsigned int threads) noexcept               \
+    {                                                                          \
+        CopyMinMaxThreads(values, size, static_cast<char *>(dest), min, max,   \
+                          threads);                                            \
+    }
+ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+
 } // end namespace helper
 } // end namespace adios2
@@ -15,6 +15,7 @@
 #include <vector>
 /// \endcond
 
+#include "adios2/common/ADIOSMacros.h"
 #include "adios2/common/ADIOSTypes.h"
 
 #include <iostream>
@@ -59,6 +60,44 @@ template <class T>
 void GetMinMax(const T *values, const size_t size, T &min, T &max,
                const MemorySpace memSpace) noexcept;
 
+/**
+ * Gets the min and max from a host array with vector instructions, using the
+ * widest instruction set the CPU supports (AVX-512, AVX2 or the build's
+ * baseline) picked at runtime. NaN values are skipped unless they come first.
+ * Types without a vectorized kernel fall back to std::minmax_element
+ * @param values input array
+ * @param size of values array, must be > 0
+ * @param min of values
+ * @param max of values
+ */
+template <class T>
+void GetMinMaxVectorized(const T *values, const size_t size, T &min,
+                         T &max) noexcept;
+
+#define declare_type(T, N)                                                     \
+    void GetMinMaxVectorized(const T *values, const size_t size, T &min,       \
+                             T &max) noexcept;
+ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+
+/**
+ * Copies a host array into dest and gets its min and max in the same sweep,
+ * so values are read from memory only once. Large arrays are copied with
+ * non-temporal stores that bypass the cache. Min and max follow
+ * GetMinMaxVectorized
+ * @param values input array
+ * @param size of values array
+ * @param dest output buffer of size * sizeof(T) bytes, any alignment
+ * @param min of values, untouched if size == 0
+ * @param max of values, untouched if size == 0
+ * @param threads used for large arrays
+ */
+#define declare_type(T, N)                                                     \
+    void CopyMinMax(const T *values, const size_t size, void *dest, T &min,    \
+                    T &max, const unsigned int threads = 1) noexcept;
+ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+
 #ifdef ADIOS2_HAVE_GPU_SUPPORT
 template <class T>
 void GetGPUMinMax(const T *values, const size_t size, T &min, T &max) noexcept;
@@ -196,6 +196,13 @@ inline void GetMinMax(const T *values, const size_t size, T &min, T &max,
         return;
     }
 #endif
+    GetMinMaxVectorized(values, size, min, max);
+}
+
+template <class T>
+void GetMinMaxVectorized(const T *values, const size_t size, T &min,
+                         T &max) noexcept
+{
     auto bounds = std::minmax_element(values, values + size);
     min = *bounds.first;
     max = *bounds.second;
@@ -11,7 +11,14 @@
 #include "adiosMemory.h"
 
 #include <algorithm>
+#include <cstdint>  //uintptr_t
+#include <cstring>  //std::memcpy
 #include <stddef.h> // max_align_t
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "adios2/helper/adiosType.h"
 
@@ -245,6 +252,324 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
     }
 }
 
+/*
+ * Copies between buffers whose fastest dimensions differ (row-major <->
+ * column-major) read or write one of the buffers with a large stride. They
+ * are done in square tiles in the plane of the two fastest dimensions, small
+ * enough that the lines of a tile stay in L1 on both sides. Tiles of 4 and 8
+ * byte elements are transposed in SSE registers. Endian reversal happens in
+ * the same pass. The remaining dimensions and the strips of tiles are split
+ * across threads for large copies.
+ */
+constexpr size_t NdCopyTileBytes = 256;
+constexpr size_t NdCopyMaxTile = 64;
+/* copies of less than this many bytes per thread are not worth a thread */
+constexpr size_t NdCopyThreadBytes = 4 * 1024 * 1024;
+/* runs of at least this many bytes bypass the cache when copied by plan */
+constexpr size_t NdCopyStreamRunBytes = 1024 * 1024;
+
+struct NdCopyPlane
+{
+    size_t rows;  // elements along the fastest dimension of the input
+    size_t cols;  // elements along the fastest dimension of the output
+    size_t inRow; // input stride along rows, elmSize if contiguous
+    size_t inCol;
+    size_t outRow;
+    size_t outCol; // output stride along cols, elmSize if contiguous
+    size_t tile;
+    bool transpose; // false: both are fastest along rows, cols is 1
+};
+
+template <size_t N, bool Reverse>
+inline void NdCopyElement(char *out, const char *in, const size_t elmSize)
+{
+    const size_t n = N ? N : elmSize;
+    if (Reverse)
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            out[k] = in[n - 1 - k];
+        }
+    }
+    else
+    {
+        std::memcpy(out, in, n);
+    }
+}
+
+/* 4x4 (4 byte) or 2x2 (8 byte) blocks of a tile, rows and cols multiples */
+template <size_t N>
+inline void NdCopyTransposeSSE(const char *in, char *out, const size_t rows,
+                               const size_t cols, const NdCopyPlane &plane)
+{
+#ifdef __SSE2__
+    if (N == 4)
+    {
+        for (size_t i = 0; i < rows; i += 4)
+        {
+            for (size_t j = 0; j < cols; j += 4)
+            {
+                const char *src = in + i * 4 + j * plane.inCol;
+                __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float *>(src));
+                __m128 r1 = _mm_loadu_ps(
+                    reinterpret_cast<const float *>(src + plane.inCol));
+                __m128 r2 = _mm_loadu_ps(
+                    reinterpret_cast<const float *>(src + 2 * plane.inCol));
+                __m128 r3 = _mm_loadu_ps(
+                    reinterpret_cast<const float *>(src + 3 * plane.inCol));
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                char *dst = out + i * plane.outRow + j * 4;
+                _mm_storeu_ps(reinterpret_cast<float *>(dst), r0);
+                _mm_storeu_ps(reinterpret_cast<float *>(dst + plane.outRow),
+                              r1);
+                _mm_storeu_ps(
+                    reinterpret_cast<float *>(dst + 2 * plane.outRow), r2);
+                _mm_storeu_ps(
+                    reinterpret_cast<float *>(dst + 3 * plane.outRow), r3);
+            }
+        }
+    }
+    else if (N == 8)
+    {
+        for (size_t i = 0; i < rows; i += 2)
+        {
+            for (size_t j = 0; j < cols; j += 2)
+            {
+                const char *src = in + i * 8 + j * plane.inCol;
+                const __m128d r0 =
+                    _mm_loadu_pd(reinterpret_cast<const double *>(src));
+                const __m128d r1 = _mm_loadu_pd(
+                    reinterpret_cast<const double *>(src + plane.inCol));
+                char *dst = out + i * plane.outRow + j * 8;
+                _mm_storeu_pd(reinterpret_cast<double *>(dst),
+                              _mm_unpacklo_pd(r0, r1));
+                _mm_storeu_pd(reinterpret_cast<double *>(dst + plane.outRow),
+                              _mm_unpackhi_pd(r0, r1));
+            }
+        }
+    }
+#else
+    (void)in;
+    (void)out;
+    (void)rows;
+    (void)cols;
+    (void)plane;
+#endif
+}
+
+/* rows [rowBegin, rowEnd) of one plane, tile by tile */
+template <size_t N, bool Reverse>
+void NdCopyPlaneRows(const char *in, char *out, const NdCopyPlane &plane,
+                     const size_t rowBegin, const size_t rowEnd,
+                     const size_t elmSize)
+{
+    if (!plane.transpose)
+    {
+        if (!Reverse && plane.inRow == elmSize && plane.outRow == elmSize)
+        {
+            std::memcpy(out + rowBegin * elmSize, in + rowBegin * elmSize,
+                        (rowEnd - rowBegin) * elmSize);
+            return;
+        }
+        for (size_t i = rowBegin; i < rowEnd; ++i)
+        {
+            NdCopyElement<N, Reverse>(out + i * plane.outRow,
+                                      in + i * plane.inRow, elmSize);
+        }
+        return;
+    }
+
+#ifdef __SSE2__
+    const size_t simd = (N == 4) ? 4 : (N == 8 ? 2 : 0);
+    const bool useSIMD = simd && !Reverse && plane.inRow == N &&
+                         plane.outCol == N;
+#else
+    const size_t simd = 0;
+    const bool useSIMD = false;
+#endif
+
+    for (size_t i0 = rowBegin; i0 < rowEnd; i0 += plane.tile)
+    {
+        const size_t i1 = std::min(i0 + plane.tile, rowEnd);
+        for (size_t j0 = 0; j0 < plane.cols; j0 += plane.tile)
+        {
+            const size_t j1 = std::min(j0 + plane.tile, plane.cols);
+            const char *tileIn = in + i0 * plane.inRow + j0 * plane.inCol;
+            char *tileOut = out + i0 * plane.outRow + j0 * plane.outCol;
+            size_t iSIMD = 0;
+            size_t jSIMD = 0;
+            if (useSIMD)
+            {
+                iSIMD = (i1 - i0) / simd * simd;
+                jSIMD = (j1 - j0) / simd * simd;
+                NdCopyTransposeSSE<N>(tileIn, tileOut, iSIMD, jSIMD, plane);
+            }
+            // writes along the output lines, the input lines stay in cache
+            for (size_t i = 0; i < i1 - i0; ++i)
+            {
+                const size_t jBegin = i < iSIMD ? jSIMD : 0;
+                for (size_t j = jBegin; j < j1 - j0; ++j)
+                {
+                    NdCopyElement<N, Reverse>(
+                        tileOut + i * plane.outRow + j * plane.outCol,
+                        tileIn + i * plane.inRow + j * plane.inCol, elmSize);
+                }
+            }
+        }
+    }
+}
+
+template <size_t N, bool Reverse>
+void NdCopyTiledImpl(const char *in, char *out, const NdCopyPlane &plane,
+                     const std::vector<size_t> &outerCount,
+                     const std::vector<size_t> &outerInStride,
+                     const std::vector<size_t> &outerOutStride,
+                     const size_t elmSize,
+                     const unsigned int threads)
+{
+    const size_t strips = plane.transpose
+                              ? (plane.rows + plane.tile - 1) / plane.tile
+                              : 1;
+    const size_t stripRows = plane.transpose ? plane.tile : plane.rows;
+    size_t outer = 1;
+    for (size_t d = 0; d < outerCount.size(); ++d)
+    {
+        outer *= outerCount[d];
+    }
+    const size_t items = outer * strips;
+
+    auto lf_Copy = [&](const size_t itemBegin, const size_t itemEnd) {
+        for (size_t item = itemBegin; item < itemEnd; ++item)
+        {
+            size_t o = item / strips;
+            const size_t strip = item % strips;
+            const char *planeIn = in;
+            char *planeOut = out;
+            for (size_t d = outerCount.size(); d > 0; --d)
+            {
+                const size_t pos = o % outerCount[d - 1];
+                o /= outerCount[d - 1];
+                planeIn += pos * outerInStride[d - 1];
+                planeOut += pos * outerOutStride[d - 1];
+            }
+            NdCopyPlaneRows<N, Reverse>(
+                planeIn, planeOut, plane, strip * stripRows,
+                std::min((strip + 1) * stripRows, plane.rows), elmSize);
+        }
+    };
+
+    const size_t bytes = outer * plane.rows * plane.cols * elmSize;
+    size_t nThreads = std::min<size_t>(threads, items);
+    nThreads = std::min(nThreads, bytes / NdCopyThreadBytes);
+    if (nThreads <= 1)
+    {
+        lf_Copy(0, items);
+        return;
+    }
+
+    std::vector<std::thread> copyThreads;
+    copyThreads.reserve(nThreads - 1);
+    const size_t stride = items / nThreads;
+    for (size_t t = 1; t < nThreads; ++t)
+    {
+        const size_t end = (t == nThreads - 1) ? items : stride * (t + 1);
+        copyThreads.emplace_back(lf_Copy, stride * t, end);
+    }
+    lf_Copy(0, stride);
+    for (auto &copyThread : copyThreads)
+    {
+        copyThread.join();
+    }
+}
+
+/*
+ * Every element p of ovlpCount goes from
+ * inBase + sum((inRltvOvlpSPos[d] + p[d]) * inStride[d]) to the matching
+ * position in outBase
+ */
+void NdCopyTiled(const char *inBase, char *outBase,
+                 const CoreDims &inRltvOvlpSPos,
+                 const CoreDims &outRltvOvlpSPos, const CoreDims &inStride,
+                 const CoreDims &outStride, const CoreDims &ovlpCount,
+                 const size_t elmSize, const bool reverseEndian,
+                 const unsigned int threads)
+{
+    const size_t ndim = ovlpCount.size();
+    size_t rowDim = ndim;
+    size_t colDim = ndim;
+    for (size_t d = 0; d < ndim; ++d)
+    {
+        inBase += inRltvOvlpSPos[d] * inStride[d];
+        outBase += outRltvOvlpSPos[d] * outStride[d];
+        if (ovlpCount[d] < 2)
+        {
+            continue;
+        }
+        if (rowDim == ndim || inStride[d] < inStride[rowDim])
+        {
+            rowDim = d;
+        }
+        if (colDim == ndim || outStride[d] < outStride[colDim])
+        {
+            colDim = d;
+        }
+    }
+
+    NdCopyPlane plane;
+    plane.rows = rowDim < ndim ? ovlpCount[rowDim] : 1;
+    plane.inRow = rowDim < ndim ? inStride[rowDim] : elmSize;
+    plane.outRow = rowDim < ndim ? outStride[rowDim] : elmSize;
+    plane.transpose = colDim != rowDim;
+    plane.cols = plane.transpose ? ovlpCount[colDim] : 1;
+    plane.inCol = plane.transpose ? inStride[colDim] : 0;
+    plane.outCol = plane.transpose ? outStride[colDim] : 0;
+    plane.tile = std::max<size_t>(
+        1, std::min(NdCopyMaxTile, NdCopyTileBytes / elmSize));
+
+    std::vector<size_t> outerCount;
+    std::vector<size_t> outerInStride;
+    std::vector<size_t> outerOutStride;
+    for (size_t d = 0; d < ndim; ++d)
+    {
+        if (d != rowDim && d != colDim && ovlpCount[d] > 1)
+        {
+            outerCount.push_back(ovlpCount[d]);
+            outerInStride.push_back(inStride[d]);
+            outerOutStride.push_back(outStride[d]);
+        }
+    }
+
+#define NDCOPY_TILED(N)                                                        \
+    if (reverseEndian)                                                         \
+        NdCopyTiledImpl<N, true>(inBase, outBase, plane, outerCount,           \
+                                 outerInStride, outerOutStride, elmSize,       \
+                                 threads);                                     \
+    else                                                                       \
+        NdCopyTiledImpl<N, false>(inBase, outBase, plane, outerCount,          \
+                                  outerInStride, outerOutStride, elmSize,      \
+                                  threads);
+
+    switch (elmSize)
+    {
+    case 1:
+        NDCOPY_TILED(1)
+        break;
+    case 2:
+        NDCOPY_TILED(2)
+        break;
+    case 4:
+        NDCOPY_TILED(4)
+        break;
+    case 8:
+        NDCOPY_TILED(8)
+        break;
+    default:
+        NDCOPY_TILED(0)
+        break;
+    }
+#undef NDCOPY_TILED
+}
+
 } // end empty namespace
 
 int NdCopy(const char *in, const CoreDims &inStart, const CoreDims &inCount,
@@ -254,7 +579,7 @@ int NdCopy(const char *in, const CoreDims &inStart, const CoreDims &inCount,
            const int typeSize, const CoreDims &inMemStart,
            const CoreDims &inMemCount, const CoreDims &outMemStart,
            const CoreDims &outMemCount, const bool safeMode,
-           MemorySpace MemSpace)
+           MemorySpace MemSpace, const unsigned int threads)
 
 {
 
@@ -612,47 +937,184 @@ int NdCopy(const char *in, const CoreDims &inStart, const CoreDims &inCount,
             GetRltvOvlpStartPos(outRltvOvlpStartPos, outMemStartNC, ovlpStart);
         }
 
-        inOvlpBase = in;
-        outOvlpBase = out;
-        // Same Endian"
-        if (inIsLittleEndian == outIsLittleEndian)
+        // iterative, safe for any number of dimensions
+        NdCopyTiled(in, out, inRltvOvlpStartPos, outRltvOvlpStartPos,
+                    inStride, outStride, ovlpCount, typeSize,
+                    inIsLittleEndian != outIsLittleEndian, threads);
+    }
+    return 0;
+}
+
+NdCopyPlan NdCopyMakePlan(const CoreDims &inStart, const CoreDims &inCount,
+                          const CoreDims &outStart, const CoreDims &outCount,
+                          const size_t typeSize)
+{
+    NdCopyPlan plan;
+    const size_t ndim = inCount.size();
+    if (ndim == 0)
+    {
+        plan.RunSize = typeSize;
+        plan.NumRuns = 1;
+        return plan;
+    }
+
+    DimsArray ovlpCount(ndim);
+    DimsArray inStride(ndim);
+    DimsArray outStride(ndim);
+    size_t inSize = typeSize;
+    size_t outSize = typeSize;
+    for (size_t d = ndim; d > 0; --d)
+    {
+        const size_t i = d - 1;
+        const size_t start = std::max(inStart[i], outStart[i]);
+        const size_t end =
+            std::min(inStart[i] + inCount[i], outStart[i] + outCount[i]);
+        if (end <= start)
         {
-            if (!safeMode)
-            {
-                NdCopyRecurDFNonSeqDynamic(0, inOvlpBase, outOvlpBase,
-                                           inRltvOvlpStartPos,
-                                           outRltvOvlpStartPos, inStride,
-                                           outStride, ovlpCount, typeSize);
-            }
-            else
-            {
-                NdCopyIterDFDynamic(inOvlpBase, outOvlpBase, inRltvOvlpStartPos,
-                                    outRltvOvlpStartPos, inStride, outStride,
-                                    ovlpCount, typeSize);
-            }
+            return plan; // no overlap
         }
-        // different Endian"
-        else
+        ovlpCount[i] = end - start;
+        inStride[i] = inSize;
+        outStride[i] = outSize;
+        plan.InOffset += (start - inStart[i]) * inSize;
+        plan.OutOffset += (start - outStart[i]) * outSize;
+        inSize *= inCount[i];
+        outSize *= outCount[i];
+    }
+
+    // the runs span all dimensions from contDim on, see NdCopy
+    size_t contDim = ndim - 1;
+    while (contDim > 0 && inCount[contDim] == ovlpCount[contDim] &&
+           outCount[contDim] == ovlpCount[contDim])
+    {
+        --contDim;
+    }
+    plan.RunSize = ovlpCount[contDim] * inStride[contDim];
+    plan.NumRuns = 1;
+    for (size_t d = 0; d < contDim; ++d)
+    {
+        plan.NumRuns *= ovlpCount[d];
+    }
+    plan.Count.assign(ovlpCount.begin(), ovlpCount.begin() + contDim);
+    plan.InStride.assign(inStride.begin(), inStride.begin() + contDim);
+    plan.OutStride.assign(outStride.begin(), outStride.begin() + contDim);
+    return plan;
+}
+
+void NdCopyExecutePlan(const NdCopyPlan &plan, const char *in, char *out,
+                       const unsigned int threads) noexcept
+{
+    const size_t runSize = plan.RunSize;
+    const size_t bytes = runSize * plan.NumRuns;
+    if (bytes == 0)
+    {
+        return;
+    }
+    const bool streaming = runSize >= NdCopyStreamRunBytes;
+    const size_t ndim = plan.Count.size();
+
+    // copies bytes [begin, end) of the runs laid end to end
+    auto lf_Copy = [&](const size_t begin, const size_t end) {
+        // position and offsets of the first run touched
+        DimsArray pos(ndim);
+        size_t inOffset = plan.InOffset;
+        size_t outOffset = plan.OutOffset;
+        size_t r = begin / runSize;
+        for (size_t d = ndim; d > 0; --d)
         {
-            if (!safeMode)
+            const size_t i = d - 1;
+            pos[i] = r % plan.Count[i];
+            r /= plan.Count[i];
+            inOffset += pos[i] * plan.InStride[i];
+            outOffset += pos[i] * plan.OutStride[i];
+        }
+
+        size_t offset = begin % runSize;
+        for (size_t left = end - begin; left > 0;)
+        {
+            const size_t n = std::min(runSize - offset, left);
+            const char *src = in + inOffset + offset;
+            char *dest = out + outOffset + offset;
+            if (streaming)
             {
-                NdCopyRecurDFNonSeqDynamicRevEndian(
-                    0, inOvlpBase, outOvlpBase, inRltvOvlpStartPos,
-                    outRltvOvlpStartPos, inStride, outStride, ovlpCount,
-                    typeSize);
+                StreamCopy(dest, src, n);
             }
             else
             {
-                NdCopyIterDFDynamicRevEndian(inOvlpBase, outOvlpBase,
-                                             inRltvOvlpStartPos,
-                                             outRltvOvlpStartPos, inStride,
-                                             outStride, ovlpCount, typeSize);
+                std::memcpy(dest, src, n);
+            }
+            left -= n;
+            offset = 0;
+            // next run
+            for (size_t d = ndim; d > 0; --d)
+            {
+                const size_t i = d - 1;
+                inOffset += plan.InStride[i];
+                outOffset += plan.OutStride[i];
+                if (++pos[i] < plan.Count[i])
+                {
+                    break;
+                }
+                pos[i] = 0;
+                inOffset -= plan.Count[i] * plan.InStride[i];
+                outOffset -= plan.Count[i] * plan.OutStride[i];
             }
         }
+        if (streaming)
+        {
+            StreamCopyFence();
+        }
+    };
+
+    const size_t nThreads =
+        std::min(static_cast<size_t>(threads), bytes / NdCopyThreadBytes);
+    if (nThreads <= 1)
+    {
+        lf_Copy(0, bytes);
+        return;
     }
-    return 0;
+
+    std::vector<std::thread> copyThreads;
+    copyThreads.reserve(nThreads - 1);
+    const size_t stride = bytes / nThreads;
+    for (size_t t = 1; t < nThreads; ++t)
+    {
+        const size_t end = (t == nThreads - 1) ? bytes : stride * (t + 1);
+        copyThreads.emplace_back(lf_Copy, stride * t, end);
+    }
+    lf_Copy(0, stride);
+    for (auto &copyThread : copyThreads)
+    {
+        copyThread.join();
+    }
+}
+//*************** End of NdCopy() and its helpers ***************
+
+void StreamCopy(char *dest, const char *src, const size_t size) noexcept
+{
+#ifdef __SSE2__
+    const size_t head =
+        std::min(size, (16 - reinterpret_cast<uintptr_t>(dest) % 16) % 16);
+    std::memcpy(dest, src, head);
+    size_t i = head;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dest + i), v);
+    }
+    std::memcpy(dest + i, src + i, size - i);
+#else
+    std::memcpy(dest, src, size);
+#endif
+}
+
+void StreamCopyFence() noexcept
+{
+#ifdef __SSE2__
+    _mm_sfence();
+#endif
 }
-//*************** End of NdCopy() and its 8 helpers ***************
 
 void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
                  const bool destRowMajor, const char *src, const Dims &srcStart,
@@ -14,6 +14,7 @@
 
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <string>
+#include <utility> //std::pair
 #include <vector>
 /// \endcond
 
@@ -222,8 +223,9 @@ void Resize(std::vector<T> &vec, const size_t dataSize, const std::string hint,
  * address calculation for each copied block is reduced to O(1) from O(n).
  * which means the computational cost is drastically reduced for data of higher
  * dimensions.
- * For copying involving column major, or different endianess only the
- * second optimization is applied.
+ * For copying involving column major, the copy goes through cache-sized tiles
+ * of the plane of the fastest input and output dimensions, reversing the
+ * endianess in the same pass if needed.
  * Note: in case of super high dimensional data(over 10000 dimensions),
  * function stack may run out, set safeMode=true to switch to iterative
  * algms(a little slower due to explicit stack running less efficiently).
@@ -245,6 +247,8 @@ void Resize(std::vector<T> &vec, const size_t dataSize, const std::string hint,
  *                 used by recursive algm is equal to the number of dimensions.
  *                 true: runs a bit slower, same algorithm using the explicit
  *                 stack/simulated stack which has more overhead for the algm.
+ * @param threads max number of threads for large copies between row-major
+ *                and column-major buffers
  */
 
 int NdCopy(const char *in, const CoreDims &inStart, const CoreDims &inCount,
@@ -256,7 +260,58 @@ int NdCopy(const char *in, const CoreDims &inStart, const CoreDims &inCount,
            const CoreDims &outMemStart = CoreDims(),
            const CoreDims &outMemCount = CoreDims(),
            const bool safeMode = false,
-           MemorySpace MemSpace = MemorySpace::Host);
+           MemorySpace MemSpace = MemorySpace::Host,
+           const unsigned int threads = 1);
+
+/**
+ * The contiguous runs of a row-major to row-major NdCopy of the same
+ * endianess. Copies between the same pair of boxes, e.g. the same writer
+ * block and read selection in every step, can replay the runs instead of
+ * walking the boxes again. The runs are described by the offsets of the
+ * first one and the strides of the dimensions they are laid out in, so a
+ * plan takes the same memory however many runs it has.
+ */
+struct NdCopyPlan
+{
+    /** bytes in each run */
+    size_t RunSize = 0;
+    /** number of runs, 0 if the boxes do not overlap */
+    size_t NumRuns = 0;
+    /** byte offsets of the first run from the input and the output buffer */
+    size_t InOffset = 0;
+    size_t OutOffset = 0;
+    /** runs and byte strides in each dimension above the runs, slowest
+     * first */
+    std::vector<size_t> Count;
+    std::vector<size_t> InStride;
+    std::vector<size_t> OutStride;
+};
+
+/**
+ * Plans the copy done by NdCopy(in, inStart, inCount, true, endian, out,
+ * outStart, outCount, true, endian, typeSize)
+ * @return a plan without runs if the boxes do not overlap
+ */
+NdCopyPlan NdCopyMakePlan(const CoreDims &inStart, const CoreDims &inCount,
+                          const CoreDims &outStart, const CoreDims &outCount,
+                          const size_t typeSize);
+
+/**
+ * Copies the runs of plan from in to out. Large copies are split by bytes
+ * over at most threads threads, long runs use non-temporal stores.
+ */
+void NdCopyExecutePlan(const NdCopyPlan &plan, const char *in, char *out,
+                       const unsigned int threads = 1) noexcept;
+
+/**
+ * std::memcpy with non-temporal stores where the CPU has them, for large
+ * destinations that are not read again soon. Call StreamCopyFence() before
+ * handing dest to another thread.
+ */
+void StreamCopy(char *dest, const char *src, const size_t size) noexcept;
+
+/** Orders the stores of previous StreamCopy() calls before later stores */
+void StreamCopyFence() noexcept;
 
 template <class T>
 size_t PayloadSize(const T *data, const Dims &count) noexcept;
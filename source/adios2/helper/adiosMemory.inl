@@ -694,7 +694,7 @@ void Resize(std::vector<T> &vec, const size_t dataSize, const std::string hint,
     }
 }
 
-//***************Start of NdCopy() and its 8 helpers ***************
+//***************Start of NdCopy() and its helpers ***************
 // Author:Shawn Yang, shawnyang610@gmail.com
 //
 // NdCopyRecurDFSeqPadding(): helper function
@@ -785,67 +785,6 @@ NdCopyRecurDFSeqPaddingRevEndian(size_t curDim, const char *&inOvlpBase,
     outOvlpBase += outOvlpGapSize[curDim];
 }
 
-// NdCopyRecurDFNonSeqDynamic(): helper function
-// Copys n-dimensional Data from input to output in the same Endianess
-// used for buffer of Column major
-// the memory address calculation complexity for copying each element is
-// minimized to average O(1), which is independent of the number of dimensions.
-static inline void
-NdCopyRecurDFNonSeqDynamic(size_t curDim, const char *inBase, char *outBase,
-                           CoreDims &inRltvOvlpSPos, CoreDims &outRltvOvlpSPos,
-                           CoreDims &inStride, CoreDims &outStride,
-                           CoreDims &ovlpCount, size_t elmSize)
-{
-    if (curDim == inStride.size())
-    {
-        std::memcpy(outBase, inBase, elmSize);
-    }
-    else
-    {
-        for (size_t i = 0; i < ovlpCount[curDim]; i++)
-        {
-            NdCopyRecurDFNonSeqDynamic(
-                curDim + 1,
-                inBase + (inRltvOvlpSPos[curDim] + i) * inStride[curDim],
-                outBase + (outRltvOvlpSPos[curDim] + i) * outStride[curDim],
-                inRltvOvlpSPos, outRltvOvlpSPos, inStride, outStride, ovlpCount,
-                elmSize);
-        }
-    }
-}
-
-// NdCopyRecurDFNonSeqDynamicRevEndian(): helper function
-// Copies n-dimensional Data from input to output in the reversed Endianess and
-// Major.
-// The memory address calculation complexity for copying each element is
-// minimized to average O(1), which is independent of the number of dimensions.
-
-static inline void NdCopyRecurDFNonSeqDynamicRevEndian(
-    size_t curDim, const char *inBase, char *outBase, CoreDims &inRltvOvlpSPos,
-    CoreDims &outRltvOvlpSPos, CoreDims &inStride, CoreDims &outStride,
-    CoreDims &ovlpCount, size_t elmSize)
-{
-    if (curDim == inStride.size())
-    {
-        for (size_t i = 0; i < elmSize; i++)
-        {
-            outBase[i] = inBase[elmSize - 1 - i];
-        }
-    }
-    else
-    {
-        for (size_t i = 0; i < ovlpCount[curDim]; i++)
-        {
-            NdCopyRecurDFNonSeqDynamicRevEndian(
-                curDim + 1,
-                inBase + (inRltvOvlpSPos[curDim] + i) * inStride[curDim],
-                outBase + (outRltvOvlpSPos[curDim] + i) * outStride[curDim],
-                inRltvOvlpSPos, outRltvOvlpSPos, inStride, outStride, ovlpCount,
-                elmSize);
-        }
-    }
-}
-
 static inline void
 NdCopyIterDFSeqPadding(const char *&inOvlpBase, char *&outOvlpBase,
                        CoreDims &inOvlpGapSize, CoreDims &outOvlpGapSize,
@@ -913,84 +852,6 @@ static inline void NdCopyIterDFSeqPaddingRevEndian(
         } while (pos[curDim] == ovlpCount[curDim]);
     }
 }
-static inline void NdCopyIterDFDynamic(const char *inBase, char *outBase,
-                                       CoreDims &inRltvOvlpSPos,
-                                       CoreDims &outRltvOvlpSPos,
-                                       CoreDims &inStride, CoreDims &outStride,
-                                       CoreDims &ovlpCount, size_t elmSize)
-{
-    size_t curDim = 0;
-    DimsArray pos(ovlpCount.size() + 1, (size_t)0);
-    std::vector<const char *> inAddr(ovlpCount.size() + 1);
-    inAddr[0] = inBase;
-    std::vector<char *> outAddr(ovlpCount.size() + 1);
-    outAddr[0] = outBase;
-    while (true)
-    {
-        while (curDim != inStride.size())
-        {
-            inAddr[curDim + 1] =
-                inAddr[curDim] +
-                (inRltvOvlpSPos[curDim] + pos[curDim]) * inStride[curDim];
-            outAddr[curDim + 1] =
-                outAddr[curDim] +
-                (outRltvOvlpSPos[curDim] + pos[curDim]) * outStride[curDim];
-            pos[curDim]++;
-            curDim++;
-        }
-        std::memcpy(outAddr[curDim], inAddr[curDim], elmSize);
-        do
-        {
-            if (curDim == 0)
-            {
-                return;
-            }
-            pos[curDim] = 0;
-            curDim--;
-        } while (pos[curDim] == ovlpCount[curDim]);
-    }
-}
-
-static inline void NdCopyIterDFDynamicRevEndian(
-    const char *inBase, char *outBase, CoreDims &inRltvOvlpSPos,
-    CoreDims &outRltvOvlpSPos, CoreDims &inStride, CoreDims &outStride,
-    CoreDims &ovlpCount, size_t elmSize)
-{
-    size_t curDim = 0;
-    DimsArray pos(ovlpCount.size() + 1, (size_t)0);
-    std::vector<const char *> inAddr(ovlpCount.size() + 1);
-    inAddr[0] = inBase;
-    std::vector<char *> outAddr(ovlpCount.size() + 1);
-    outAddr[0] = outBase;
-    while (true)
-    {
-        while (curDim != inStride.size())
-        {
-            inAddr[curDim + 1] =
-                inAddr[curDim] +
-                (inRltvOvlpSPos[curDim] + pos[curDim]) * inStride[curDim];
-            outAddr[curDim + 1] =
-                outAddr[curDim] +
-                (outRltvOvlpSPos[curDim] + pos[curDim]) * outStride[curDim];
-            pos[curDim]++;
-            curDim++;
-        }
-        for (size_t i = 0; i < elmSize; i++)
-        {
-            outAddr[curDim][i] = inAddr[curDim][elmSize - 1 - i];
-        }
-        do
-        {
-            if (curDim == 0)
-            {
-                return;
-            }
-            pos[curDim] = 0;
-            curDim--;
-        } while (pos[curDim] == ovlpCount[curDim]);
-    }
-}
-
 template <class T>
 size_t PayloadSize(const T * /*data*/, const Dims &count) noexcept
 {
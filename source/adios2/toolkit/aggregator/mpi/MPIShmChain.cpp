@@ -12,6 +12,7 @@
 #include "adios2/helper/adiosMemory.h" // PaddingToAlignOffset
 
 #include <iostream>
+#include <new>
 
 namespace adios2
 {
@@ -215,7 +216,7 @@ void MPIShmChain::HandshakeLinks_Complete(HandshakeStruct &hs)
 }
 
 void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
-                            const size_t alignment_size)
+                            const size_t alignment_size, const size_t numSlots)
 {
     if (!m_Comm.IsMPI())
     {
@@ -223,23 +224,40 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
             "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
             "called with a non-MPI communicator");
     }
+    if (numSlots < 1)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
+            "the shared memory ring needs at least one slot");
+    }
     char *ptr;
-    size_t structsize = sizeof(ShmSegment);
+    size_t structsize = sizeof(ShmSegment) + numSlots * sizeof(ShmSlot);
     structsize += helper::PaddingToAlignOffset(structsize, alignment_size);
     if (!m_Rank)
     {
         blocksize += helper::PaddingToAlignOffset(blocksize, alignment_size);
-        size_t totalsize = structsize + 2 * blocksize;
+        size_t totalsize = structsize + numSlots * blocksize;
         if (totalsize > maxsegmentsize)
         {
-            // roll back and calculate sizes from maxsegmentsize
-            totalsize = maxsegmentsize - alignment_size + 1;
-            totalsize +=
-                helper::PaddingToAlignOffset(totalsize, alignment_size);
-            blocksize = (totalsize - structsize) / 2 - alignment_size + 1;
-            blocksize +=
-                helper::PaddingToAlignOffset(blocksize, alignment_size);
-            totalsize = structsize + 2 * blocksize;
+            // calculate sizes from maxsegmentsize, rounding down to alignment
+            if (maxsegmentsize > structsize)
+            {
+                blocksize = (maxsegmentsize - structsize) / numSlots;
+                blocksize -= blocksize % alignment_size;
+            }
+            else
+            {
+                blocksize = 0;
+            }
+            if (!blocksize)
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Toolkit", "aggregator::mpi::MPIShmChain", "CreateShm",
+                    "MaxShmSize " + std::to_string(maxsegmentsize) +
+                        " is too small for " + std::to_string(numSlots) +
+                        " shared memory buffers");
+            }
+            totalsize = structsize + numSlots * blocksize;
         }
         m_Win = m_Comm.Win_allocate_shared(totalsize, 1, &ptr);
     }
@@ -249,178 +267,145 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
         size_t shmsize;
         int disp_unit;
         m_Comm.Win_shared_query(m_Win, 0, &shmsize, &disp_unit, &ptr);
-        blocksize = (shmsize - structsize) / 2;
     }
     m_Shm = reinterpret_cast<ShmSegment *>(ptr);
-    m_ShmBufA = ptr + structsize;
-    m_ShmBufB = m_ShmBufA + blocksize;
+    m_ShmSlots = reinterpret_cast<ShmSlot *>(ptr + sizeof(ShmSegment));
+    m_ShmBufs = ptr + structsize;
 
     if (!m_Rank)
     {
-        m_Shm->producerBuffer = LastBufferUsed::None;
-        m_Shm->consumerBuffer = LastBufferUsed::None;
-        m_Shm->NumBuffersFull = 0;
-        m_Shm->sdbA.buf = nullptr;
-        m_Shm->sdbA.max_size = blocksize;
-        m_Shm->sdbB.buf = nullptr;
-        m_Shm->sdbB.max_size = blocksize;
+        m_Shm->numSlots = numSlots;
+        m_Shm->blockSize = blocksize;
+        for (size_t i = 0; i < numSlots; ++i)
+        {
+            new (&m_ShmSlots[i].turn) std::atomic<uint32_t>(0);
+            new (&m_ShmSlots[i].waiters) std::atomic<uint32_t>(0);
+            m_ShmSlots[i].sdb.buf = nullptr;
+            m_ShmSlots[i].sdb.max_size = blocksize;
+            m_ShmSlots[i].sdb.actual_size = 0;
+        }
     }
-    /*std::cout << "Rank " << m_Rank << " shm = " << ptr
-              << " bufA = " << static_cast<void *>(m_Shm->bufA)
-              << " bufB = " << static_cast<void *>(m_Shm->bufB) << std::endl;*/
+    // producers start filling without any further handshake with rank 0
+    m_Comm.Barrier("MPIShmChain::CreateShm");
 }
 
 void MPIShmChain::DestroyShm() { m_Comm.Win_free(m_Win); }
 
+size_t
+MPIShmChain::FirstProducerChunk(const std::vector<uint64_t> &sizes) const
+{
+    const uint64_t blocksize = m_Shm->blockSize;
+    size_t chunk = 0;
+    if (!blocksize)
+    {
+        // nobody has any data to send
+        return chunk;
+    }
+    for (size_t r = 1; r < static_cast<size_t>(m_Rank); ++r)
+    {
+        chunk += static_cast<size_t>((sizes[r] + blocksize - 1) / blocksize);
+    }
+    return chunk;
+}
+
 /*
    The buffering strategy is the following.
-   Assumptions: 1. Only one Producer (and one Consumer) is active at a time.
-
-   The first Producer fills buffer A first then B and then is always
-   alternating, blocking when Consumer is behind (NumBuffersFull == 2).
-   The next Producer will continue with the alternating pattern where the
-   previous Producer has finished.
-
-   The Consumer is blocked until there is at least one buffer available.
-   It takes buffer A at the first call, then it alternates between the two
-   buffers.
-
-   C++ atomic locks in Shm for IPC locking:
-   - lockSegment is used to modify the m_Shm variables exclusively (short time),
-   - lockA and lockB are used to give long term exclusive access to one buffer
-   to be filled or consumed.
-
-   The sleeping phases, to wait on the other party to catch up, are outside of
-   the locking code areas.
-
-   Note: the m_Shm->sdbX.buf pointers must be set on the local process every
+   The shared memory segment holds a ring of numSlots buffers. The
+   non-aggregator data is cut into chunks of blockSize (only the last chunk
+   of each process is shorter), and chunks are numbered in the order they go
+   into the file. Every process knows the data size of every other process,
+   so each producer knows the number of its first chunk and fills its chunks
+   without waiting for the producers before it, as long as there is a free
+   slot for them in the ring.
+
+   Chunk 'c' goes through slot 'c % numSlots' in round 'c / numSlots'.
+   The turn counter of a slot is 2*round while it waits for the producer of
+   the chunk and 2*round+1 while it waits for the consumer. The producer and
+   the consumer of a chunk are the only ones waiting for a given value, so
+   there is no need for locks, only to order the buffer accesses around the
+   counter updates.
+
+   The Consumer (aggregator) takes the chunks in order, so the data is
+   written to the file in offset order.
+
+   The waiting phases, to wait on the other party to catch up, spin briefly
+   on the turn counter and then sleep until the other party passes the turn
+   (see shm/AtomicWait.h). The waiters counter lets the other party skip the
+   wakeup call when nobody is sleeping.
+
+   Note: the sdb.buf pointers must be set on the local process every
    time, even tough it is stored on the shared memory segment, because the
    address of the segment is different on every process. Failing to set on the
    local process causes this pointer pointing to an invalid address (set on
    another process).
 
-   Note: the sdbA and sdbB structs are stored on the shared memory segment
+   Note: the sdb structs are stored on the shared memory segment
    because they contain 'actual_size' which is set on the Producer and used by
    the Consumer.
 
 */
 
-MPIShmChain::ShmDataBuffer *MPIShmChain::LockProducerBuffer()
+MPIShmChain::ShmSlot &MPIShmChain::Slot(const size_t chunk) const noexcept
 {
-    MPIShmChain::ShmDataBuffer *sdb = nullptr;
-
-    // Sleep until there is a buffer available at all
-    while (m_Shm->NumBuffersFull == 2)
-    {
-        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
-    }
-
-    m_Shm->lockSegment.lock();
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
-
-    {
-        m_Shm->producerBuffer = LastBufferUsed::B;
-        sdb = &m_Shm->sdbB;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufB;
-    }
-    else // None or B
-    {
-        m_Shm->producerBuffer = LastBufferUsed::A;
-        sdb = &m_Shm->sdbA;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufA;
-    }
-    m_Shm->lockSegment.unlock();
-
-    // We determined we want a specific buffer
-    // Now we need to get a lock on it in case consumer is using it
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.lock();
-    }
-    else
-    {
-        m_Shm->lockB.lock();
-    }
-
-    return sdb;
+    return m_ShmSlots[chunk % m_Shm->numSlots];
 }
 
-void MPIShmChain::UnlockProducerBuffer()
+void MPIShmChain::WaitForTurn(ShmSlot &slot, const uint32_t turn) const
+    noexcept
 {
-    m_Shm->lockSegment.lock();
-    ++m_Shm->NumBuffersFull;
-    m_Shm->lockSegment.unlock();
-
-    if (m_Shm->producerBuffer == LastBufferUsed::A)
+    uint32_t t = slot.turn.load(std::memory_order_acquire);
+    if (t == turn)
     {
-        m_Shm->lockA.unlock();
+        return;
     }
-    else
+    // seq_cst: PassTurn either sees this waiter or we see the new turn
+    slot.waiters.fetch_add(1);
+    while ((t = slot.turn.load()) != turn)
     {
-        m_Shm->lockB.unlock();
+        shm::AtomicWait(slot.turn, t);
     }
+    slot.waiters.fetch_sub(1);
 }
 
-MPIShmChain::ShmDataBuffer *MPIShmChain::LockConsumerBuffer()
+void MPIShmChain::PassTurn(ShmSlot &slot, const uint32_t turn) const noexcept
 {
-    MPIShmChain::ShmDataBuffer *sdb = nullptr;
-
-    // Sleep until there is at least one buffer filled
-    while (m_Shm->NumBuffersFull < 1)
+    slot.turn.store(turn);
+    if (slot.waiters.load())
     {
-        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
+        // the next producer of the slot may wait for a later round
+        shm::AtomicNotifyAll(slot.turn);
     }
-    // At this point we know buffer A has content or going to have content
-    // when we successfully lock it
-
-    m_Shm->lockSegment.lock();
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-
-    {
-        m_Shm->consumerBuffer = LastBufferUsed::B;
-        sdb = &m_Shm->sdbB;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufB;
-    }
-    else // None or B
-    {
-        m_Shm->consumerBuffer = LastBufferUsed::A;
-        sdb = &m_Shm->sdbA;
-        // point to shm data buffer (in local process memory)
-        sdb->buf = m_ShmBufA;
-    }
-    m_Shm->lockSegment.unlock();
+}
 
-    // We determined we want a specific buffer
-    // Now we need to get a lock on it in case producer is using it
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.lock();
-    }
-    else
-    {
-        m_Shm->lockB.lock();
-    }
+MPIShmChain::ShmDataBuffer *MPIShmChain::LockProducerBuffer(const size_t chunk)
+{
+    ShmSlot &slot = Slot(chunk);
+    WaitForTurn(slot, static_cast<uint32_t>(2 * (chunk / m_Shm->numSlots)));
+    // point to shm data buffer (in local process memory)
+    slot.sdb.buf = m_ShmBufs + (chunk % m_Shm->numSlots) * m_Shm->blockSize;
+    return &slot.sdb;
+}
 
-    return sdb;
+void MPIShmChain::UnlockProducerBuffer(const size_t chunk)
+{
+    PassTurn(Slot(chunk),
+             static_cast<uint32_t>(2 * (chunk / m_Shm->numSlots) + 1));
 }
 
-void MPIShmChain::UnlockConsumerBuffer()
+MPIShmChain::ShmDataBuffer *MPIShmChain::LockConsumerBuffer(const size_t chunk)
 {
-    m_Shm->lockSegment.lock();
-    --m_Shm->NumBuffersFull;
-    m_Shm->lockSegment.unlock();
+    ShmSlot &slot = Slot(chunk);
+    WaitForTurn(slot,
+                static_cast<uint32_t>(2 * (chunk / m_Shm->numSlots) + 1));
+    // point to shm data buffer (in local process memory)
+    slot.sdb.buf = m_ShmBufs + (chunk % m_Shm->numSlots) * m_Shm->blockSize;
+    return &slot.sdb;
+}
 
-    if (m_Shm->consumerBuffer == LastBufferUsed::A)
-    {
-        m_Shm->lockA.unlock();
-    }
-    else
-    {
-        m_Shm->lockB.unlock();
-    }
+void MPIShmChain::UnlockConsumerBuffer(const size_t chunk)
+{
+    PassTurn(Slot(chunk),
+             static_cast<uint32_t>(2 * (chunk / m_Shm->numSlots) + 2));
 }
 
 } // end namespace aggregator
@@ -14,20 +14,19 @@
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+#include "adios2/toolkit/shm/AtomicWait.h"
 #include "adios2/toolkit/shm/Spinlock.h"
 
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 namespace adios2
 {
 namespace aggregator
 {
 
-// constexpr size_t SHM_BUF_SIZE = 4194304; // 4MB
-// we allocate 2x this size + a bit for shared memory segment
-
 /** A one- or two-layer aggregator chain for using Shared memory within a
  * compute node.
  * Use MPI split type to group processes within a node into one chain.
@@ -103,15 +102,21 @@ public:
         char *buf;
     };
 
-    ShmDataBuffer *LockProducerBuffer();
-    void UnlockProducerBuffer();
-    ShmDataBuffer *LockConsumerBuffer();
-    void UnlockConsumerBuffer();
-    void ResetBuffers() noexcept;
+    /* The data of the non-aggregators is passed on in chunks of
+     * ShmDataBuffer::max_size, numbered in file offset order. Chunk 'chunk'
+     * goes through slot 'chunk % numSlots' of the ring. */
+    ShmDataBuffer *LockProducerBuffer(const size_t chunk);
+    void UnlockProducerBuffer(const size_t chunk);
+    ShmDataBuffer *LockConsumerBuffer(const size_t chunk);
+    void UnlockConsumerBuffer(const size_t chunk);
+
+    /* First chunk of this process, from the data sizes of every process
+     * in m_Comm (the aggregator's own data does not go through shm) */
+    size_t FirstProducerChunk(const std::vector<uint64_t> &sizes) const;
 
-    // 2*blocksize+some is allocated but only up to maxsegmentsize
+    // numSlots*blocksize+some is allocated but only up to maxsegmentsize
     void CreateShm(size_t blocksize, const size_t maxsegmentsize,
-                   const size_t alignment_size);
+                   const size_t alignment_size, const size_t numSlots = 2);
     void DestroyShm();
 
 private:
@@ -128,32 +133,30 @@ private:
 
     helper::Comm::Win m_Win;
 
-    enum class LastBufferUsed
+    struct ShmSlot
     {
-        None,
-        A,
-        B
+        /* 2*round: empty, waiting for chunk 'round*numSlots + slot'
+           2*round+1: full, waiting for the consumer */
+        std::atomic<uint32_t> turn;
+        // number of processes blocked on turn, to be woken up
+        std::atomic<uint32_t> waiters;
+        // user facing struct
+        ShmDataBuffer sdb;
     };
 
     struct ShmSegment
     {
-        LastBufferUsed producerBuffer;
-        LastBufferUsed consumerBuffer;
-        unsigned int NumBuffersFull;
-        // user facing structs
-        ShmDataBuffer sdbA;
-        ShmDataBuffer sdbB;
-        shm::Spinlock lockSegment;
-        // locks for individual buffers (sdb and buf)
-        shm::Spinlock lockA;
-        shm::Spinlock lockB;
-        // the actual data buffers
-        // char bufA[SHM_BUF_SIZE];
-        // char bufB[SHM_BUF_SIZE];
+        size_t numSlots;
+        size_t blockSize;
+        // followed by ShmSlot slots[numSlots] and the data buffers
     };
     ShmSegment *m_Shm;
-    char *m_ShmBufA;
-    char *m_ShmBufB;
+    ShmSlot *m_ShmSlots;
+    char *m_ShmBufs;
+
+    ShmSlot &Slot(const size_t chunk) const noexcept;
+    void WaitForTurn(ShmSlot &slot, const uint32_t turn) const noexcept;
+    void PassTurn(ShmSlot &slot, const uint32_t turn) const noexcept;
 };
 
 } // end namespace aggregator
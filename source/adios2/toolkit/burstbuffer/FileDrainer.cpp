@@ -42,8 +42,7 @@ FileDrainOperation::FileDrainOperation(DrainOperation op,
 
 void FileDrainer::AddOperation(FileDrainOperation &operation)
 {
-    std::lock_guard<std::mutex> lockGuard(operationsMutex);
-    operations.push(operation);
+    Enqueue(FileDrainOperation(operation));
 }
 
 void FileDrainer::AddOperation(DrainOperation op,
@@ -52,10 +51,14 @@ void FileDrainer::AddOperation(DrainOperation op,
                                size_t toOffset, size_t countBytes,
                                const void *data)
 {
-    FileDrainOperation operation(op, fromFileName, toFileName, countBytes,
-                                 fromOffset, toOffset, data);
+    Enqueue(FileDrainOperation(op, fromFileName, toFileName, countBytes,
+                               fromOffset, toOffset, data));
+}
+
+void FileDrainer::Enqueue(FileDrainOperation &&operation)
+{
     std::lock_guard<std::mutex> lockGuard(operationsMutex);
-    operations.push(operation);
+    operations.push(std::move(operation));
 }
 
 void FileDrainer::AddOperationSeekEnd(const std::string &toFileName)
@@ -33,8 +33,7 @@ enum class DrainOperation
     SeekEnd, // Seek to the end of target file toFileName (for future
              // copyAppend). Seeking to End of fromFile is not allowed
              // since another thread is writing to it
-    CopyAt,  // DO NOT USE: Copy countBytes from fromOffset to toOffset (does
-             // seek)
+    CopyAt,  // Copy countBytes from fromOffset to toOffset (does seek)
     Copy,    // Copy countBytes (without seek)
     WriteAt, // Write data from memory to toFileName directly at offset
     Write,   // Write data from memory to toFileName directly (without seek)
@@ -107,6 +106,10 @@ protected:
     std::queue<FileDrainOperation> operations;
     std::mutex operationsMutex;
 
+    /** Put an operation at the end of the queue. All AddOperation functions
+     * end up here */
+    virtual void Enqueue(FileDrainOperation &&operation);
+
     /** rank of process just for stdout/stderr messages */
     int m_Rank = 0;
     int m_Verbose = 0;
@@ -0,0 +1,690 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileDrainerMultiStream.cpp
+ *
+ */
+
+#include "FileDrainerMultiStream.h"
+#include "adios2/helper/adiosLog.h"
+
+#ifdef ADIOS2_HAVE_O_DIRECT
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#endif
+
+#include <algorithm> // std::min
+#include <cerrno>    // errno
+#include <chrono>
+#include <cstdio> // std::remove
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>     // open
+#include <sys/stat.h>  // fstat
+#include <sys/types.h> // open
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h> // pread, pwrite, close
+#endif
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <ios> //std::ios_base::failure
+/// \endcond
+
+#include "../../core/CoreTypes.h"
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+namespace
+{
+
+#ifdef _WIN32
+/* no positional I/O, seek and read/write must not be interleaved */
+std::mutex positionMutex;
+
+int OpenFile(const std::string &path, int flags)
+{
+    return _open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+int64_t PRead(int fd, char *buffer, size_t count, uint64_t offset)
+{
+    std::lock_guard<std::mutex> lockGuard(positionMutex);
+    _lseeki64(fd, static_cast<__int64>(offset), SEEK_SET);
+    return _read(fd, buffer, static_cast<unsigned int>(count));
+}
+
+int64_t PWrite(int fd, const char *buffer, size_t count, uint64_t offset)
+{
+    std::lock_guard<std::mutex> lockGuard(positionMutex);
+    _lseeki64(fd, static_cast<__int64>(offset), SEEK_SET);
+    return _write(fd, buffer, static_cast<unsigned int>(count));
+}
+
+uint64_t FileSize(int fd)
+{
+    std::lock_guard<std::mutex> lockGuard(positionMutex);
+    return static_cast<uint64_t>(_lseeki64(fd, 0, SEEK_END));
+}
+
+void CloseFd(int fd) { _close(fd); }
+#else
+int OpenFile(const std::string &path, int flags)
+{
+    return open(path.c_str(), flags, 0666);
+}
+
+int64_t PRead(int fd, char *buffer, size_t count, uint64_t offset)
+{
+    return pread(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+int64_t PWrite(int fd, const char *buffer, size_t count, uint64_t offset)
+{
+    return pwrite(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+uint64_t FileSize(int fd)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(st.st_size);
+}
+
+void CloseFd(int fd) { close(fd); }
+#endif
+
+void PWriteAll(int fd, const char *buffer, size_t count, uint64_t offset,
+               const std::string &path)
+{
+    while (count > 0)
+    {
+        const int64_t n = PWrite(fd, buffer, count, offset);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "BurstBuffer::FileDrainerMultiStream", "Write",
+                "couldn't write to file " + path +
+                    " offset = " + std::to_string(offset) +
+                    " count = " + std::to_string(count) +
+                    " bytes: " + std::strerror(errno));
+        }
+        buffer += n;
+        count -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+} // end anonymous namespace
+
+FileDrainerMultiStream::FileDrainerMultiStream() : FileDrainer() {}
+
+FileDrainerMultiStream::~FileDrainerMultiStream() { Join(); }
+
+void FileDrainerMultiStream::SetStreams(unsigned int nStreams)
+{
+    m_Streams = (nStreams ? nStreams : 1);
+}
+
+void FileDrainerMultiStream::SetBlockSize(size_t blockSizeBytes)
+{
+    m_BlockSize = (blockSizeBytes ? blockSizeBytes : defaultBlockSize);
+}
+
+void FileDrainerMultiStream::SetDirectIO(bool directIO, size_t alignment)
+{
+    m_DirectIO = directIO;
+    m_Alignment = (alignment ? alignment : 1);
+}
+
+void FileDrainerMultiStream::SetMaxPendingBytes(size_t maxPendingBytes)
+{
+    std::lock_guard<std::mutex> lockGuard(operationsMutex);
+    m_MaxPendingBytes = maxPendingBytes;
+}
+
+void FileDrainerMultiStream::Start()
+{
+    if (!m_Threads.empty())
+    {
+        return;
+    }
+#ifndef ADIOS2_HAVE_O_DIRECT
+    m_DirectIO = false;
+#endif
+    if (!m_DirectIO)
+    {
+        m_Alignment = 1;
+    }
+    // blocks end on alignment boundaries of the target, so that all but the
+    // first and last block of a copy can be written with O_DIRECT
+    m_BlockSize = (m_BlockSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+    m_Finish = false;
+    for (unsigned int i = 0; i < m_Streams; ++i)
+    {
+        m_Threads.emplace_back(&FileDrainerMultiStream::DrainThread, this);
+    }
+}
+
+void FileDrainerMultiStream::Finish()
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(operationsMutex);
+        m_Finish = true;
+    }
+    m_Changed.notify_all();
+}
+
+void FileDrainerMultiStream::Join()
+{
+    if (m_Threads.empty())
+    {
+        return;
+    }
+    const auto tTotalStart = core::Now();
+
+    Finish();
+    for (auto &th : m_Threads)
+    {
+        th.join();
+    }
+    m_Threads.clear();
+    CloseAllFiles();
+
+    const core::Seconds timeTotal = core::Now() - tTotalStart;
+    const Statistics &s = m_Statistics;
+    if (m_Verbose)
+    {
+        std::cout << "Drain " << m_Rank << ": Waited for " << m_Streams
+                  << " threads to join = " << timeTotal.count()
+                  << " seconds. Time in streams: read = " << s.timeRead
+                  << " write = " << s.timeWrite
+                  << " seconds. Max queue size = " << s.maxQueueSize
+                  << ". Read " << s.nReadBytes << " bytes. Wrote "
+                  << s.nWriteBytes << " bytes." << std::endl;
+        if (s.timeWaitOnRead > 0.0)
+        {
+            helper::Log("BurstBuffer", "FileDrainerMultiStream", "Join",
+                        "Drain " + std::to_string(m_Rank) +
+                            ": read had to wait " +
+                            std::to_string(s.timeWaitOnRead) +
+                            " seconds for the data to arrive on disk",
+                        helper::WARNING);
+        }
+    }
+    // each failure has been reported by the stream that hit it
+    if (s.nFailed)
+    {
+        helper::Log("BurstBuffer", "FileDrainerMultiStream", "Join",
+                    "Drain " + std::to_string(m_Rank) + ": " +
+                        std::to_string(s.nFailed) + " operations failed",
+                    helper::WARNING);
+    }
+}
+
+uint64_t FileDrainerMultiStream::GetAdded()
+{
+    std::lock_guard<std::mutex> lockGuard(operationsMutex);
+    return m_NumAdded;
+}
+
+uint64_t FileDrainerMultiStream::GetDrained()
+{
+    std::lock_guard<std::mutex> lockGuard(operationsMutex);
+    return m_InFlightOps.empty() ? m_NumRemoved : *m_InFlightOps.begin();
+}
+
+void FileDrainerMultiStream::WaitDrained(uint64_t mark)
+{
+    std::unique_lock<std::mutex> lock(operationsMutex);
+    m_Changed.wait(lock, [&]() {
+        return (m_InFlightOps.empty() ? m_NumRemoved
+                                      : *m_InFlightOps.begin()) >= mark;
+    });
+}
+
+void FileDrainerMultiStream::Enqueue(FileDrainOperation &&operation)
+{
+    if (operation.op == DrainOperation::Copy ||
+        operation.op == DrainOperation::CopyAt)
+    {
+        // open the source now, so that it can be deleted by another process
+        // once this call has returned
+        try
+        {
+            GetReadFile(operation.fromFileName);
+        }
+        catch (std::ios_base::failure &)
+        {
+            // tried again when the copy runs
+        }
+    }
+
+    const size_t bytes = operation.countBytes;
+    {
+        std::unique_lock<std::mutex> lock(operationsMutex);
+        if (m_MaxPendingBytes && !m_Threads.empty() && !m_Finish)
+        {
+            // an operation larger than the limit still goes into an empty
+            // queue, otherwise it would wait forever
+            m_Changed.wait(lock, [&]() {
+                return !m_PendingBytes ||
+                       m_PendingBytes + bytes <= m_MaxPendingBytes;
+            });
+        }
+        m_PendingBytes += bytes;
+        ++m_NumAdded;
+        operations.push(std::move(operation));
+        m_Statistics.maxQueueSize =
+            std::max(m_Statistics.maxQueueSize, operations.size());
+    }
+    m_Changed.notify_all();
+}
+
+int FileDrainerMultiStream::GetReadFile(const std::string &path)
+{
+    std::lock_guard<std::mutex> lockGuard(m_FilesMutex);
+    auto it = m_ReadFiles.find(path);
+    if (it != m_ReadFiles.end())
+    {
+        return it->second;
+    }
+    const int fd = OpenFile(path, O_RDONLY);
+    if (fd < 0)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Toolkit", "BurstBuffer::FileDrainerMultiStream", "GetReadFile",
+            "couldn't open file " + path + ": " + std::strerror(errno));
+    }
+    m_ReadFiles.emplace(path, fd);
+    return fd;
+}
+
+int FileDrainerMultiStream::GetWriteFile(const std::string &path,
+                                         bool truncate)
+{
+    std::lock_guard<std::mutex> lockGuard(m_FilesMutex);
+    auto it = m_WriteFiles.find(path);
+    if (it != m_WriteFiles.end())
+    {
+        return it->second;
+    }
+    const int fd =
+        OpenFile(path, O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0));
+    if (fd < 0)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Toolkit", "BurstBuffer::FileDrainerMultiStream", "GetWriteFile",
+            "couldn't open file " + path + ": " + std::strerror(errno));
+    }
+    m_WriteFiles.emplace(path, fd);
+    return fd;
+}
+
+int FileDrainerMultiStream::GetDirectFile(const std::string &path)
+{
+#ifdef ADIOS2_HAVE_O_DIRECT
+    if (!m_DirectIO)
+    {
+        return -1;
+    }
+    // creates the file if this is the first operation on it
+    GetWriteFile(path);
+    std::lock_guard<std::mutex> lockGuard(m_FilesMutex);
+    auto it = m_DirectFiles.find(path);
+    if (it != m_DirectFiles.end())
+    {
+        return it->second;
+    }
+    // file systems without O_DIRECT fail here, then all writes are buffered
+    const int fd = OpenFile(path, O_WRONLY | O_DIRECT);
+    m_DirectFiles.emplace(path, fd);
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+void FileDrainerMultiStream::CloseFile(const std::string &path)
+{
+    std::lock_guard<std::mutex> lockGuard(m_FilesMutex);
+    for (auto *files : {&m_ReadFiles, &m_WriteFiles, &m_DirectFiles})
+    {
+        auto it = files->find(path);
+        if (it != files->end())
+        {
+            if (it->second >= 0)
+            {
+                CloseFd(it->second);
+            }
+            files->erase(it);
+        }
+    }
+}
+
+void FileDrainerMultiStream::CloseAllFiles()
+{
+    std::lock_guard<std::mutex> lockGuard(m_FilesMutex);
+    for (auto *files : {&m_ReadFiles, &m_WriteFiles, &m_DirectFiles})
+    {
+        for (auto &f : *files)
+        {
+            if (f.second >= 0)
+            {
+                CloseFd(f.second);
+            }
+        }
+        files->clear();
+    }
+}
+
+uint64_t FileDrainerMultiStream::GetWriteFileSize(const std::string &path)
+{
+    return FileSize(GetWriteFile(path));
+}
+
+void FileDrainerMultiStream::WriteBlock(const std::string &path,
+                                        const char *data, size_t count,
+                                        uint64_t offset, bool aligned,
+                                        Statistics &stats)
+{
+    const auto ts = core::Now();
+    size_t nDirect = 0;
+    if (m_DirectIO && aligned && !(offset % m_Alignment))
+    {
+        nDirect = count - count % m_Alignment;
+        const int fd = (nDirect ? GetDirectFile(path) : -1);
+        if (fd < 0)
+        {
+            nDirect = 0;
+        }
+        else
+        {
+            PWriteAll(fd, data, nDirect, offset, path);
+        }
+    }
+    if (nDirect < count)
+    {
+        PWriteAll(GetWriteFile(path), data + nDirect, count - nDirect,
+                  offset + nDirect, path);
+    }
+    stats.nWriteBytes += count;
+    stats.timeWrite += core::Seconds(core::Now() - ts).count();
+}
+
+void FileDrainerMultiStream::CopyBlock(const FileDrainOperation &fdo,
+                                       char *buffer, Statistics &stats)
+{
+    if (m_Verbose >= 2)
+    {
+        std::ostringstream ss;
+        ss << "Drain " << m_Rank << ": Copy from " << fdo.fromFileName
+           << " -> " << fdo.toFileName << " " << fdo.countBytes
+           << " bytes, offsets: from " << fdo.fromOffset << " to "
+           << fdo.toOffset << "\n";
+        std::cout << ss.str();
+    }
+
+    const auto ts = core::Now();
+    const int fd = GetReadFile(fdo.fromFileName);
+    size_t nRead = 0;
+    while (nRead < fdo.countBytes)
+    {
+        const int64_t n = PRead(fd, buffer + nRead, fdo.countBytes - nRead,
+                                fdo.fromOffset + nRead);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "BurstBuffer::FileDrainerMultiStream", "CopyBlock",
+                "couldn't read from file " + fdo.fromFileName +
+                    " offset = " + std::to_string(fdo.fromOffset + nRead) +
+                    ": " + std::strerror(errno));
+        }
+        if (!n)
+        {
+            // the data has not arrived on disk yet
+            const double sleepUnit = 0.01; // seconds
+            std::this_thread::sleep_for(
+                std::chrono::duration<double>(sleepUnit));
+            stats.timeWaitOnRead += sleepUnit;
+            continue;
+        }
+        nRead += static_cast<size_t>(n);
+    }
+    stats.nReadBytes += nRead;
+    stats.timeRead += core::Seconds(core::Now() - ts).count();
+
+    WriteBlock(fdo.toFileName, buffer, fdo.countBytes, fdo.toOffset, true,
+               stats);
+}
+
+uint64_t FileDrainerMultiStream::RunOrdered(const FileDrainOperation &fdo,
+                                            uint64_t writeCursor,
+                                            Statistics &stats)
+{
+    if (m_Verbose >= 2)
+    {
+        std::ostringstream ss;
+        ss << "Drain " << m_Rank << ": ";
+        switch (fdo.op)
+        {
+        case DrainOperation::SeekEnd:
+            ss << "Seek to End of file " << fdo.toFileName;
+            break;
+        case DrainOperation::WriteAt:
+            ss << "Write to file " << fdo.toFileName << " " << fdo.countBytes
+               << " bytes of data from memory to offset " << fdo.toOffset;
+            break;
+        case DrainOperation::Write:
+            ss << "Write to file " << fdo.toFileName << " " << fdo.countBytes
+               << " bytes of data from memory to offset " << writeCursor;
+            break;
+        case DrainOperation::Create:
+            ss << "Create new file " << fdo.toFileName;
+            break;
+        case DrainOperation::Open:
+            ss << "Open file " << fdo.toFileName << " for append";
+            break;
+        case DrainOperation::Delete:
+            ss << "Delete file " << fdo.toFileName;
+            break;
+        default:
+            break;
+        }
+        ss << "\n";
+        std::cout << ss.str();
+    }
+
+    switch (fdo.op)
+    {
+    case DrainOperation::SeekEnd:
+        return GetWriteFileSize(fdo.toFileName);
+    case DrainOperation::WriteAt:
+        WriteBlock(fdo.toFileName, fdo.dataToWrite.data(), fdo.countBytes,
+                   fdo.toOffset, false, stats);
+        return fdo.toOffset + fdo.countBytes;
+    case DrainOperation::Write:
+        WriteBlock(fdo.toFileName, fdo.dataToWrite.data(), fdo.countBytes,
+                   writeCursor, false, stats);
+        return writeCursor + fdo.countBytes;
+    case DrainOperation::Create:
+        GetWriteFile(fdo.toFileName, true);
+        return 0;
+    case DrainOperation::Open:
+        GetWriteFile(fdo.toFileName, false);
+        return GetWriteFileSize(fdo.toFileName);
+    case DrainOperation::Delete:
+        CloseFile(fdo.toFileName);
+        std::remove(fdo.toFileName.c_str());
+        return 0;
+    default:
+        return writeCursor;
+    }
+}
+
+/*
+ * This function is running in m_Streams threads concurrently. Only the front
+ * of the queue is ever processed: a copy hands out its next block to each
+ * asking thread, any other operation waits until no block is in flight on
+ * its file and holds the front of the queue while it runs.
+ */
+void FileDrainerMultiStream::DrainThread()
+{
+    Statistics stats;
+    // fixed, preallocated buffer to read/write data, aligned for O_DIRECT
+    std::vector<char> storage(m_BlockSize + m_Alignment);
+    const size_t misalign =
+        reinterpret_cast<uintptr_t>(storage.data()) % m_Alignment;
+    char *buffer = storage.data() + (misalign ? m_Alignment - misalign : 0);
+
+    auto lf_Release = [&](const std::string &path) {
+        auto it = m_InFlight.find(path);
+        if (!--it->second)
+        {
+            m_InFlight.erase(it);
+        }
+    };
+
+    auto lf_Fail = [&](const std::exception &e) {
+        // called with operationsMutex held
+        ++stats.nFailed;
+        helper::Log("BurstBuffer", "FileDrainerMultiStream", "DrainThread",
+                    std::string(e.what()), helper::FATALERROR);
+    };
+
+    std::unique_lock<std::mutex> lock(operationsMutex);
+    while (true)
+    {
+        if (operations.empty())
+        {
+            if (m_Finish)
+            {
+                break;
+            }
+            m_Changed.wait(lock);
+            continue;
+        }
+        if (m_FrontRunning)
+        {
+            m_Changed.wait(lock);
+            continue;
+        }
+
+        FileDrainOperation &front = operations.front();
+        if (front.op == DrainOperation::Copy)
+        {
+            front.fromOffset = m_ReadCursor[front.fromFileName];
+            front.toOffset = m_WriteCursor[front.toFileName];
+            front.op = DrainOperation::CopyAt;
+        }
+
+        if (front.op == DrainOperation::CopyAt)
+        {
+            const size_t count =
+                std::min(m_BlockSize - front.toOffset % m_Alignment,
+                         front.countBytes);
+            FileDrainOperation block(DrainOperation::CopyAt,
+                                     front.fromFileName, front.toFileName,
+                                     count, front.fromOffset, front.toOffset,
+                                     nullptr);
+            front.fromOffset += count;
+            front.toOffset += count;
+            front.countBytes -= count;
+            m_ReadCursor[front.fromFileName] = front.fromOffset;
+            m_WriteCursor[front.toFileName] = front.toOffset;
+            const auto op = m_InFlightOps.insert(m_NumRemoved);
+            if (!front.countBytes)
+            {
+                operations.pop();
+                ++m_NumRemoved;
+            }
+            ++m_InFlight[block.fromFileName];
+            ++m_InFlight[block.toFileName];
+            lock.unlock();
+            m_Changed.notify_all(); // the next block is up for grabs
+
+            try
+            {
+                CopyBlock(block, buffer, stats);
+                lock.lock();
+            }
+            catch (std::exception &e)
+            {
+                lock.lock();
+                lf_Fail(e);
+            }
+            lf_Release(block.fromFileName);
+            lf_Release(block.toFileName);
+            m_InFlightOps.erase(op);
+            m_PendingBytes -= count;
+            m_Changed.notify_all();
+            continue;
+        }
+
+        // keep the order of operations on the same file
+        if (m_InFlight.count(front.toFileName))
+        {
+            m_Changed.wait(lock);
+            continue;
+        }
+        m_FrontRunning = true;
+        uint64_t cursor = m_WriteCursor[front.toFileName];
+        lock.unlock();
+
+        // front stays valid, the queue only grows while m_FrontRunning
+        try
+        {
+            cursor = RunOrdered(front, cursor, stats);
+            lock.lock();
+        }
+        catch (std::exception &e)
+        {
+            lock.lock();
+            lf_Fail(e);
+        }
+        if (front.op == DrainOperation::Delete)
+        {
+            m_ReadCursor.erase(front.toFileName);
+            m_WriteCursor.erase(front.toFileName);
+        }
+        else
+        {
+            m_WriteCursor[front.toFileName] = cursor;
+        }
+        m_PendingBytes -= front.countBytes;
+        operations.pop();
+        ++m_NumRemoved;
+        m_FrontRunning = false;
+        m_Changed.notify_all();
+    }
+
+    m_Statistics.timeRead += stats.timeRead;
+    m_Statistics.timeWrite += stats.timeWrite;
+    m_Statistics.timeWaitOnRead += stats.timeWaitOnRead;
+    m_Statistics.nReadBytes += stats.nReadBytes;
+    m_Statistics.nWriteBytes += stats.nWriteBytes;
+    m_Statistics.nFailed += stats.nFailed;
+}
+
+} // end namespace burstbuffer
+} // end namespace adios2
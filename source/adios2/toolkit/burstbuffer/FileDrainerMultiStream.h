@@ -0,0 +1,156 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileDrainerMultiStream.h
+ *
+ */
+
+#ifndef ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTISTREAM_H_
+#define ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTISTREAM_H_
+
+#include "adios2/toolkit/burstbuffer/FileDrainer.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+/**
+ * Drainer running several threads (streams) on one operations queue.
+ * Copy operations are split into large blocks which the streams read and
+ * write concurrently with positional I/O, optionally writing the target
+ * with O_DIRECT. All other operations are applied in queue order after the
+ * blocks in flight on the same file have completed.
+ * AddOperation blocks while the queued bytes exceed a limit (backpressure),
+ * so that the local storage cannot fill up faster than it drains.
+ */
+class FileDrainerMultiStream : public FileDrainer
+{
+
+public:
+    static const unsigned int defaultStreams = 4;
+    static const size_t defaultBlockSize = 16777216; // 16MB
+
+    FileDrainerMultiStream();
+
+    ~FileDrainerMultiStream();
+
+    /** Number of threads draining concurrently. Call before Start() */
+    void SetStreams(unsigned int nStreams);
+
+    /** Copies are split into blocks of this size. Call before Start() */
+    void SetBlockSize(size_t blockSizeBytes);
+
+    /** Write the target files with O_DIRECT where the offset and size are
+     * multiples of alignment (if supported on the system). Call before
+     * Start() */
+    void SetDirectIO(bool directIO, size_t alignment);
+
+    /** AddOperation blocks while more than maxPendingBytes are waiting to be
+     * drained. 0 means no limit. */
+    void SetMaxPendingBytes(size_t maxPendingBytes);
+
+    /** Create the threads. They idle while there are no operations given.
+     *  Finish() will complete all work then join the threads
+     */
+    void Start();
+
+    /** Tell threads to terminate when all draining has finished. */
+    void Finish();
+
+    /** Join the threads. Main thread will block until they terminate */
+    void Join();
+
+    /** Number of operations added so far. The operations added before the
+     * call have all been applied once GetDrained() reaches the returned
+     * value. */
+    uint64_t GetAdded();
+
+    /** Number of operations applied (or failed), counted from the first one
+     * added up to the first one not complete yet. Copies on different files
+     * complete out of order, operations behind an incomplete one are not
+     * counted yet. */
+    uint64_t GetDrained();
+
+    /** Block until GetDrained() >= mark */
+    void WaitDrained(uint64_t mark);
+
+protected:
+    void Enqueue(FileDrainOperation &&operation);
+
+private:
+    unsigned int m_Streams = defaultStreams;
+    size_t m_BlockSize = defaultBlockSize;
+    bool m_DirectIO = false;
+    size_t m_Alignment = 512;
+    size_t m_MaxPendingBytes = 0;
+
+    std::vector<std::thread> m_Threads;
+    /** signals queue changes to the streams and to blocked AddOperation
+     * calls, used with operationsMutex */
+    std::condition_variable m_Changed;
+    bool m_Finish = false;
+    /** an operation other than copy is running at the front of the queue */
+    bool m_FrontRunning = false;
+    /** bytes added and not yet drained */
+    size_t m_PendingBytes = 0;
+    /** operations added to the queue and removed from its front */
+    uint64_t m_NumAdded = 0;
+    uint64_t m_NumRemoved = 0;
+    /** queue position of the operation of each copy block in flight */
+    std::multiset<uint64_t> m_InFlightOps;
+    /** operations in flight on each file (either direction) */
+    std::map<std::string, size_t> m_InFlight;
+    /** offsets where the next Copy continues from / Write continues to */
+    std::map<std::string, uint64_t> m_ReadCursor;
+    std::map<std::string, uint64_t> m_WriteCursor;
+
+    struct Statistics
+    {
+        double timeRead = 0.0;
+        double timeWrite = 0.0;
+        double timeWaitOnRead = 0.0;
+        size_t nReadBytes = 0;
+        size_t nWriteBytes = 0;
+        size_t nFailed = 0;
+        size_t maxQueueSize = 0;
+    };
+    Statistics m_Statistics; // merged from all streams under operationsMutex
+
+    /** file descriptors of opened files, under m_FilesMutex */
+    std::mutex m_FilesMutex;
+    std::map<std::string, int> m_ReadFiles;
+    std::map<std::string, int> m_WriteFiles;
+    std::map<std::string, int> m_DirectFiles;
+
+    int GetReadFile(const std::string &path);
+    int GetWriteFile(const std::string &path, bool truncate = true);
+    /** -1 if O_DIRECT is off, not supported or failed to open */
+    int GetDirectFile(const std::string &path);
+    void CloseFile(const std::string &path);
+    void CloseAllFiles();
+    uint64_t GetWriteFileSize(const std::string &path);
+
+    void CopyBlock(const FileDrainOperation &fdo, char *buffer,
+                   Statistics &stats);
+    /** aligned: data is in a buffer usable for O_DIRECT */
+    void WriteBlock(const std::string &path, const char *data, size_t count,
+                    uint64_t offset, bool aligned, Statistics &stats);
+    /** applies an operation other than copy, returns the new write cursor */
+    uint64_t RunOrdered(const FileDrainOperation &fdo, uint64_t writeCursor,
+                        Statistics &stats);
+
+    void DrainThread(); // the thread function
+};
+
+} // end namespace burstbuffer
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTISTREAM_H_ */
@@ -84,6 +84,11 @@ std::string BPSerializer::GetRankProfilingJSON(
         {
             lf_WriterTimer(rankLog, transportTimerPair.second);
         }
+        for (const auto &counterPair : transportsProfilers[t]->m_Counters)
+        {
+            rankLog += ", \"" + counterPair.first +
+                       "\": " + std::to_string(counterPair.second);
+        }
         rankLog += "}";
     }
     rankLog += " }"; // end rank entry
@@ -133,6 +133,34 @@ static FMField MetaArrayRecOperatorMM16List[] = {
     {"MinMax", "char[32][BlockCount]", 1,
      FMOffset(BP5Base::MetaArrayRecOperatorMM *, MinMax)},
     {NULL, NULL, 0, 0}};
+
+#define SUB_BLOCK_FIELD_ENTRIES(Rec)                                           \
+    {"SubBlockInfoCount", "integer", sizeof(size_t),                           \
+     FMOffset(BP5Base::Rec *, SubBlockInfoCount)},                             \
+        {"SubBlockInfo", "integer[SubBlockInfoCount]", sizeof(size_t),         \
+         FMOffset(BP5Base::Rec *, SubBlockInfo)},
+
+static FMField MetaArrayRecOperatorSubList[] = {
+    BASE_FIELD_ENTRIES{
+        "DataBlockSize", "integer[BlockCount]", sizeof(size_t),
+        FMOffset(BP5Base::MetaArrayRecOperatorSub *, DataBlockSize)},
+    SUB_BLOCK_FIELD_ENTRIES(MetaArrayRecOperatorSub){NULL, NULL, 0, 0}};
+
+#define declare_sub_mm_list(N, Bytes)                                          \
+    static FMField MetaArrayRecOperatorSubMM##N##List[] = {                    \
+        BASE_FIELD_ENTRIES{                                                    \
+            "DataBlockSize", "integer[BlockCount]", sizeof(size_t),            \
+            FMOffset(BP5Base::MetaArrayRecOperatorSubMM *, DataBlockSize)},    \
+        {"MinMax", "char[" #Bytes "][BlockCount]", 1,                          \
+         FMOffset(BP5Base::MetaArrayRecOperatorSubMM *, MinMax)},              \
+        SUB_BLOCK_FIELD_ENTRIES(MetaArrayRecOperatorSubMM){NULL, NULL, 0, 0}};
+declare_sub_mm_list(1, 2)
+declare_sub_mm_list(2, 4)
+declare_sub_mm_list(4, 8)
+declare_sub_mm_list(8, 16)
+declare_sub_mm_list(16, 32)
+#undef declare_sub_mm_list
+#undef SUB_BLOCK_FIELD_ENTRIES
 #undef BASE_FIELD_ENTRIES
 
 BP5Base::BP5Base()
@@ -149,6 +177,12 @@ BP5Base::BP5Base()
     MetaArrayRecOperatorMM8ListPtr = &MetaArrayRecOperatorMM8List[0];
     MetaArrayRecMM16ListPtr = &MetaArrayRecMM16List[0];
     MetaArrayRecOperatorMM16ListPtr = &MetaArrayRecOperatorMM16List[0];
+    MetaArrayRecOperatorSubListPtr = &MetaArrayRecOperatorSubList[0];
+    MetaArrayRecOperatorSubMM1ListPtr = &MetaArrayRecOperatorSubMM1List[0];
+    MetaArrayRecOperatorSubMM2ListPtr = &MetaArrayRecOperatorSubMM2List[0];
+    MetaArrayRecOperatorSubMM4ListPtr = &MetaArrayRecOperatorSubMM4List[0];
+    MetaArrayRecOperatorSubMM8ListPtr = &MetaArrayRecOperatorSubMM8List[0];
+    MetaArrayRecOperatorSubMM16ListPtr = &MetaArrayRecOperatorSubMM16List[0];
 }
 }
 }
@@ -71,6 +71,29 @@ public:
         char *MinMax;          // char[TYPESIZE][BlockCount]  varies by type
     } MetaArrayRecOperatorMM;
 
+    /*
+     * Operator records of blocks that may be compressed in sub-blocks along
+     * their slowest dimension. SubBlockInfo holds for every block the number
+     * of sub-blocks n (0 if compressed whole), followed by n triples of start
+     * and count along that dimension and compressed size
+     */
+    typedef struct _MetaArrayRecOperatorSub
+    {
+        BASE_FIELDS
+        size_t *DataBlockSize; // Per-block Lengths [BlockCount]
+        size_t SubBlockInfoCount;
+        size_t *SubBlockInfo; // [SubBlockInfoCount]
+    } MetaArrayRecOperatorSub;
+
+    typedef struct _MetaArrayRecOperatorSubMM
+    {
+        BASE_FIELDS
+        size_t *DataBlockSize; // Per-block Lengths [BlockCount]
+        char *MinMax;          // char[TYPESIZE][BlockCount]  varies by type
+        size_t SubBlockInfoCount;
+        size_t *SubBlockInfo; // [SubBlockInfoCount]
+    } MetaArrayRecOperatorSubMM;
+
 #undef BASE_FIELDS
 
     struct BP5MetadataInfoStruct
@@ -170,6 +193,12 @@ public:
     FMField *MetaArrayRecOperatorMM8ListPtr;
     FMField *MetaArrayRecMM16ListPtr;
     FMField *MetaArrayRecOperatorMM16ListPtr;
+    FMField *MetaArrayRecOperatorSubListPtr;
+    FMField *MetaArrayRecOperatorSubMM1ListPtr;
+    FMField *MetaArrayRecOperatorSubMM2ListPtr;
+    FMField *MetaArrayRecOperatorSubMM4ListPtr;
+    FMField *MetaArrayRecOperatorSubMM8ListPtr;
+    FMField *MetaArrayRecOperatorSubMM16ListPtr;
 };
 } // end namespace format
 } // end namespace adios2
@@ -31,6 +31,7 @@
 
 #include "adios2/operator/OperatorFactory.h"
 
+#include <algorithm>
 #include <array>
 #include <float.h>
 #include <limits.h>
@@ -182,7 +183,7 @@ const char *BP5Deserializer::BreakdownVarName(const char *Name,
 }
 
 void BP5Deserializer::BreakdownFieldType(const char *FieldType, bool &Operator,
-                                         bool &MinMax)
+                                         bool &MinMax, bool &SubBlocks)
 {
     if (FieldType[0] != 'M')
     {
@@ -199,6 +200,11 @@ void BP5Deserializer::BreakdownFieldType(const char *FieldType, bool &Operator,
         Operator = true;
         FieldType += strlen("Op");
     }
+    if (FieldType[0] == 'S')
+    {
+        SubBlocks = true;
+        FieldType += strlen("Sub");
+    }
     if (FieldType[0] == 'M')
     {
         MinMax = true;
@@ -354,6 +360,7 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
             int ElementSize;
             bool Operator = false;
             bool MinMax = false;
+            bool SubBlocks = false;
             bool V1_fields = true;
             FMFormat StructFormat = NULL;
             if (FieldList[i].field_type[0] == 'M')
@@ -365,7 +372,8 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
             }
             else
             {
-                BreakdownFieldType(FieldList[i].field_type, Operator, MinMax);
+                BreakdownFieldType(FieldList[i].field_type, Operator, MinMax,
+                                   SubBlocks);
                 BreakdownArrayName(FieldList[i].field_name, &ArrayName, &Type,
                                    &ElementSize, &StructFormat);
             }
@@ -424,6 +432,10 @@ BP5Deserializer::ControlInfo *BP5Deserializer::BuildControl(FMFormat Format)
                 VarRec->MinMaxOffset = MetaRecFields * sizeof(void *);
                 MetaRecFields++;
             }
+            if (SubBlocks)
+            {
+                VarRec->SubBlockInfoOffset = MetaRecFields * sizeof(void *);
+            }
             if (V1_fields)
             {
                 i += MetaRecFields;
@@ -680,6 +692,12 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
     }
     ControlFields = &Control->Controls[0];
 
+    if (m_MaxMetadataSteps && m_MetadataSteps[Step].Evicted)
+    {
+        ReinstallMetaData(BaseData, Control, WriterRank, Step);
+        return;
+    }
+
     if (m_RandomAccessMode)
     {
         if (m_ControlArray.size() < Step + 1)
@@ -826,6 +844,10 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             {
                 // use the shape from rank 0 (or first non-NULL)
                 VarRec->GlobalDims = meta_base->Shape;
+                if (m_MaxMetadataSteps)
+                {
+                    PinGlobalDims(VarRec, Step);
+                }
             }
             if (ControlFields[i].OrigShapeID == ShapeID::JoinedArray)
             {
@@ -852,6 +874,11 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
                         VarRec->LastJoinedShape = VarRec->GlobalDims;
                         // overwrite the JoinedDimen value in that entry
                         VarRec->LastJoinedShape[VarRec->JoinedDimen] = 0;
+                        if (m_MaxMetadataSteps)
+                        {
+                            // the total is kept in that step for good
+                            m_MetadataSteps[VarRec->GlobalDimsStep].Pins++;
+                        }
                     }
                     VarRec->LastJoinedShape[VarRec->JoinedDimen] +=
                         meta_base->Count[(b * meta_base->Dims) +
@@ -971,6 +998,165 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
     }
 }
 
+void BP5Deserializer::ReinstallMetaData(void *BaseData, ControlInfo *Control,
+                                        size_t WriterRank, size_t Step)
+{
+    /* Variables, their steps and the joined offsets were set up when the
+     * step was installed first, only point into the new copy of the
+     * metadata and redo what the decoding left undone */
+    (*MetadataBaseArray[Step])[WriterRank] = BaseData;
+    size_t *JoinedDimenOffsetArray =
+        (size_t *)(*JoinedDimArray[Step])[WriterRank];
+    size_t CurJoinedDimenOffset = 0;
+    for (int i = 0; i < Control->ControlCount; i++)
+    {
+        struct ControlStruct *ControlField = &Control->Controls[i];
+        if (!BP5BitfieldTest((BP5MetadataInfoStruct *)BaseData, i))
+        {
+            continue;
+        }
+        if ((ControlField->OrigShapeID != ShapeID::GlobalArray) &&
+            (ControlField->OrigShapeID != ShapeID::LocalArray) &&
+            (ControlField->OrigShapeID != ShapeID::JoinedArray))
+        {
+            continue;
+        }
+        MetaArrayRec *meta_base =
+            (MetaArrayRec *)((char *)BaseData + ControlField->FieldOffset);
+        size_t BlockCount =
+            meta_base->Dims ? meta_base->DBCount / meta_base->Dims : 1;
+        if ((meta_base->Dims > 1) && (m_WriterIsRowMajor != m_ReaderIsRowMajor))
+        {
+            ReverseDimensions(meta_base->Count, meta_base->Dims, BlockCount);
+            if ((ControlField->OrigShapeID == ShapeID::GlobalArray) ||
+                (ControlField->OrigShapeID == ShapeID::JoinedArray))
+            {
+                ReverseDimensions(meta_base->Shape, meta_base->Dims, 1);
+                if (ControlField->OrigShapeID == ShapeID::GlobalArray)
+                {
+                    ReverseDimensions(meta_base->Offsets, meta_base->Dims,
+                                      BlockCount);
+                }
+            }
+        }
+        if (ControlField->OrigShapeID == ShapeID::JoinedArray)
+        {
+            meta_base->Offsets = &JoinedDimenOffsetArray[CurJoinedDimenOffset];
+            CurJoinedDimenOffset += meta_base->DBCount;
+        }
+    }
+}
+
+void BP5Deserializer::SetMaxMetadataSteps(
+    size_t MaxSteps, std::function<void(size_t)> LoadMetadataStep)
+{
+    m_MaxMetadataSteps = MaxSteps;
+    m_LoadMetadataStep = LoadMetadataStep;
+}
+
+std::vector<char> &BP5Deserializer::MetadataStepBuffer(size_t Step)
+{
+    if (m_MetadataSteps.size() < Step + 1)
+    {
+        m_MetadataSteps.resize(Step + 1);
+    }
+    if (!m_HoldMetadataSteps)
+    {
+        EvictMetadataSteps(m_MaxMetadataSteps - 1);
+    }
+    m_InstalledSteps.push_back(Step);
+    m_MetadataSteps[Step].LastUse = ++m_MetadataUseCount;
+    return m_MetadataSteps[Step].Buffer;
+}
+
+void BP5Deserializer::HoldMetadataSteps(bool Hold)
+{
+    std::lock_guard<std::mutex> lock(m_MetadataStepsMutex);
+    m_HoldMetadataSteps = Hold;
+    if (!Hold)
+    {
+        EvictMetadataSteps(m_MaxMetadataSteps);
+    }
+}
+
+void BP5Deserializer::EvictMetadataSteps(size_t MaxSteps)
+{
+    while (m_InstalledSteps.size() > MaxSteps)
+    {
+        // least recently used step that no VarRec points into
+        size_t Victim = SIZE_MAX;
+        for (size_t i = 0; i < m_InstalledSteps.size(); i++)
+        {
+            const MetadataStepRec &Rec = m_MetadataSteps[m_InstalledSteps[i]];
+            if (!Rec.Pins && ((Victim == SIZE_MAX) ||
+                              (Rec.LastUse <
+                               m_MetadataSteps[m_InstalledSteps[Victim]]
+                                   .LastUse)))
+            {
+                Victim = i;
+            }
+        }
+        if (Victim == SIZE_MAX)
+        {
+            return;
+        }
+        EvictMetadataStep(m_InstalledSteps[Victim]);
+        m_InstalledSteps[Victim] = m_InstalledSteps.back();
+        m_InstalledSteps.pop_back();
+    }
+}
+
+void BP5Deserializer::EvictMetadataStep(size_t Step)
+{
+    MetadataStepRec &Rec = m_MetadataSteps[Step];
+    const char *BufferStart = Rec.Buffer.data();
+    const char *BufferEnd = BufferStart + Rec.Buffer.size();
+    for (auto &BaseData : *MetadataBaseArray[Step])
+    {
+        if ((BaseData < (void *)BufferStart) || (BaseData >= (void *)BufferEnd))
+        {
+            // decoded out of place
+            free(BaseData);
+        }
+        BaseData = nullptr;
+    }
+    std::vector<char>().swap(Rec.Buffer);
+    Rec.Evicted = true;
+}
+
+void BP5Deserializer::PinGlobalDims(BP5VarRec *VarRec, size_t Step)
+{
+    if (VarRec->GlobalDimsStep == Step)
+    {
+        return;
+    }
+    if (VarRec->GlobalDimsStep != SIZE_MAX)
+    {
+        m_MetadataSteps[VarRec->GlobalDimsStep].Pins--;
+    }
+    VarRec->GlobalDimsStep = SIZE_MAX;
+    if (VarRec->GlobalDims)
+    {
+        m_MetadataSteps[Step].Pins++;
+        VarRec->GlobalDimsStep = Step;
+    }
+}
+
+void *BP5Deserializer::WriterMetadataBase(size_t Step, size_t WriterRank) const
+{
+    if (m_MaxMetadataSteps)
+    {
+        std::lock_guard<std::mutex> lock(m_MetadataStepsMutex);
+        if (m_MetadataSteps[Step].Evicted)
+        {
+            m_LoadMetadataStep(Step);
+            m_MetadataSteps[Step].Evicted = false;
+        }
+        m_MetadataSteps[Step].LastUse = ++m_MetadataUseCount;
+    }
+    return (*MetadataBaseArray[Step])[WriterRank];
+}
+
 void BP5Deserializer::InstallAttributeData(void *AttributeBlock,
                                            size_t BlockLen, size_t Step)
 {
@@ -1511,6 +1697,102 @@ bool BP5Deserializer::IsContiguousTransfer(BP5ArrayRequest *Req,
     return (Req->VarRec->DimCount == 1);
 }
 
+/*
+ * Reads of a compressed block.  A block the writer split into sub-blocks
+ * (see MetaArrayRecOperatorSub) yields one read for each sub-block the
+ * request touches, otherwise the whole block is needed for decompression
+ */
+void BP5Deserializer::GenerateCompressedReadRequests(
+    BP5ArrayRequest *Req, size_t ReqIndex, size_t WriterRank, size_t Block,
+    const bool doAllocTempBuffers, size_t *maxReadSize,
+    std::vector<ReadRequest> &Ret)
+{
+    MetaArrayRecOperator *writer_meta_base =
+        (MetaArrayRecOperator *)GetMetadataBase(Req->VarRec, Req->Step,
+                                                WriterRank);
+
+    auto lf_AddRead = [&](size_t StartOffset, size_t ReadLength,
+                          size_t SubBlockStart, size_t SubBlockCount) {
+        ReadRequest RR;
+        RR.Timestep = Req->Step;
+        RR.WriterRank = WriterRank;
+        RR.StartOffset = StartOffset;
+        RR.ReadLength = ReadLength;
+        RR.DestinationAddr = nullptr;
+        if (doAllocTempBuffers)
+        {
+            RR.DestinationAddr = (char *)malloc(RR.ReadLength);
+        }
+        *maxReadSize =
+            (*maxReadSize < RR.ReadLength ? RR.ReadLength : *maxReadSize);
+        RR.DirectToAppMemory = false;
+        RR.ReqIndex = ReqIndex;
+        RR.BlockID = Block;
+        RR.OffsetInBlock = 0;
+        RR.SubBlockStart = SubBlockStart;
+        RR.SubBlockCount = SubBlockCount;
+        Ret.push_back(RR);
+    };
+
+    size_t *SubBlockInfo = NULL;
+    size_t InfoIndex = 0;
+    if (Req->VarRec->SubBlockInfoOffset != SIZE_MAX)
+    {
+        char *InfoBase =
+            (char *)writer_meta_base + Req->VarRec->SubBlockInfoOffset;
+        const size_t InfoCount = *(size_t *)InfoBase;
+        SubBlockInfo = *(size_t **)(InfoBase + sizeof(size_t));
+        // runs of earlier blocks
+        for (size_t b = 0; (b < Block) && (InfoIndex < InfoCount); b++)
+        {
+            InfoIndex += 1 + 3 * SubBlockInfo[InfoIndex];
+        }
+        if ((InfoIndex >= InfoCount) || (SubBlockInfo[InfoIndex] == 0))
+        {
+            SubBlockInfo = NULL;
+        }
+    }
+    if (!SubBlockInfo)
+    {
+        lf_AddRead(writer_meta_base->DataBlockLocation[Block],
+                   writer_meta_base->DataBlockSize[Block], 0, 0);
+        return;
+    }
+
+    /* the writer split its slowest dimension, which is our last one if the
+     * dimensions were reversed at install */
+    const size_t DimCount = Req->VarRec->DimCount;
+    const size_t SplitDim =
+        ((DimCount > 1) && (m_WriterIsRowMajor != m_ReaderIsRowMajor))
+            ? DimCount - 1
+            : 0;
+    size_t SelStart = 0;
+    size_t SelEnd = SIZE_MAX;
+    if (Req->Start.size() && Req->Count.size())
+    {
+        SelStart = Req->Start[SplitDim];
+        SelEnd = SelStart + Req->Count[SplitDim];
+    }
+    size_t BlockStart = 0;
+    if (Req->RequestType == Global)
+    {
+        BlockStart = writer_meta_base->Offsets[Block * DimCount + SplitDim];
+    }
+
+    size_t Location = writer_meta_base->DataBlockLocation[Block];
+    const size_t SubBlockCount = SubBlockInfo[InfoIndex];
+    for (size_t i = 0; i < SubBlockCount; i++)
+    {
+        const size_t *Triple = &SubBlockInfo[InfoIndex + 1 + 3 * i];
+        if ((BlockStart + Triple[0] < SelEnd) &&
+            (BlockStart + Triple[0] + Triple[1] > SelStart))
+        {
+            lf_AddRead(Location, Triple[2], Triple[0], Triple[1]);
+        }
+        Location += Triple[2];
+    }
+}
+
 std::vector<BP5Deserializer::ReadRequest>
 BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                                       size_t *maxReadSize)
@@ -1543,6 +1825,13 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                 {
                     // block is here
                     size_t NeededBlock = Req->BlockID - NodeFirstBlock;
+                    if (Req->VarRec->Operator != NULL)
+                    {
+                        GenerateCompressedReadRequests(
+                            Req, ReqIndex, WriterRank, NeededBlock,
+                            doAllocTempBuffers, maxReadSize, Ret);
+                        break;
+                    }
                     size_t StartDim = NeededBlock * Req->VarRec->DimCount;
                     ReadRequest RR;
                     RR.Timestep = Req->Step;
@@ -1625,28 +1914,9 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                     {
                         if (Req->VarRec->Operator != NULL)
                         {
-                            // need the whole thing for decompression anyway
-                            ReadRequest RR;
-                            RR.Timestep = Req->Step;
-                            RR.WriterRank = WriterRank;
-                            RR.StartOffset =
-                                writer_meta_base->DataBlockLocation[Block];
-                            RR.ReadLength =
-                                writer_meta_base->DataBlockSize[Block];
-                            RR.DestinationAddr = nullptr;
-                            if (doAllocTempBuffers)
-                            {
-                                RR.DestinationAddr =
-                                    (char *)malloc(RR.ReadLength);
-                            }
-                            *maxReadSize =
-                                (*maxReadSize < RR.ReadLength ? RR.ReadLength
-                                                              : *maxReadSize);
-                            RR.DirectToAppMemory = false;
-                            RR.ReqIndex = ReqIndex;
-                            RR.BlockID = Block;
-                            RR.OffsetInBlock = 0;
-                            Ret.push_back(RR);
+                            GenerateCompressedReadRequests(
+                                Req, ReqIndex, WriterRank, Block,
+                                doAllocTempBuffers, maxReadSize, Ret);
                         }
                         else
                         {
@@ -1734,7 +2004,8 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
     return Ret;
 }
 
-void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
+void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr,
+                                  const unsigned int threads)
 {
     auto Req = PendingRequests[Read.ReqIndex];
 
@@ -1767,12 +2038,22 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
                 writer_meta_base
                     ->Count[dim + Read.BlockID * writer_meta_base->Dims];
         }
+        size_t CompressedSize = ((MetaArrayRecOperator *)writer_meta_base)
+                                    ->DataBlockSize[Read.BlockID];
+        if (Read.SubBlockCount)
+        {
+            // only some rows of the writer's slowest dimension
+            const size_t SplitDimCount =
+                (m_WriterIsRowMajor == m_ReaderIsRowMajor)
+                    ? RankSize[0]
+                    : RankSize[DimCount - 1];
+            DestSize = DestSize / SplitDimCount * Read.SubBlockCount;
+            CompressedSize = Read.ReadLength;
+        }
         decompressBuffer.resize(DestSize);
         {
             std::lock_guard<std::mutex> lockGuard(mutexDecompress);
-            core::Decompress(IncomingData,
-                             ((MetaArrayRecOperator *)writer_meta_base)
-                                 ->DataBlockSize[Read.BlockID],
+            core::Decompress(IncomingData, CompressedSize,
                              decompressBuffer.data());
         }
         IncomingData = decompressBuffer.data();
@@ -1815,17 +2096,66 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
         std::reverse(outStart.begin(), outStart.end());
         std::reverse(outCount.begin(), outCount.end());
     }
+    if (Read.SubBlockCount)
+    {
+        // a sub-block covers rows of the writer's slowest dimension
+        inStart[0] += Read.SubBlockStart;
+        inCount[0] = Read.SubBlockCount;
+    }
 
-    helper::NdCopy(VirtualIncomingData, inStart, inCount, true, true,
-                   (char *)Req.Data, outStart, outCount, true, true,
-                   ElementSize, CoreDims(), CoreDims(), CoreDims(), CoreDims(),
-                   false, Req.MemSpace);
+    if (Req.MemSpace == MemorySpace::Host)
+    {
+        const helper::NdCopyPlan &Plan =
+            GetCopyPlan(inStart, inCount, outStart, outCount, ElementSize);
+        helper::NdCopyExecutePlan(Plan, VirtualIncomingData,
+                                  (char *)Req.Data, threads);
+    }
+    else
+    {
+        helper::NdCopy(VirtualIncomingData, inStart, inCount, true, true,
+                       (char *)Req.Data, outStart, outCount, true, true,
+                       ElementSize, CoreDims(), CoreDims(), CoreDims(),
+                       CoreDims(), false, Req.MemSpace);
+    }
     if (freeAddr)
     {
         free((char *)Read.DestinationAddr);
     }
 }
 
+const helper::NdCopyPlan &BP5Deserializer::GetCopyPlan(
+    const CoreDims &inStart, const CoreDims &inCount,
+    const CoreDims &outStart, const CoreDims &outCount, size_t ElementSize)
+{
+    std::vector<size_t> Key;
+    Key.reserve(1 + 4 * inCount.size());
+    Key.push_back(ElementSize);
+    for (const CoreDims *Array : {&inStart, &inCount, &outStart, &outCount})
+    {
+        Key.insert(Key.end(), Array->begin(), Array->end());
+    }
+
+    {
+        std::lock_guard<std::mutex> lockGuard(m_CopyPlansMutex);
+        auto it = m_CopyPlans.find(Key);
+        if (it != m_CopyPlans.end())
+        {
+            it->second.LastUse = m_CopyPlanRound;
+            return it->second.Plan;
+        }
+    }
+
+    // FinalizeGet() runs in several threads, plan outside of the lock
+    CopyPlanRec Rec;
+    Rec.Plan = helper::NdCopyMakePlan(inStart, inCount, outStart, outCount,
+                                      ElementSize);
+    std::lock_guard<std::mutex> lockGuard(m_CopyPlansMutex);
+    Rec.LastUse = m_CopyPlanRound;
+    // another thread may have planned the same copy meanwhile
+    return m_CopyPlans.emplace(std::move(Key), std::move(Rec))
+        .first->second.Plan;
+}
+
 void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> &Reads)
 {
     for (const auto &Read : Reads)
@@ -1833,6 +2163,30 @@ void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> &Reads)
         FinalizeGet(Read, true);
     }
     PendingRequests.clear();
+
+    /* No FinalizeGet() runs now. Keep at most MaxCopyPlans plans, dropping
+       the least recently used first */
+    constexpr size_t MaxCopyPlans = 16 * 1024;
+    if (m_CopyPlans.size() > MaxCopyPlans)
+    {
+        using PlanIter = decltype(m_CopyPlans)::iterator;
+        std::vector<PlanIter> ByUse;
+        ByUse.reserve(m_CopyPlans.size());
+        for (auto it = m_CopyPlans.begin(); it != m_CopyPlans.end(); ++it)
+        {
+            ByUse.push_back(it);
+        }
+        const size_t NumDrop = m_CopyPlans.size() - MaxCopyPlans;
+        std::nth_element(ByUse.begin(), ByUse.begin() + NumDrop, ByUse.end(),
+                         [](const PlanIter &a, const PlanIter &b) {
+                             return a->second.LastUse < b->second.LastUse;
+                         });
+        for (size_t i = 0; i < NumDrop; ++i)
+        {
+            m_CopyPlans.erase(ByUse[i]);
+        }
+    }
+    ++m_CopyPlanRound;
 }
 
 void BP5Deserializer::MapGlobalToLocalIndex(size_t Dims,
@@ -1925,6 +2279,10 @@ BP5Deserializer::~BP5Deserializer()
     }
     if (m_FreeableMBA)
         delete m_FreeableMBA;
+    for (auto Step : m_InstalledSteps)
+    {
+        EvictMetadataStep(Step);
+    }
     for (auto &step : MetadataBaseArray)
     {
         delete step;
@@ -1952,7 +2310,7 @@ void *BP5Deserializer::GetMetadataBase(BP5VarRec *VarRec, size_t Step,
         }
         size_t CI_VarIndex = (*CI->CIVarIndex)[VarRec->VarNum];
         BP5MetadataInfoStruct *BaseData =
-            (BP5MetadataInfoStruct *)(*MetadataBaseArray[Step])[WriterRank];
+            (BP5MetadataInfoStruct *)WriterMetadataBase(Step, WriterRank);
         if (!BP5BitfieldTest(BaseData, CI_VarIndex))
         {
             // Var appears in CI, but wasn't written on this step
@@ -1960,8 +2318,7 @@ void *BP5Deserializer::GetMetadataBase(BP5VarRec *VarRec, size_t Step,
         }
         size_t MetadataFieldOffset = (*CI->MetaFieldOffset)[VarRec->VarNum];
         writer_meta_base =
-            (MetaArrayRec *)(((char *)(*MetadataBaseArray[Step])[WriterRank]) +
-                             MetadataFieldOffset);
+            (MetaArrayRec *)(((char *)BaseData) + MetadataFieldOffset);
     }
     else
     {
@@ -2205,8 +2562,8 @@ size_t BP5Deserializer::RelativeToAbsoluteStep(const BP5VarRec *VarRec,
         while (WriterRank < writerCohortSize)
         {
             BP5MetadataInfoStruct *BaseData;
-            BaseData = (BP5MetadataInfoStruct
-                            *)(*MetadataBaseArray[AbsStep])[WriterRank];
+            BaseData = (BP5MetadataInfoStruct *)WriterMetadataBase(
+                AbsStep, WriterRank);
             if (BP5BitfieldTest((BP5MetadataInfoStruct *)BaseData,
                                 VarRec->VarNum))
             {
@@ -12,12 +12,15 @@
 #include "adios2/core/Attribute.h"
 #include "adios2/core/IO.h"
 #include "adios2/core/Variable.h"
+#include "adios2/helper/adiosMemory.h"
 
 #include "BP5Base.h"
 #include "atl.h"
 #include "ffs.h"
 #include "fm.h"
 
+#include <functional>
+#include <map>
 #include <mutex>
 
 #ifdef _WIN32
@@ -51,6 +54,10 @@ public:
         size_t ReqIndex;
         size_t OffsetInBlock;
         size_t BlockID;
+        /* rows of the slowest dimension in a compressed sub-block, 0 when
+         * the request covers the whole block */
+        size_t SubBlockStart = 0;
+        size_t SubBlockCount = 0;
     };
     void InstallMetaMetaData(MetaMetaInfoBlock &MMList);
     void InstallMetaData(void *MetadataBlock, size_t BlockLen,
@@ -78,7 +85,9 @@ public:
      */
     std::vector<ReadRequest> GenerateReadRequests(const bool doAllocTempBuffers,
                                                   size_t *maxReadSize);
-    void FinalizeGet(const ReadRequest &, const bool freeAddr);
+    /* threads: how many threads the copy into user memory may use */
+    void FinalizeGet(const ReadRequest &, const bool freeAddr,
+                     const unsigned int threads = 1);
     void FinalizeGets(std::vector<ReadRequest> &);
 
     MinVarInfo *AllRelativeStepsMinBlocksInfo(const VariableBase &var);
@@ -90,6 +99,18 @@ public:
     void GetAbsoluteSteps(const VariableBase &variable,
                           std::vector<size_t> &keys) const;
 
+    /* In random access mode, keep the metadata of at most MaxSteps steps
+     * installed, least recently used steps are evicted. LoadMetadataStep
+     * installs an evicted step again when it is needed. */
+    void SetMaxMetadataSteps(size_t MaxSteps,
+                             std::function<void(size_t)> LoadMetadataStep);
+    /* The buffer to read the raw metadata of Step into before installing
+     * it, owned by the deserializer until the step is evicted */
+    std::vector<char> &MetadataStepBuffer(size_t Step);
+    /* No step is evicted while held, FinalizeGet() runs in several threads
+     * on the metadata of the steps GenerateReadRequests() installed */
+    void HoldMetadataSteps(bool Hold);
+
     const bool m_WriterIsRowMajor;
     const bool m_ReaderIsRowMajor;
     core::Engine *m_Engine = NULL;
@@ -112,7 +133,9 @@ private:
         DataType Type;
         int ElementSize = 0;
         size_t MinMaxOffset = SIZE_MAX;
+        size_t SubBlockInfoOffset = SIZE_MAX;
         size_t *GlobalDims = NULL;
+        size_t GlobalDimsStep = SIZE_MAX; // step GlobalDims points into
         size_t LastTSAdded = SIZE_MAX;
         size_t FirstTSSeen = SIZE_MAX;
         size_t LastStepAdded = SIZE_MAX;
@@ -185,6 +208,48 @@ private:
     // address of the joined dim arrays
     std::vector<std::vector<void *> *> JoinedDimArray;
 
+    struct MetadataStepRec
+    {
+        std::vector<char> Buffer; // raw metadata, decoded in place
+        size_t LastUse = 0;
+        size_t Pins = 0; // VarRec pointers into the metadata of the step
+        bool Evicted = false;
+    };
+    // for random access mode with a limit on installed steps, per timestep
+    size_t m_MaxMetadataSteps = 0;
+    std::function<void(size_t)> m_LoadMetadataStep;
+    bool m_HoldMetadataSteps = false;
+    mutable std::vector<MetadataStepRec> m_MetadataSteps;
+    mutable std::vector<size_t> m_InstalledSteps;
+    mutable size_t m_MetadataUseCount = 0;
+    mutable std::mutex m_MetadataStepsMutex;
+    // base address of the metadata of a writer, installs it if evicted
+    void *WriterMetadataBase(size_t Step, size_t WriterRank) const;
+    void ReinstallMetaData(void *BaseData, ControlInfo *Control,
+                           size_t WriterRank, size_t Step);
+    void EvictMetadataSteps(size_t MaxSteps);
+    void EvictMetadataStep(size_t Step);
+    void PinGlobalDims(BP5VarRec *VarRec, size_t Step);
+
+    struct CopyPlanRec
+    {
+        helper::NdCopyPlan Plan;
+        size_t LastUse = 0; // FinalizeGets() round of the last use
+    };
+    /* The runs of the copies from the writer blocks into user memory, by
+     * element size and input and output boxes. The geometry of the reads
+     * usually repeats from step to step. A plan is a few numbers per
+     * dimension, FinalizeGets() drops the least recently used plans beyond
+     * a limit on their number. */
+    std::map<std::vector<size_t>, CopyPlanRec> m_CopyPlans;
+    size_t m_CopyPlanRound = 0;
+    std::mutex m_CopyPlansMutex;
+    const helper::NdCopyPlan &GetCopyPlan(const helper::CoreDims &inStart,
+                                          const helper::CoreDims &inCount,
+                                          const helper::CoreDims &outStart,
+                                          const helper::CoreDims &outCount,
+                                          size_t ElementSize);
+
     ControlInfo *ControlBlocks = nullptr;
     ControlInfo *GetPriorControl(FMFormat Format);
     ControlInfo *BuildControl(FMFormat Format);
@@ -198,7 +263,7 @@ private:
     const char *BreakdownVarName(const char *Name, DataType *type_p,
                                  int *element_size_p);
     void BreakdownFieldType(const char *FieldType, bool &Operator,
-                            bool &MinMax);
+                            bool &MinMax, bool &SubBlocks);
     void BreakdownArrayName(const char *Name, char **base_name_p,
                             DataType *type_p, int *element_size_p,
                             FMFormat *Format);
@@ -244,6 +309,11 @@ private:
                           size_t WriterRank) const;
     bool IsContiguousTransfer(BP5ArrayRequest *Req, size_t *offsets,
                               size_t *count);
+    void GenerateCompressedReadRequests(BP5ArrayRequest *Req, size_t ReqIndex,
+                                        size_t WriterRank, size_t Block,
+                                        const bool doAllocTempBuffers,
+                                        size_t *maxReadSize,
+                                        std::vector<ReadRequest> &Ret);
 
     size_t CurTimestep = 0;
 
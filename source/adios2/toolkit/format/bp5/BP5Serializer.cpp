@@ -416,6 +416,7 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
     Rec->DimCount = DimCount;
     Rec->Type = (int)Type;
     Rec->OperatorType = NULL;
+    Rec->SubBlockInfoOffset = (size_t)-1;
     char *TextStructID = NULL;
     if (Type == DataType::Struct)
     {
@@ -493,7 +494,14 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
 
         const char *ArrayTypeName = "MetaArray";
         int FieldSize = sizeof(MetaArrayRec);
-        if (VB->m_Operations.size())
+        const bool SubBlocks =
+            VB->m_Operations.size() && (m_CompressionSubBlockSize > 0);
+        if (SubBlocks)
+        {
+            ArrayTypeName = "MetaArrayOpSub";
+            FieldSize = sizeof(MetaArrayRecOperator);
+        }
+        else if (VB->m_Operations.size())
         {
             ArrayTypeName = "MetaArrayOp";
             FieldSize = sizeof(MetaArrayRecOperator);
@@ -522,11 +530,22 @@ BP5Serializer::CreateWriterRec(void *Variable, const char *Name, DataType Type,
             }
             Rec->MinMaxOffset = FieldSize;
             FieldSize += sizeof(char *);
+            if (SubBlocks)
+            {
+                // after MinMax, where older readers do not look
+                Rec->SubBlockInfoOffset = FieldSize;
+                FieldSize += 2 * sizeof(size_t);
+            }
             AddSimpleField(&Info.MetaFields, &Info.MetaFieldCount, LongName,
                            MMArrayName, FieldSize);
         }
         else
         {
+            if (SubBlocks)
+            {
+                Rec->SubBlockInfoOffset = FieldSize;
+                FieldSize += 2 * sizeof(size_t);
+            }
             AddSimpleField(&Info.MetaFields, &Info.MetaFieldCount, LongName,
                            ArrayTypeName, FieldSize);
         }
@@ -577,6 +596,7 @@ void BP5Serializer::PerformPuts(bool forceCopyDeferred)
 
 void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
 {
+    CollectDeferredCompressions();
     for (auto &Def : DeferredExterns)
     {
         MetaArrayRec *MetaEntry =
@@ -590,8 +610,169 @@ void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
     DeferredExterns.clear();
 }
 
+/*
+ * Operators whose libraries keep no global state, so that several blocks can
+ * be compressed at once. The others still compress in the background, one
+ * block at a time
+ */
+static bool OperatorIsReentrant(const std::string &Method)
+{
+    return (Method == "zfp") || (Method == "bzip2") || (Method == "png") ||
+           (Method == "null");
+}
+
+std::vector<Box<Dims>>
+BP5Serializer::CompressionSubBlocks(const Dims &Count, size_t ElemSize) const
+{
+    std::vector<Box<Dims>> SubBlocks;
+    const size_t ElemCount = helper::GetTotalSize(Count);
+    if (!m_CompressionSubBlockSize || Count.empty() ||
+        (ElemCount * ElemSize <= m_CompressionSubBlockSize))
+    {
+        return SubBlocks;
+    }
+
+    /*
+     * No more sub-blocks than rows of the slowest dimension, so DivideBlock
+     * splits only that one and every sub-block is contiguous in memory
+     */
+    size_t SubBlockElems =
+        std::max<size_t>(m_CompressionSubBlockSize / ElemSize, 1);
+    SubBlockElems =
+        std::max<size_t>(SubBlockElems, (ElemCount + Count[0] - 1) / Count[0]);
+    SubBlockElems = std::max<size_t>(SubBlockElems, (ElemCount + 4095) / 4096);
+    helper::BlockDivisionInfo Info = helper::DivideBlock(
+        Count, SubBlockElems, helper::BlockDivisionMethod::Contiguous);
+    if (Info.NBlocks < 2)
+    {
+        return SubBlocks;
+    }
+    for (unsigned int b = 0; b < Info.NBlocks; ++b)
+    {
+        SubBlocks.push_back(helper::GetSubBlock(Count, Info, b));
+    }
+    return SubBlocks;
+}
+
+std::vector<std::shared_future<size_t>> BP5Serializer::StartCompression(
+    std::shared_ptr<core::Operator> Op, const std::string &Method,
+    const char *Data, const Dims &Offsets, const Dims &Count,
+    const DataType Type, size_t ElemSize,
+    const std::vector<Box<Dims>> &SubBlocks, char *Out,
+    const std::vector<size_t> &OutOffsets)
+{
+    const bool Reentrant = OperatorIsReentrant(Method);
+    auto lf_Compress = [this, Op, Type, Reentrant](const char *In,
+                                                   const Dims SubOffsets,
+                                                   const Dims SubCount,
+                                                   char *SubOut) {
+        std::unique_lock<std::mutex> lock(m_OperatorMutex, std::defer_lock);
+        if (!Reentrant)
+        {
+            lock.lock();
+        }
+        return Op->Operate(In, SubOffsets, SubCount, Type, SubOut);
+    };
+
+    auto lf_Start = [&](const char *In, const Dims &SubOffsets,
+                        const Dims &SubCount, char *SubOut) {
+        // keep at most m_CompressionThreads compressions running
+        while (m_RunningCompressions.size() >= m_CompressionThreads)
+        {
+            m_RunningCompressions.front().wait();
+            m_RunningCompressions.pop_front();
+        }
+        std::shared_future<size_t> Size =
+            std::async(std::launch::async, lf_Compress, In, SubOffsets,
+                       SubCount, SubOut)
+                .share();
+        m_RunningCompressions.push_back(Size);
+        return Size;
+    };
+
+    std::vector<std::shared_future<size_t>> Sizes;
+    if (SubBlocks.empty())
+    {
+        Sizes.push_back(lf_Start(Data, Offsets, Count, Out));
+        return Sizes;
+    }
+
+    const size_t RowSize =
+        ElemSize * helper::GetTotalSize(Count) / std::max<size_t>(Count[0], 1);
+    for (size_t i = 0; i < SubBlocks.size(); ++i)
+    {
+        const Box<Dims> &SubBlock = SubBlocks[i];
+        Dims SubOffsets = Offsets;
+        for (size_t d = 0; d < SubOffsets.size() && d < Count.size(); ++d)
+        {
+            SubOffsets[d] += SubBlock.first[d];
+        }
+        Sizes.push_back(lf_Start(Data + SubBlock.first[0] * RowSize,
+                                 SubOffsets, SubBlock.second,
+                                 Out + OutOffsets[i]));
+    }
+    return Sizes;
+}
+
+/*
+ * Waits for the compressions of one block and moves their output together
+ * at the start of Out. Stores each size in SubBlockSizes (stride 3, see
+ * MetaArrayRecOperatorSub) unless it is NULL. Returns the total size
+ */
+static size_t CompactCompressedBlock(
+    char *Out, const std::vector<size_t> &OutOffsets,
+    const std::vector<std::shared_future<size_t>> &Sizes,
+    size_t *SubBlockSizes)
+{
+    size_t Total = 0;
+    for (size_t i = 0; i < Sizes.size(); ++i)
+    {
+        // rethrows what the operator threw
+        const size_t Size = Sizes[i].get();
+        if (OutOffsets[i] != Total)
+        {
+            memmove(Out + Total, Out + OutOffsets[i], Size);
+        }
+        if (SubBlockSizes)
+        {
+            SubBlockSizes[3 * i] = Size;
+        }
+        Total += Size;
+    }
+    return Total;
+}
+
+void BP5Serializer::CollectDeferredCompressions()
+{
+    std::vector<DeferredCompression> Pending;
+    Pending.swap(DeferredCompressions);
+    for (auto &Def : Pending)
+    {
+        MetaArrayRecOperator *OpEntry =
+            (MetaArrayRecOperator *)((char *)(MetadataBuf) + Def.MetaOffset);
+        size_t *SubBlockSizes = NULL;
+        if (Def.SubBlockInfoIndex != (size_t)-1)
+        {
+            size_t *SubBlockInfo = *(size_t **)((char *)OpEntry +
+                                                Def.SubBlockInfoOffset +
+                                                sizeof(size_t));
+            SubBlockSizes = SubBlockInfo + Def.SubBlockInfoIndex + 2;
+        }
+        const size_t CompressedSize =
+            CompactCompressedBlock(Def.Buffer.data(), Def.OutOffsets,
+                                   Def.CompressedSizes, SubBlockSizes);
+        OpEntry->DataBlockLocation[Def.BlockID] =
+            m_PriorDataBufferSizeTotal +
+            CurDataBuffer->AddToVec(CompressedSize, Def.Buffer.data(),
+                                    Def.AlignReq, true);
+        OpEntry->DataBlockSize[Def.BlockID] = CompressedSize;
+    }
+    m_RunningCompressions.clear();
+}
+
 static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type,
-                      MinMaxStruct &MinMax, MemorySpace MemSpace)
+                      MinMaxStruct &MinMax, MemorySpace MemSpace,
+                      const unsigned int Threads)
 {
     MinMax.Init(Type);
     if (ElemCount == 0)
@@ -615,11 +796,41 @@ static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type,
     else if (Type == helper::GetDataType<T>())                                 \
     {                                                                          \
         const T *values = (const T *)Data;                                     \
-        auto res = std::minmax_element(values, values + ElemCount);            \
-        MinMax.MinUnion.field_##N = *res.first;                                \
-        MinMax.MaxUnion.field_##N = *res.second;                               \
+        helper::GetMinMaxThreads(values, ElemCount, MinMax.MinUnion.field_##N, \
+                                 MinMax.MaxUnion.field_##N, Threads);          \
+    }
+    ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+}
+
+/*
+ * Copies a host block into the data buffer, getting min/max on the way so
+ * the user data is swept only once
+ */
+static void CopyMinMax(char *Dest, const void *Data, size_t ElemCount,
+                       size_t ElemSize, const DataType Type,
+                       MinMaxStruct &MinMax, const unsigned int Threads)
+{
+    MinMax.Init(Type);
+    if (ElemCount == 0)
+        return;
+    if (Type == DataType::Struct)
+    {
+        memcpy(Dest, Data, ElemCount * ElemSize);
+    }
+#define pertype(T, N)                                                          \
+    else if (Type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        const T *values = (const T *)Data;                                     \
+        helper::CopyMinMax(values, ElemCount, Dest, MinMax.MinUnion.field_##N, \
+                           MinMax.MaxUnion.field_##N, Threads);                \
     }
     ADIOS2_FOREACH_MINMAX_STDTYPE_2ARGS(pertype)
+#undef pertype
+    else
+    {
+        memcpy(Dest, Data, ElemCount * ElemSize);
+    }
 }
 
 void BP5Serializer::Marshal(void *Variable, const char *Name,
@@ -709,13 +920,25 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                                             "Marshal", "without prior Init");
         }
 
+        /*
+         * A block copied into the buffer right now gets its min/max from the
+         * copy itself rather than from a separate pass over the user data
+         */
+        const bool CopyWithMinMax =
+            (m_StatsLevel > 0) && !Span && !Rec->OperatorType &&
+            !DeferAddToVec && (Sync || CurDataBuffer->AlwaysCopy()) &&
+            (MemSpace == MemorySpace::Host);
+
         MinMaxStruct MinMax;
         MinMax.Init(Type);
-        if ((m_StatsLevel > 0) && !Span)
+        if ((m_StatsLevel > 0) && !Span && !CopyWithMinMax)
         {
-            GetMinMax(Data, ElemCount, (DataType)Rec->Type, MinMax, MemSpace);
+            GetMinMax(Data, ElemCount, (DataType)Rec->Type, MinMax, MemSpace,
+                      m_StatsThreads);
         }
 
+        std::vector<Box<Dims>> SubBlocks;
+        std::vector<size_t> SubBlockSizes; /* stride 3, if compressed here */
         if (Rec->OperatorType)
         {
             std::string compressionMethod = Rec->OperatorType;
@@ -727,20 +950,94 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 tmpCount.push_back(Count[i]);
                 tmpOffsets.push_back(Offsets[i]);
             }
-            size_t AllocSize = ElemCount * ElemSize + 100;
-            BufferV::BufferPos pos =
-                CurDataBuffer->Allocate(AllocSize, ElemSize);
-            char *CompressedData =
-                (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
-            DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
-            CompressedSize = VB->m_Operations[0]->Operate(
-                (const char *)Data, tmpOffsets, tmpCount, (DataType)Rec->Type,
-                CompressedData);
-            CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            if (Rec->SubBlockInfoOffset != (size_t)-1)
+            {
+                SubBlocks = CompressionSubBlocks(tmpCount, ElemSize);
+            }
+            // each sub-block gets its own worst-case output space
+            size_t AllocSize = 0;
+            std::vector<size_t> OutOffsets;
+            if (SubBlocks.empty())
+            {
+                OutOffsets.push_back(0);
+                AllocSize = ElemCount * ElemSize + 100;
+            }
+            for (const auto &SubBlock : SubBlocks)
+            {
+                OutOffsets.push_back(AllocSize);
+                AllocSize +=
+                    helper::GetTotalSize(SubBlock.second) * ElemSize + 100;
+            }
+            if (!Sync && m_AsyncCompression && (compressionMethod != "sirius"))
+            {
+                /*
+                 * Deferred Put data stays valid until PerformPuts() or
+                 * EndStep(), so compress it in the background meanwhile. The
+                 * block location and size are patched into the metadata in
+                 * CollectDeferredCompressions()
+                 */
+                DeferredCompression Def;
+                Def.MetaOffset = Rec->MetaOffset;
+                Def.BlockID = AlreadyWritten ? MetaEntry->BlockCount : 0;
+                Def.AlignReq = ElemSize;
+                Def.SubBlockInfoOffset = Rec->SubBlockInfoOffset;
+                Def.SubBlockInfoIndex = (size_t)-1;
+                if (!SubBlocks.empty())
+                {
+                    // first triple of the run appended below
+                    Def.SubBlockInfoIndex =
+                        *(size_t *)((char *)MetaEntry +
+                                    Rec->SubBlockInfoOffset) +
+                        1;
+                }
+                Def.Buffer.resize(AllocSize);
+                Def.OutOffsets = OutOffsets;
+                Def.CompressedSizes = StartCompression(
+                    VB->m_Operations[0], compressionMethod, (const char *)Data,
+                    tmpOffsets, tmpCount, (DataType)Rec->Type, ElemSize,
+                    SubBlocks, Def.Buffer.data(), OutOffsets);
+                DeferredCompressions.push_back(std::move(Def));
+            }
+            else
+            {
+                BufferV::BufferPos pos =
+                    CurDataBuffer->Allocate(AllocSize, ElemSize);
+                char *CompressedData =
+                    (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+                if (SubBlocks.empty())
+                {
+                    CompressedSize = VB->m_Operations[0]->Operate(
+                        (const char *)Data, tmpOffsets, tmpCount,
+                        (DataType)Rec->Type, CompressedData);
+                }
+                else
+                {
+                    SubBlockSizes.resize(3 * SubBlocks.size());
+                    CompressedSize = CompactCompressedBlock(
+                        CompressedData, OutOffsets,
+                        StartCompression(VB->m_Operations[0],
+                                         compressionMethod, (const char *)Data,
+                                         tmpOffsets, tmpCount,
+                                         (DataType)Rec->Type, ElemSize,
+                                         SubBlocks, CompressedData, OutOffsets),
+                        SubBlockSizes.data());
+                }
+                CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            }
         }
         else if (Span == nullptr)
         {
-            if (!DeferAddToVec)
+            if (CopyWithMinMax)
+            {
+                BufferV::BufferPos pos =
+                    CurDataBuffer->Allocate(ElemCount * ElemSize, ElemSize);
+                CopyMinMax((char *)GetPtr(pos.bufferIdx, pos.posInBuffer),
+                           Data, ElemCount, ElemSize, (DataType)Rec->Type,
+                           MinMax, m_StatsThreads);
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+            }
+            else if (!DeferAddToVec)
             {
                 DataOffset = m_PriorDataBufferSizeTotal +
                              CurDataBuffer->AddToVec(ElemCount * ElemSize, Data,
@@ -866,6 +1163,25 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 MetaEntry->Offsets = AppendDims(
                     MetaEntry->Offsets, PreviousDBCount, DimCount, Offsets);
         }
+        if (Rec->SubBlockInfoOffset != (size_t)-1)
+        {
+            /* per block, the number of sub-blocks followed by a (start,
+             * count, compressed size) triple along dimension 0 for each */
+            size_t *InfoCount =
+                (size_t *)((char *)MetaEntry + Rec->SubBlockInfoOffset);
+            size_t **Info = (size_t **)(InfoCount + 1);
+            *Info = (size_t *)realloc(*Info, (*InfoCount + 1 +
+                                              3 * SubBlocks.size()) *
+                                                 sizeof(size_t));
+            (*Info)[(*InfoCount)++] = SubBlocks.size();
+            for (size_t i = 0; i < SubBlocks.size(); ++i)
+            {
+                (*Info)[(*InfoCount)++] = SubBlocks[i].first[0];
+                (*Info)[(*InfoCount)++] = SubBlocks[i].second[0];
+                (*Info)[(*InfoCount)++] =
+                    SubBlockSizes.empty() ? 0 : SubBlockSizes[3 * i];
+            }
+        }
     }
 }
 
@@ -1055,7 +1371,8 @@ void BP5Serializer::ProcessDeferredMinMax()
         MinMax.Init(Def.Type);
         void *Ptr = reinterpret_cast<void *>(
             GetPtr(Def.Data.bufferIdx, Def.Data.posInBuffer));
-        GetMinMax(Ptr, Def.ElemCount, Def.Type, MinMax, Def.MemSpace);
+        GetMinMax(Ptr, Def.ElemCount, Def.Type, MinMax, Def.MemSpace,
+                  m_StatsThreads);
 
         MetaArrayRecMM *MetaEntry =
             (MetaArrayRecMM *)((char *)(MetadataBuf) + Def.MetaOffset);
@@ -1097,7 +1414,7 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
     if (!Info.MetaFormat && Info.MetaFieldCount)
     {
         MetaMetaInfoBlock Block;
-        FMStructDescRec struct_list[20] = {
+        FMStructDescRec struct_list[26] = {
             {NULL, NULL, 0, NULL},
             {"complex4", fcomplex_field_list, sizeof(fcomplex_struct), NULL},
             {"complex8", dcomplex_field_list, sizeof(dcomplex_struct), NULL},
@@ -1124,6 +1441,18 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
              NULL},
             {"MetaArrayOpMM16", MetaArrayRecOperatorMM16ListPtr,
              sizeof(MetaArrayRecOperatorMM), NULL},
+            {"MetaArrayOpSub", MetaArrayRecOperatorSubListPtr,
+             sizeof(MetaArrayRecOperatorSub), NULL},
+            {"MetaArrayOpSubMM1", MetaArrayRecOperatorSubMM1ListPtr,
+             sizeof(MetaArrayRecOperatorSubMM), NULL},
+            {"MetaArrayOpSubMM2", MetaArrayRecOperatorSubMM2ListPtr,
+             sizeof(MetaArrayRecOperatorSubMM), NULL},
+            {"MetaArrayOpSubMM4", MetaArrayRecOperatorSubMM4ListPtr,
+             sizeof(MetaArrayRecOperatorSubMM), NULL},
+            {"MetaArrayOpSubMM8", MetaArrayRecOperatorSubMM8ListPtr,
+             sizeof(MetaArrayRecOperatorSubMM), NULL},
+            {"MetaArrayOpSubMM16", MetaArrayRecOperatorSubMM16ListPtr,
+             sizeof(MetaArrayRecOperatorSubMM), NULL},
             {NULL, NULL, 0, NULL}};
         struct_list[0].format_name = "MetaData";
         struct_list[0].field_list = Info.MetaFields;
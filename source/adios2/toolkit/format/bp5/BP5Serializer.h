@@ -17,6 +17,12 @@
 #include "atl.h"
 #include "ffs.h"
 #include "fm.h"
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
 #ifdef _WIN32
 #pragma warning(disable : 4250)
 #endif
@@ -138,6 +144,15 @@ public:
     size_t DebugGetDataBufferSize() const;
 
     int m_StatsLevel = 1;
+    /* threads computing min/max of large blocks, must be >= 1 */
+    unsigned int m_StatsThreads = 1;
+    /* compress deferred Puts in the background instead of inside Put() */
+    bool m_AsyncCompression = false;
+    /* sub-blocks and blocks compressed at once, must be >= 1 */
+    unsigned int m_CompressionThreads = 1;
+    /* split compressed blocks larger than this along the slowest dimension,
+     * 0 never splits */
+    size_t m_CompressionSubBlockSize = 0;
 
     /* Variables to help appending to existing file */
     size_t m_PreMetaMetadataFileLength = 0;
@@ -159,6 +174,7 @@ private:
         int DimCount;
         int Type;
         size_t MinMaxOffset;
+        size_t SubBlockInfoOffset;
     } * BP5WriterRec;
 
     struct FFSWriterMarshalBase
@@ -189,6 +205,22 @@ private:
     };
     std::vector<DeferredExtern> DeferredExterns;
 
+    struct DeferredCompression
+    {
+        size_t MetaOffset;
+        size_t BlockID;
+        size_t AlignReq;
+        size_t SubBlockInfoOffset;
+        size_t SubBlockInfoIndex; /* (size_t)-1 if not split */
+        std::vector<char> Buffer;
+        std::vector<size_t> OutOffsets;
+        std::vector<std::shared_future<size_t>> CompressedSizes;
+    };
+    /* serializes operators that keep library-global state */
+    std::mutex m_OperatorMutex;
+    std::vector<DeferredCompression> DeferredCompressions;
+    std::deque<std::shared_future<size_t>> m_RunningCompressions;
+
     struct DeferredSpanMinMax
     {
         const BufferV::BufferPos Data;
@@ -248,6 +280,16 @@ private:
                        const size_t Count, const size_t *Vals);
 
     void DumpDeferredBlocks(bool forceCopyDeferred = false);
+    std::vector<Box<Dims>> CompressionSubBlocks(const Dims &Count,
+                                                size_t ElemSize) const;
+    std::vector<std::shared_future<size_t>>
+    StartCompression(std::shared_ptr<core::Operator> Op,
+                     const std::string &Method, const char *Data,
+                     const Dims &Offsets, const Dims &Count,
+                     const DataType Type, size_t ElemSize,
+                     const std::vector<Box<Dims>> &SubBlocks, char *Out,
+                     const std::vector<size_t> &OutOffsets);
+    void CollectDeferredCompressions();
     void VariableStatsEnabled(void *Variable);
 
     typedef struct _ArrayRec
@@ -34,6 +34,8 @@ void BufferV::Reset()
 
 uint64_t BufferV::Size() noexcept { return CurOffset; }
 
+bool BufferV::AlwaysCopy() const noexcept { return m_AlwaysCopy; }
+
 void BufferV::AlignBuffer(const size_t align)
 {
     size_t badAlign = CurOffset % align;
@@ -27,6 +27,9 @@ public:
 
     uint64_t Size() noexcept;
 
+    /** true if AddToVec copies external blocks even when not required */
+    bool AlwaysCopy() const noexcept;
+
     BufferV(const std::string type, const bool AlwaysCopy = false,
             const size_t MemAlign = 1, const size_t MemBlockSize = 1);
     virtual ~BufferV();
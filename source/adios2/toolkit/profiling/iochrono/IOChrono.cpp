@@ -11,12 +11,87 @@
 #include "IOChrono.h"
 #include "adios2/helper/adiosMemory.h"
 
+#include <algorithm> // std::replace
+#include <atomic>
+#include <chrono>
+#include <numeric> // std::accumulate
+
 namespace adios2
 {
 namespace profiling
 {
 
-void IOChrono::Start(const std::string process) noexcept
+namespace
+{
+std::atomic<uint64_t> NextSerial(0);
+std::atomic<uint32_t> NextThread(0);
+}
+
+IOChrono::IOChrono() : m_Serial(NextSerial++) {}
+
+IOChrono::TimerID IOChrono::AddTimer(const std::string &process,
+                                     const TimeUnit timeUnit, const bool trace)
+{
+    m_Timers.emplace(process, Timer(process, timeUnit, trace));
+    return GetTimerID(process);
+}
+
+IOChrono::TimerID IOChrono::GetTimerID(const std::string &process)
+{
+    auto it = m_TimerIDs.find(process);
+    if (it != m_TimerIDs.end())
+    {
+        return it->second;
+    }
+    // timers emplaced directly into m_Timers get their ID here
+    const TimerID timer = static_cast<TimerID>(m_TimerByID.size());
+    m_TimerByID.push_back(&m_Timers.at(process));
+    m_TimerIDs.emplace(process, timer);
+    return timer;
+}
+
+const std::string &IOChrono::GetTimerName(const TimerID timer) const noexcept
+{
+    return m_TimerByID[timer]->m_Process;
+}
+
+void IOChrono::Start(const TimerID timer) noexcept
+{
+    if (m_IsActive)
+    {
+        m_TimerByID[timer]->Resume();
+    }
+}
+
+void IOChrono::Stop(const TimerID timer)
+{
+    if (m_IsActive)
+    {
+        Timer &t = *m_TimerByID[timer];
+        t.Pause();
+        if (m_Trace)
+        {
+            RecordEvent(timer, t);
+        }
+    }
+}
+
+void IOChrono::RecordEvent(const TimerID timer, const Timer &t) noexcept
+{
+    // Called from noexcept transport paths, an event that cannot be
+    // stored is dropped from the trace
+    try
+    {
+        ThreadEvents &te = GetThreadEvents();
+        te.events.push_back(
+            {timer, te.thread, t.GetLastStart(), t.GetLastDuration()});
+    }
+    catch (...)
+    {
+    }
+}
+
+void IOChrono::Start(const std::string &process) noexcept
 {
     if (m_IsActive)
     {
@@ -24,14 +99,67 @@ void IOChrono::Start(const std::string process) noexcept
     }
 }
 
-void IOChrono::Stop(const std::string process)
+void IOChrono::Stop(const std::string &process)
 {
     if (m_IsActive)
     {
-        m_Timers.at(process).Pause();
+        // Read-only lookup, this may run in several threads. Timers
+        // emplaced directly into m_Timers have no ID and are not traced.
+        auto it = m_TimerIDs.find(process);
+        if (m_Trace && it != m_TimerIDs.end())
+        {
+            Stop(it->second);
+        }
+        else
+        {
+            m_Timers.at(process).Pause();
+        }
     }
 }
 
+void IOChrono::Count(const std::string &counter, const size_t n) noexcept
+{
+    if (m_IsActive)
+    {
+        m_Counters[counter] += n;
+    }
+}
+
+std::vector<IOChrono::TraceEvent> IOChrono::GetTraceEvents() const
+{
+    std::vector<TraceEvent> events;
+    for (const auto &te : m_ThreadEvents)
+    {
+        events.insert(events.end(), te->events.begin(), te->events.end());
+    }
+    return events;
+}
+
+IOChrono::ThreadEvents &IOChrono::GetThreadEvents()
+{
+    // Every thread remembers its event buffers of the last few profilers
+    // it recorded into, so the lock is only taken at the first event
+    constexpr size_t cacheSize = 16;
+    thread_local const uint32_t thread = NextThread++;
+    thread_local std::vector<std::pair<uint64_t, ThreadEvents *>> cache;
+    for (auto it = cache.rbegin(); it != cache.rend(); ++it)
+    {
+        if (it->first == m_Serial)
+        {
+            return *it->second;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_ThreadEventsMutex);
+    m_ThreadEvents.emplace_back(new ThreadEvents{thread, {}});
+    if (cache.size() == cacheSize)
+    {
+        cache.erase(cache.begin());
+    }
+    cache.emplace_back(m_Serial, m_ThreadEvents.back().get());
+    return *m_ThreadEvents.back();
+}
+
 //
 // class JSON Profiler
 //
@@ -39,6 +167,7 @@ JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm)
 {
     m_Profiler.m_IsActive = true; // default is true
 
+    // in the order of JSONProfiler::Timers
     AddTimerWatch("buffering");
     AddTimerWatch("endstep");
     AddTimerWatch("PP");
@@ -53,12 +182,16 @@ JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm)
     m_Profiler.m_Bytes.emplace("buffering", 0);
 
     m_RankMPI = m_Comm.Rank();
+    m_StartTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
 }
 
-void JSONProfiler::AddTimerWatch(const std::string &name, const bool trace)
+JSONProfiler::TimerID JSONProfiler::AddTimerWatch(const std::string &name,
+                                                  const bool trace)
 {
     const TimeUnit timerUnit = DefaultTimeUnitEnum;
-    m_Profiler.m_Timers.emplace(name, profiling::Timer(name, timerUnit, trace));
+    return m_Profiler.AddTimer(name, timerUnit, trace);
 }
 
 std::string JSONProfiler::GetRankProfilingJSON(
@@ -106,6 +239,11 @@ std::string JSONProfiler::GetRankProfilingJSON(
         {
             lf_WriterTimer(rankLog, transportTimerPair.second);
         }
+        for (const auto &counterPair : transportsProfilers[t]->m_Counters)
+        {
+            rankLog += ", \"" + counterPair.first +
+                       "\":" + std::to_string(counterPair.second);
+        }
         rankLog += "}";
     }
     rankLog += " }"; // end rank entry
@@ -115,6 +253,63 @@ std::string JSONProfiler::GetRankProfilingJSON(
 
 std::vector<char>
 JSONProfiler::AggregateProfilingJSON(const std::string &rankLog) const
+{
+    return GatherJSON(rankLog, "[\n", "\n]\n");
+}
+
+std::string JSONProfiler::GetRankTraceJSON(
+    const std::vector<std::string> &transportsTypes,
+    const std::vector<profiling::IOChrono *> &transportsProfilers) const
+{
+    // Timer uses high_resolution_clock, the ranks need a common clock
+    const int64_t clockOffset =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count() -
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch())
+            .count();
+    const int64_t start = m_Comm.BroadcastValue(m_StartTime);
+
+    const std::string pid = std::to_string(m_RankMPI);
+    std::string rankTrace("{\"name\":\"process_name\", \"ph\":\"M\", "
+                          "\"pid\":" +
+                          pid + ", \"args\":{\"name\":\"rank " + pid +
+                          "\"}},\n");
+
+    auto lf_AddEvents = [&](const IOChrono &profiler, const std::string &cat,
+                            const std::string &args) {
+        for (const auto &e : profiler.GetTraceEvents())
+        {
+            rankTrace += "{\"name\":\"" + profiler.GetTimerName(e.timer) +
+                         "\", \"cat\":\"" + cat + "\", \"ph\":\"X\", \"ts\":" +
+                         std::to_string(e.start + clockOffset - start) +
+                         ", \"dur\":" + std::to_string(e.duration) +
+                         ", \"pid\":" + pid +
+                         ", \"tid\":" + std::to_string(e.thread) + args +
+                         "},\n";
+        }
+    };
+
+    lf_AddEvents(m_Profiler, "engine", "");
+    for (size_t t = 0; t < transportsProfilers.size(); ++t)
+    {
+        lf_AddEvents(*transportsProfilers[t], "transport_" + std::to_string(t),
+                     ", \"args\":{\"type\":\"" + transportsTypes[t] + "\"}");
+    }
+    return rankTrace;
+}
+
+std::vector<char>
+JSONProfiler::AggregateTraceJSON(const std::string &rankTrace) const
+{
+    return GatherJSON(rankTrace, "{\"traceEvents\":[\n", "\n]}\n");
+}
+
+// PRIVATE
+std::vector<char> JSONProfiler::GatherJSON(const std::string &rankLog,
+                                           const std::string &header,
+                                           const std::string &footer) const
 {
     // Gather sizes
     const size_t rankLogSize = rankLog.size();
@@ -122,8 +317,6 @@ JSONProfiler::AggregateProfilingJSON(const std::string &rankLog) const
 
     // Gatherv JSON per rank
     std::vector<char> profilingJSON(3);
-    const std::string header("[\n");
-    const std::string footer("\n]\n");
     size_t gatheredSize = 0;
     size_t position = 0;
 
@@ -140,7 +333,7 @@ JSONProfiler::AggregateProfilingJSON(const std::string &rankLog) const
     m_Comm.GathervArrays(rankLog.c_str(), rankLog.size(), rankLogsSizes.data(),
                          rankLogsSizes.size(), &profilingJSON[position]);
 
-    if (m_RankMPI == 0) // add footer to close JSON
+    if (m_RankMPI == 0) // add footer to close JSON, replacing the last ",\n"
     {
         position += gatheredSize - 2;
         helper::CopyToBuffer(profilingJSON, position, footer.c_str(),
@@ -12,6 +12,9 @@
 #define ADIOS2_TOOLKIT_PROFILING_IOCHRONO_IOCHRONO_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 /// \endcond
@@ -30,6 +33,20 @@ class IOChrono
 {
 
 public:
+    /** Index of a timer registered with AddTimer or GetTimerID */
+    using TimerID = uint32_t;
+
+    /** One Start-Stop interval of a timer, recorded if m_Trace is set */
+    struct TraceEvent
+    {
+        TimerID timer;
+        /** small number of the thread that recorded the event */
+        uint32_t thread;
+        /** start time in microseconds of Timer's clock, and duration */
+        int64_t start;
+        int64_t duration;
+    };
+
     /**
      * Create timers for each process
      * <pre>
@@ -43,31 +60,107 @@ public:
     /** Create byte tracking counter for each process*/
     std::unordered_map<std::string, size_t> m_Bytes;
 
+    /** Event counters (e.g. cache hits/misses), reported next to timers */
+    std::unordered_map<std::string, size_t> m_Counters;
+
     /** flag to determine if IOChrono object is being used */
     bool m_IsActive = false;
 
-    IOChrono() = default;
+    /** flag to record every Start-Stop interval for a timeline */
+    bool m_Trace = false;
+
+    IOChrono();
     ~IOChrono() = default;
 
+    /** Registers a timer in m_Timers (once) and returns its ID */
+    TimerID AddTimer(const std::string &process, const TimeUnit timeUnit,
+                     const bool trace = false);
+
+    /** ID of existing process in m_Timers, slower than keeping the ID.
+     * Registers timers emplaced directly into m_Timers, so it must not run
+     * concurrently with other calls */
+    TimerID GetTimerID(const std::string &process);
+
+    /** Name of a timer registered by ID */
+    const std::string &GetTimerName(const TimerID timer) const noexcept;
+
+    /** Start existing process by ID */
+    void Start(const TimerID timer) noexcept;
+
+    /**
+     * Stop existing process by ID
+     * @throws std::invalid_argument if Start wasn't called
+     * */
+    void Stop(const TimerID timer);
+
     /** Start existing process in m_Timers */
-    void Start(const std::string process) noexcept;
+    void Start(const std::string &process) noexcept;
 
     /**
-     * Stop existing process in m_Timers
+     * Stop existing process in m_Timers, only timers with an ID are traced
      * @throws std::invalid_argument if Start wasn't called
      * */
-    void Stop(const std::string process);
+    void Stop(const std::string &process);
+
+    /** Adds n to counter, creating it if needed, only if m_IsActive */
+    void Count(const std::string &counter, const size_t n = 1) noexcept;
+
+    /** Events recorded by all threads so far, must not run concurrently
+     * with Stop */
+    std::vector<TraceEvent> GetTraceEvents() const;
+
+private:
+    /** m_Timers elements by ID, elements of an unordered_map don't move */
+    std::vector<Timer *> m_TimerByID;
+    std::unordered_map<std::string, TimerID> m_TimerIDs;
+
+    /** Events of one thread, only that thread appends to it, without locks */
+    struct ThreadEvents
+    {
+        uint32_t thread;
+        std::vector<TraceEvent> events;
+    };
+    /** Distinguishes IOChrono objects in the threads' caches */
+    const uint64_t m_Serial;
+    std::mutex m_ThreadEventsMutex;
+    std::vector<std::unique_ptr<ThreadEvents>> m_ThreadEvents;
+
+    ThreadEvents &GetThreadEvents();
+    /** Appends the last interval of t to this thread's events */
+    void RecordEvent(const TimerID timer, const Timer &t) noexcept;
 };
 
 class JSONProfiler
 {
 public:
+    using TimerID = IOChrono::TimerID;
+
+    /** IDs of the timers every JSONProfiler has */
+    enum Timers : TimerID
+    {
+        Buffering,
+        EndStep,
+        PP,
+        MetaGather1,
+        MetaGather2,
+        MetaLvl1,
+        MetaLvl2,
+        CloseTS,
+        AWD,
+        WaitOnAsync
+    };
+
     JSONProfiler(helper::Comm const &comm);
     void Gather();
-    void AddTimerWatch(const std::string &, const bool trace = false);
+    TimerID AddTimerWatch(const std::string &, const bool trace = false);
+
+    void Start(const TimerID timer) { m_Profiler.Start(timer); };
+    void Stop(const TimerID timer) { m_Profiler.Stop(timer); };
+    void Start(const std::string &process) { m_Profiler.Start(process); };
+    void Stop(const std::string &process) { m_Profiler.Stop(process); };
 
-    void Start(const std::string process) { m_Profiler.Start(process); };
-    void Stop(const std::string process) { m_Profiler.Stop(process); };
+    /** Record every Start-Stop interval for GetRankTraceJSON */
+    void EnableTrace() noexcept { m_Profiler.m_Trace = true; }
 
     std::string
     GetRankProfilingJSON(const std::vector<std::string> &transportsTypes,
@@ -76,10 +169,30 @@ public:
 
     std::vector<char> AggregateProfilingJSON(const std::string &rankLog) const;
 
+    /**
+     * Events recorded by this profiler and the transport profilers, as
+     * Chrome/Perfetto trace events, each followed by ",\n".
+     * Collective, the time stamps are relative to the profiler creation on
+     * rank 0.
+     */
+    std::string
+    GetRankTraceJSON(const std::vector<std::string> &transportsTypes,
+                     const std::vector<adios2::profiling::IOChrono *>
+                         &transportsProfilers) const;
+
+    /** Gathers the output of GetRankTraceJSON into one trace on rank 0 */
+    std::vector<char> AggregateTraceJSON(const std::string &rankTrace) const;
+
 private:
     IOChrono m_Profiler;
     int m_RankMPI = 0;
     helper::Comm const &m_Comm;
+    /** creation time in microseconds since the epoch of system_clock */
+    int64_t m_StartTime;
+
+    std::vector<char> GatherJSON(const std::string &rankLog,
+                                 const std::string &header,
+                                 const std::string &footer) const;
 };
 
 } // end namespace profiling
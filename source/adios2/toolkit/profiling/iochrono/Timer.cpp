@@ -64,6 +64,20 @@ std::string Timer::GetShortUnits() const noexcept
     return units;
 }
 
+int64_t Timer::GetLastStart() const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               m_InitialTime.time_since_epoch())
+        .count();
+}
+
+int64_t Timer::GetLastDuration() const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               m_ElapsedTime - m_InitialTime)
+        .count();
+}
+
 // PRIVATE
 int64_t Timer::GetElapsedTime()
 {
@@ -68,6 +68,13 @@ public:
     /** Returns TimeUnit as a short std::string  */
     std::string GetShortUnits() const noexcept;
 
+    /** Start of the last Resume-Pause interval, in microseconds since the
+     * epoch of the timer's clock */
+    int64_t GetLastStart() const noexcept;
+
+    /** Length of the last Resume-Pause interval in microseconds */
+    int64_t GetLastDuration() const noexcept;
+
     void AddDetail()
     {
         m_nCalls++;
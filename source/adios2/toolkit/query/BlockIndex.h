@@ -1,7 +1,12 @@
 #ifndef ADIOS2_BLOCK_INDEX_H
 #define ADIOS2_BLOCK_INDEX_H
 
+#include <algorithm> //std::sort
+#include <atomic>
+#include <thread>
+
 #include "Index.h"
+#include "Predicate.h"
 #include "Query.h"
 
 namespace adios2
@@ -88,6 +93,134 @@ public:
         }
     }
 
+    /**
+     * Evaluates the query on every element of the blocks (or sub-blocks)
+     * whose min/max may satisfy it. The candidates are read with one
+     * PerformGets and evaluated on several threads.
+     * @param points row-major sorted coordinates of the matching elements
+     */
+    void EvaluatePoints(const QueryVar &query,
+                        std::vector<adios2::Dims> &points)
+    {
+        if (m_Var.m_ShapeID != ShapeID::GlobalArray)
+            return;
+
+        std::vector<adios2::Box<adios2::Dims>> candidates;
+        RunCandidates(query, candidates);
+        if (candidates.empty())
+            return;
+
+        std::vector<std::vector<T>> data(candidates.size());
+        {
+            // reading changes the selection of the user's variable
+            SelectionGuard guard(m_Var);
+            for (size_t k = 0; k < candidates.size(); ++k)
+            {
+                data[k].resize(
+                    adios2::helper::GetTotalSize(candidates[k].second));
+                m_Var.SetSelection(candidates[k]);
+                m_IdxReader.Get(m_Var, data[k].data(), adios2::Mode::Deferred);
+            }
+            m_IdxReader.PerformGets();
+        }
+
+        std::vector<std::vector<adios2::Dims>> hits(candidates.size());
+        std::atomic<size_t> next(0);
+        auto lf_Evaluate = [&]() {
+            std::vector<uint64_t> bits;
+            for (size_t k = next++; k < candidates.size(); k = next++)
+            {
+                query.m_RangeTree.Evaluate(data[k].data(), data[k].size(),
+                                           bits);
+                BitmapToPoints(bits, candidates[k], hits[k]);
+                std::vector<T>().swap(data[k]);
+            }
+        };
+
+        const size_t nThreads = std::min<size_t>(
+            std::max(std::thread::hardware_concurrency(), 1u),
+            candidates.size());
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for (size_t t = 1; t < nThreads; ++t)
+        {
+            threads.emplace_back(lf_Evaluate);
+        }
+        lf_Evaluate();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto &blockHits : hits)
+        {
+            points.insert(points.end(), blockHits.begin(), blockHits.end());
+        }
+        // blocks are not in row-major order of their elements
+        std::sort(points.begin(), points.end());
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+    }
+
+    /**
+     * Blocks and sub-blocks whose min/max may satisfy the query, in global
+     * coordinates and limited to the query selection
+     */
+    void RunCandidates(const QueryVar &query,
+                       std::vector<adios2::Box<adios2::Dims>> &candidates)
+    {
+        size_t currStep = m_IdxReader.CurrentStep();
+        adios2::Dims currShape = m_Var.Shape();
+        if (!query.IsSelectionValid(currShape))
+            return;
+
+        std::vector<typename adios2::core::Variable<T>::BPInfo> varBlocksInfo =
+            m_IdxReader.BlocksInfo(m_Var, currStep);
+
+        auto lf_AddCandidate = [&](adios2::Box<adios2::Dims> box) {
+            if (query.m_Selection.first.size() > 0)
+            {
+                box = adios2::helper::IntersectionStartCount(
+                    box.first, box.second, query.m_Selection.first,
+                    query.m_Selection.second);
+            }
+            if (box.first.size() > 0 &&
+                adios2::helper::GetTotalSize(box.second) > 0)
+                candidates.push_back(box);
+        };
+
+        for (auto &blockInfo : varBlocksInfo)
+        {
+            if (!query.TouchSelection(blockInfo.Start, blockInfo.Count))
+                continue;
+
+            if (blockInfo.MinMaxs.size() > 0)
+            {
+                adios2::helper::CalculateSubblockInfo(blockInfo.Count,
+                                                      blockInfo.SubBlockInfo);
+                unsigned int numSubBlocks =
+                    static_cast<unsigned int>(blockInfo.MinMaxs.size() / 2);
+                for (unsigned int i = 0; i < numSubBlocks; i++)
+                {
+                    if (!query.m_RangeTree.CheckInterval(
+                            blockInfo.MinMaxs[2 * i],
+                            blockInfo.MinMaxs[2 * i + 1]))
+                        continue;
+                    adios2::Box<adios2::Dims> subBlock =
+                        adios2::helper::GetSubBlock(
+                            blockInfo.Count, blockInfo.SubBlockInfo, i);
+                    for (size_t d = 0; d < subBlock.first.size(); ++d)
+                        subBlock.first[d] += blockInfo.Start[d];
+                    lf_AddCandidate(subBlock);
+                }
+            }
+            else if (query.m_RangeTree.CheckInterval(blockInfo.Min,
+                                                     blockInfo.Max))
+            {
+                lf_AddCandidate({blockInfo.Start, blockInfo.Count});
+            }
+        }
+    }
+
     /*
     void RunDefaultBPStat(const QueryVar &query,
                           std::vector<adios2::Box<adios2::Dims>> &hitBlocks)
@@ -121,9 +254,48 @@ public:
     */
 
     Tree m_Content;
-    adios2::core::Variable<T> m_Var;
+    adios2::core::Variable<T> &m_Var;
 
 private:
+    /**
+     * Saves the selection of the user's variable, which the candidates are
+     * read through, and restores it when going out of scope. The memory
+     * selection is cleared meanwhile, the candidates are read into buffers
+     * of their own size.
+     */
+    class SelectionGuard
+    {
+    public:
+        explicit SelectionGuard(adios2::core::Variable<T> &var)
+        : m_Var(var), m_SelectionType(var.m_SelectionType),
+          m_Start(var.m_Start), m_Count(var.m_Count),
+          m_MemoryStart(var.m_MemoryStart), m_MemoryCount(var.m_MemoryCount)
+        {
+            m_Var.m_MemoryStart.clear();
+            m_Var.m_MemoryCount.clear();
+        }
+
+        ~SelectionGuard()
+        {
+            m_Var.m_SelectionType = m_SelectionType;
+            m_Var.m_Start.swap(m_Start);
+            m_Var.m_Count.swap(m_Count);
+            m_Var.m_MemoryStart.swap(m_MemoryStart);
+            m_Var.m_MemoryCount.swap(m_MemoryCount);
+        }
+
+        SelectionGuard(const SelectionGuard &) = delete;
+        SelectionGuard &operator=(const SelectionGuard &) = delete;
+
+    private:
+        adios2::core::Variable<T> &m_Var;
+        const adios2::SelectionType m_SelectionType;
+        adios2::Dims m_Start;
+        adios2::Dims m_Count;
+        adios2::Dims m_MemoryStart;
+        adios2::Dims m_MemoryCount;
+    };
+
     //
     // blockid <=> vector of subcontents
     //
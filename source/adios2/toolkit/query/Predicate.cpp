@@ -0,0 +1,200 @@
+#include "Predicate.h"
+
+#include <functional> //std::greater, std::less, ...
+
+#include "adios2/common/ADIOSMacros.h"
+
+namespace adios2
+{
+namespace query
+{
+
+namespace
+{
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADIOS2_QUERY_DISPATCH
+#define ADIOS2_QUERY_INLINE inline __attribute__((always_inline))
+#else
+#define ADIOS2_QUERY_INLINE inline
+#endif
+
+/*
+ * Compares 64 elements at a time into byte lanes, which the compiler maps
+ * onto vector compares, then packs every 8 lanes into a byte of the result
+ * with one multiplication: for 8 bytes of 0/1, byte k moves to bit 56 + k.
+ */
+template <class T, class Cmp>
+ADIOS2_QUERY_INLINE void CompareLanes(const T *values, const size_t size,
+                                      const T value, uint64_t *bits) noexcept
+{
+    const Cmp cmp;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        uint8_t lanes[64];
+        for (size_t l = 0; l < 64; ++l)
+        {
+            lanes[l] = cmp(values[i + l], value) ? 1 : 0;
+        }
+
+        uint64_t word = 0;
+        for (size_t b = 0; b < 8; ++b)
+        {
+            uint64_t bytes = 0;
+            for (size_t k = 0; k < 8; ++k)
+            {
+                bytes |= static_cast<uint64_t>(lanes[8 * b + k]) << (8 * k);
+            }
+            word |= ((bytes * 0x0102040810204080ULL) >> 56) << (8 * b);
+        }
+        bits[i / 64] = word;
+    }
+
+    if (i < size)
+    {
+        uint64_t word = 0;
+        for (size_t l = 0; i + l < size; ++l)
+        {
+            word |= static_cast<uint64_t>(cmp(values[i + l], value) ? 1 : 0)
+                    << l;
+        }
+        bits[i / 64] = word;
+    }
+}
+
+template <class T>
+ADIOS2_QUERY_INLINE void CompareOp(const T *values, const size_t size,
+                                   const Op op, const T value,
+                                   uint64_t *bits) noexcept
+{
+    switch (op)
+    {
+    case Op::GT:
+        CompareLanes<T, std::greater<T>>(values, size, value, bits);
+        break;
+    case Op::LT:
+        CompareLanes<T, std::less<T>>(values, size, value, bits);
+        break;
+    case Op::GE:
+        CompareLanes<T, std::greater_equal<T>>(values, size, value, bits);
+        break;
+    case Op::LE:
+        CompareLanes<T, std::less_equal<T>>(values, size, value, bits);
+        break;
+    case Op::EQ:
+        CompareLanes<T, std::equal_to<T>>(values, size, value, bits);
+        break;
+    case Op::NE:
+        CompareLanes<T, std::not_equal_to<T>>(values, size, value, bits);
+        break;
+    default:
+        for (size_t w = 0; w < BitmapWords(size); ++w)
+        {
+            bits[w] = 0;
+        }
+        break;
+    }
+}
+
+#ifdef ADIOS2_QUERY_DISPATCH
+template <class T>
+__attribute__((target("avx512f,avx512bw"))) void
+CompareAVX512(const T *values, const size_t size, const Op op, const T value,
+              uint64_t *bits) noexcept
+{
+    CompareOp(values, size, op, value, bits);
+}
+
+template <class T>
+__attribute__((target("avx2"))) void
+CompareAVX2(const T *values, const size_t size, const Op op, const T value,
+            uint64_t *bits) noexcept
+{
+    CompareOp(values, size, op, value, bits);
+}
+
+enum class CompareISA
+{
+    Baseline,
+    AVX2,
+    AVX512
+};
+
+CompareISA DetectCompareISA() noexcept
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return CompareISA::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CompareISA::AVX2;
+    }
+    return CompareISA::Baseline;
+}
+#endif
+
+} // end anonymous namespace
+
+template <class T>
+void CompareToBitmap(const T *values, const size_t size, const Op op,
+                     const T value, uint64_t *bits) noexcept
+{
+#ifdef ADIOS2_QUERY_DISPATCH
+    static const CompareISA isa = DetectCompareISA();
+    switch (isa)
+    {
+    case CompareISA::AVX512:
+        CompareAVX512(values, size, op, value, bits);
+        return;
+    case CompareISA::AVX2:
+        CompareAVX2(values, size, op, value, bits);
+        return;
+    default:
+        break;
+    }
+#endif
+    CompareOp(values, size, op, value, bits);
+}
+
+void BitmapToPoints(const std::vector<uint64_t> &bits, const Box<Dims> &box,
+                    std::vector<Dims> &points)
+{
+    const Dims &start = box.first;
+    const Dims &count = box.second;
+    const size_t ndim = count.size();
+    Dims point(ndim);
+    for (size_t w = 0; w < bits.size(); ++w)
+    {
+        uint64_t word = bits[w];
+        while (word)
+        {
+            // lowest set bit
+            size_t b = 0;
+            while (!((word >> b) & 1))
+            {
+                ++b;
+            }
+            word &= word - 1;
+
+            size_t index = w * 64 + b;
+            for (size_t d = ndim; d > 0; --d)
+            {
+                point[d - 1] = start[d - 1] + index % count[d - 1];
+                index /= count[d - 1];
+            }
+            points.push_back(point);
+        }
+    }
+}
+
+#define declare_type(T)                                                        \
+    template void CompareToBitmap(const T *, const size_t, const Op, const T,  \
+                                  uint64_t *) noexcept;
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+} // end namespace query
+} // end namespace adios2
@@ -0,0 +1,47 @@
+#ifndef ADIOS2_QUERY_PREDICATE_H
+#define ADIOS2_QUERY_PREDICATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Query.h"
+
+namespace adios2
+{
+namespace query
+{
+
+/*
+ * Element-wise evaluation of query predicates. Results are bitmaps with one
+ * bit per element, element i in bit (i % 64) of word i / 64, so AND/OR of
+ * predicates are cheap word operations. Bits past the last element are 0.
+ */
+
+/** Number of 64-bit words of a bitmap over size elements */
+inline size_t BitmapWords(const size_t size) noexcept
+{
+    return (size + 63) / 64;
+}
+
+/**
+ * Sets bit i of bits to (values[i] op value) for i < size. The compares run
+ * on the widest vector unit of the CPU (AVX-512, AVX2 or the baseline of the
+ * build).
+ * @param bits at least BitmapWords(size) words
+ */
+template <class T>
+void CompareToBitmap(const T *values, const size_t size, const Op op,
+                     const T value, uint64_t *bits) noexcept;
+
+/**
+ * Appends the coordinates of the set bits of a bitmap over the row-major
+ * elements of box to points, in row-major order
+ */
+void BitmapToPoints(const std::vector<uint64_t> &bits,
+                    const Box<Dims> &box, std::vector<Dims> &points);
+
+} // end namespace query
+} // end namespace adios2
+
+#endif // ADIOS2_QUERY_PREDICATE_H
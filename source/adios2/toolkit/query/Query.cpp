@@ -1,7 +1,11 @@
 #include "Query.h"
 #include "BlockIndex.h"
+#include "Predicate.h"
 #include "adios2/helper/adiosFunctions.h"
 
+#include <algorithm> //std::set_intersection, std::set_union
+#include <iterator>  //std::back_inserter
+
 #include "Query.tcc"
 
 namespace adios2
@@ -79,6 +83,34 @@ void QueryBase::ApplyOutputRegion(std::vector<Box<Dims>> &touchedBlocks,
             it->first[k] += diff[k];
     }
 }
+
+void QueryBase::ApplyOutputRegion(std::vector<Dims> &points,
+                                  const adios2::Box<Dims> &referenceRegion)
+{
+    if (m_OutputRegion.first.size() == 0)
+        return;
+
+    adios2::Dims diff;
+    diff.resize(m_OutputRegion.first.size());
+    bool isDifferent = false;
+    for (size_t k = 0; k < m_OutputRegion.first.size(); k++)
+    {
+        diff[k] = m_OutputRegion.first[k] - referenceRegion.first[k];
+        if (diff[k] != 0)
+            isDifferent = true;
+    }
+
+    if (!isDifferent)
+        return;
+
+    // same shift for all, so the points stay sorted
+    for (auto &point : points)
+    {
+        for (size_t k = 0; k < m_OutputRegion.first.size(); k++)
+            point[k] += diff[k];
+    }
+}
+
 bool QueryComposite::AddNode(QueryBase *var)
 {
     if (nullptr == var)
@@ -234,6 +266,45 @@ void QueryComposite::BlockIndexEvaluate(adios2::core::IO &io,
     // from BP3
 }
 
+void QueryComposite::PointEvaluate(adios2::core::IO &io,
+                                   adios2::core::Engine &reader,
+                                   std::vector<Dims> &points)
+{
+    if (m_Nodes.size() == 0)
+        return;
+
+    // every node returns sorted points, so AND/OR are sorted set operations
+    int counter = 0;
+    for (auto node : m_Nodes)
+    {
+        counter++;
+        std::vector<Dims> currPoints;
+        node->PointEvaluate(io, reader, currPoints);
+        if (counter == 1)
+        {
+            points = std::move(currPoints);
+            continue;
+        }
+
+        std::vector<Dims> result;
+        if (adios2::query::Relation::AND == m_Relation)
+        {
+            std::set_intersection(points.begin(), points.end(),
+                                  currPoints.begin(), currPoints.end(),
+                                  std::back_inserter(result));
+        }
+        else if (adios2::query::Relation::OR == m_Relation)
+        {
+            std::set_union(points.begin(), points.end(), currPoints.begin(),
+                           currPoints.end(), std::back_inserter(result));
+        }
+        points = std::move(result);
+
+        if (points.empty() && adios2::query::Relation::AND == m_Relation)
+            break;
+    }
+}
+
 bool QueryVar::IsSelectionValid(adios2::Dims &shape) const
 {
     if (0 == m_Selection.first.size())
@@ -329,5 +400,27 @@ void QueryVar::BlockIndexEvaluate(adios2::core::IO &io,
         ApplyOutputRegion(touchedBlocks, m_Selection);
     }
 }
+
+void QueryVar::PointEvaluate(adios2::core::IO &io,
+                             adios2::core::Engine &reader,
+                             std::vector<Dims> &points)
+{
+    const DataType varType = io.InquireVariableType(m_VarName);
+
+#define declare_type(T)                                                        \
+    if (varType == adios2::helper::GetDataType<T>())                           \
+    {                                                                          \
+        core::Variable<T> *var = io.InquireVariable<T>(m_VarName);             \
+        BlockIndex<T> idx(*var, io, reader);                                   \
+        idx.EvaluatePoints(*this, points);                                     \
+    }
+    ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    if (points.size() > 0)
+    {
+        ApplyOutputRegion(points, m_Selection);
+    }
+}
 } // namespace query
 } // namespace adios2
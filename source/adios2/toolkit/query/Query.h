@@ -4,6 +4,7 @@
 #include <ios>      //std::ios_base::failure
 #include <iostream> //std::cout
 
+#include <cstdint>
 #include <numeric>   // accumulate
 #include <stdexcept> //std::invalid_argument std::exception
 #include <vector>
@@ -56,6 +57,11 @@ public:
     template <class T>
     bool CheckInterval(T &min, T &max) const;
 
+    /** bitmap of the elements of values that satisfy the range */
+    template <class T>
+    void Evaluate(const T *values, const size_t size,
+                  std::vector<uint64_t> &bits) const;
+
     void Print() { std::cout << "===> " << m_StrValue << std::endl; }
 }; // class Range
 
@@ -88,6 +94,11 @@ public:
     template <class T>
     bool CheckInterval(T &min, T &max) const;
 
+    /** bitmap of the elements of values that satisfy the tree */
+    template <class T>
+    void Evaluate(const T *values, const size_t size,
+                  std::vector<uint64_t> &bits) const;
+
     adios2::query::Relation m_Relation = adios2::query::Relation::AND;
     std::vector<Range> m_Leaves;
     std::vector<RangeTree> m_SubNodes;
@@ -101,6 +112,9 @@ public:
     virtual void Print() = 0;
     virtual void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
                                     std::vector<Box<Dims>> &touchedBlocks) = 0;
+    /** coordinates of the elements satisfying the query, row-major sorted */
+    virtual void PointEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                               std::vector<Dims> &points) = 0;
 
     Box<Dims> GetIntersection(const Box<Dims> &box1,
                               const Box<Dims> &box2) noexcept
@@ -127,6 +141,8 @@ public:
 
     void ApplyOutputRegion(std::vector<Box<Dims>> &touchedBlocks,
                            const adios2::Box<Dims> &referenceRegion);
+    void ApplyOutputRegion(std::vector<Dims> &points,
+                           const adios2::Box<Dims> &referenceRegion);
 
     adios2::Box<adios2::Dims> m_OutputRegion;
 
@@ -143,6 +159,8 @@ public:
     std::string &GetVarName() { return m_VarName; }
     void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
                             std::vector<Box<Dims>> &touchedBlocks);
+    void PointEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                       std::vector<Dims> &points);
     void BroadcastOutputRegion(const adios2::Box<adios2::Dims> &region)
     {
         m_OutputRegion = region;
@@ -219,6 +237,8 @@ public:
 
     void BlockIndexEvaluate(adios2::core::IO &, adios2::core::Engine &,
                             std::vector<Box<Dims>> &touchedBlocks);
+    void PointEvaluate(adios2::core::IO &, adios2::core::Engine &,
+                       std::vector<Dims> &points);
 
     bool AddNode(QueryBase *v);
 
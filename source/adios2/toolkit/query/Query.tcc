@@ -37,6 +37,18 @@ bool Range::CheckInterval(T &min, T &max) const
     return isHit;
 }
 
+template <class T>
+void Range::Evaluate(const T *values, const size_t size,
+                     std::vector<uint64_t> &bits) const
+{
+    std::stringstream convert(m_StrValue);
+    T value;
+    convert >> value;
+
+    bits.resize(BitmapWords(size));
+    CompareToBitmap(values, size, m_Op, value, bits.data());
+}
+
 template <class T>
 bool RangeTree::CheckInterval(T &min, T &max) const
 {
@@ -69,5 +81,66 @@ bool RangeTree::CheckInterval(T &min, T &max) const
     // anything else are false
     return false;
 }
+
+template <class T>
+void RangeTree::Evaluate(const T *values, const size_t size,
+                         std::vector<uint64_t> &bits) const
+{
+    const size_t nWords = BitmapWords(size);
+    std::vector<uint64_t> curr;
+
+    if (adios2::query::Relation::AND == m_Relation)
+    {
+        bits.assign(nWords, ~uint64_t(0));
+        if (size % 64)
+        {
+            bits.back() = (uint64_t(1) << (size % 64)) - 1;
+        }
+
+        auto lf_And = [&]() -> bool {
+            uint64_t any = 0;
+            for (size_t w = 0; w < nWords; ++w)
+            {
+                bits[w] &= curr[w];
+                any |= bits[w];
+            }
+            return any != 0;
+        };
+
+        for (auto &range : m_Leaves)
+        {
+            range.Evaluate(values, size, curr);
+            if (!lf_And())
+                return;
+        }
+
+        for (auto &node : m_SubNodes)
+        {
+            node.Evaluate(values, size, curr);
+            if (!lf_And())
+                return;
+        }
+        return; // all set if no leaves or nodes
+    }
+
+    bits.assign(nWords, 0);
+    if (adios2::query::Relation::OR == m_Relation)
+    {
+        for (auto &range : m_Leaves)
+        {
+            range.Evaluate(values, size, curr);
+            for (size_t w = 0; w < nWords; ++w)
+                bits[w] |= curr[w];
+        }
+
+        for (auto &node : m_SubNodes)
+        {
+            node.Evaluate(values, size, curr);
+            for (size_t w = 0; w < nWords; ++w)
+                bits[w] |= curr[w];
+        }
+    }
+    // anything else are false
+}
 }
 }
@@ -111,5 +111,23 @@ void Worker::GetResultCoverage(const adios2::Box<adios2::Dims> &outputRegion,
                                     touchedBlocks);
     }
 }
+
+void Worker::GetResultPoints(const adios2::Box<adios2::Dims> &outputRegion,
+                             std::vector<adios2::Dims> &points)
+{
+    points.clear();
+
+    if (!m_Query->UseOutputRegion(outputRegion))
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "query::Worker",
+                                             "GetResultPoints",
+                                             "Unable to use the output region");
+    }
+
+    if (m_Query && m_SourceReader)
+    {
+        m_Query->PointEvaluate(m_SourceReader->m_IO, *m_SourceReader, points);
+    }
+}
 } // namespace query
 } // namespace adios2
@@ -45,6 +45,9 @@ public:
     void GetResultCoverage(const adios2::Box<adios2::Dims> &,
                            std::vector<Box<adios2::Dims>> &);
 
+    void GetResultPoints(const adios2::Box<adios2::Dims> &,
+                         std::vector<adios2::Dims> &);
+
 protected:
     Worker(const std::string &configFile, adios2::core::Engine *adiosEngine);
 
@@ -0,0 +1,90 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * AtomicWait.cpp
+ *
+ */
+
+#include "AtomicWait.h"
+
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace adios2
+{
+namespace shm
+{
+
+namespace
+{
+
+/* Handoffs between processes on the same node usually complete within a
+ * few hundred nanoseconds, so it is cheaper to check a few times before
+ * going to sleep */
+constexpr int SpinCount = 128;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex needs a plain 32-bit word");
+
+#ifdef __linux__
+/* Not FUTEX_PRIVATE_FLAG: the word may be shared between processes */
+void Futex(const std::atomic<uint32_t> &word, const int op,
+           const uint32_t val) noexcept
+{
+    syscall(SYS_futex,
+            reinterpret_cast<uint32_t *>(
+                const_cast<std::atomic<uint32_t> *>(&word)),
+            op, val, nullptr, nullptr, 0);
+}
+#endif
+
+} // end anonymous namespace
+
+void AtomicWait(const std::atomic<uint32_t> &word, const uint32_t old) noexcept
+{
+    for (int i = 0; i < SpinCount; ++i)
+    {
+        if (word.load(std::memory_order_acquire) != old)
+        {
+            return;
+        }
+    }
+    while (word.load(std::memory_order_acquire) == old)
+    {
+#ifdef __linux__
+        // returns immediately if word != old already
+        Futex(word, FUTEX_WAIT, old);
+#else
+        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
+#endif
+    }
+}
+
+void AtomicNotifyOne(std::atomic<uint32_t> &word) noexcept
+{
+#ifdef __linux__
+    Futex(word, FUTEX_WAKE, 1);
+#else
+    (void)word;
+#endif
+}
+
+void AtomicNotifyAll(std::atomic<uint32_t> &word) noexcept
+{
+#ifdef __linux__
+    Futex(word, FUTEX_WAKE, INT_MAX);
+#else
+    (void)word;
+#endif
+}
+
+} // end namespace shm
+} // end namespace adios2
@@ -0,0 +1,37 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * AtomicWait.h
+ *
+ * Blocking wait on a 32-bit atomic word until another thread or process
+ * changes it, similar to std::atomic::wait/notify of C++20. The word can be
+ * in a shared memory segment to synchronize processes. Waiters spin briefly
+ * and then sleep in the kernel on a futex (Linux) or poll with short sleeps
+ * (elsewhere).
+ */
+
+#ifndef ADIOS2_TOOLKIT_SHM_ATOMICWAIT_H_
+#define ADIOS2_TOOLKIT_SHM_ATOMICWAIT_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace adios2
+{
+namespace shm
+{
+
+/** Return once word != old (spurious wakeups are handled inside) */
+void AtomicWait(const std::atomic<uint32_t> &word, const uint32_t old) noexcept;
+
+/** Wake up one of the threads/processes blocked in AtomicWait on word */
+void AtomicNotifyOne(std::atomic<uint32_t> &word) noexcept;
+
+/** Wake up all threads/processes blocked in AtomicWait on word */
+void AtomicNotifyAll(std::atomic<uint32_t> &word) noexcept;
+
+} // end namespace shm
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_SHM_ATOMICWAIT_H_ */
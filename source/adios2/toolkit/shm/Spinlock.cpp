@@ -11,26 +11,56 @@
  */
 
 #include "Spinlock.h"
-
-#include <chrono>
-#include <thread>
+#include "AtomicWait.h"
 
 namespace adios2
 {
 namespace shm
 {
 
-Spinlock::Spinlock() { flag_.clear(); }
+namespace
+{
+constexpr uint32_t Unlocked = 0;
+constexpr uint32_t Locked = 1;
+constexpr uint32_t Contended = 2;
+constexpr int SpinCount = 128;
+}
+
+Spinlock::Spinlock() : state_(Unlocked) {}
+
 void Spinlock::lock()
 {
-    while (!try_lock())
+    for (int i = 0; i < SpinCount; ++i)
+    {
+        if (try_lock())
+        {
+            return;
+        }
+    }
+    // tell the owner to wake us up, then sleep until the lock is ours
+    uint32_t c = state_.exchange(Contended, std::memory_order_acquire);
+    while (c != Unlocked)
+    {
+        AtomicWait(state_, Contended);
+        c = state_.exchange(Contended, std::memory_order_acquire);
+    }
+}
+
+void Spinlock::unlock()
+{
+    if (state_.exchange(Unlocked, std::memory_order_release) == Contended)
     {
-        std::this_thread::sleep_for(std::chrono::duration<double>(0.00001));
+        AtomicNotifyOne(state_);
     }
 }
-void Spinlock::unlock() { flag_.clear(); }
 
-inline bool Spinlock::try_lock() { return !flag_.test_and_set(); }
+inline bool Spinlock::try_lock()
+{
+    uint32_t c = Unlocked;
+    return state_.load(std::memory_order_relaxed) == Unlocked &&
+           state_.compare_exchange_strong(c, Locked,
+                                          std::memory_order_acquire);
+}
 
 } // end namespace shm
 } // end namespace adios2
@@ -14,16 +14,22 @@
 #define ADIOS2_TOOLKIT_SHM_SPINLOCK_H_
 
 #include <atomic>
+#include <cstdint>
 
 namespace adios2
 {
 namespace shm
 {
 
+/* A lock that can be placed in shared memory to synchronize processes.
+ * It spins briefly and then blocks (see AtomicWait.h) instead of burning
+ * the core while the lock is held by someone else.
+ */
 class Spinlock
 {
     /* from
      * https://wang-yimu.com/a-tutorial-on-shared-memory-inter-process-communication
+     * and "Futexes Are Tricky" by Ulrich Drepper for the blocking part
      */
 public:
     Spinlock();
@@ -33,7 +39,8 @@ public:
 
 private:
     inline bool try_lock();
-    std::atomic_flag flag_; //{ATOMIC_FLAG_INIT};
+    // 0: unlocked, 1: locked, 2: locked and others may be waiting
+    std::atomic<uint32_t> state_;
 };
 
 } // end namespace shm
@@ -40,18 +40,20 @@ void Transport::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
     }
 }
 
-void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
+void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit,
+                             const bool trace)
 {
     m_Profiler.m_IsActive = true;
+    m_Profiler.m_Trace = trace;
 
-    m_Profiler.m_Timers.emplace(std::make_pair(
-        "open", profiling::Timer("open", TimeUnit::Microseconds)));
+    // in the order of ProfilerTimers, unused timers are not reported
+    m_Profiler.AddTimer("open", TimeUnit::Microseconds);
+    m_Profiler.AddTimer("write", timeUnit);
+    m_Profiler.AddTimer("read", timeUnit);
+    m_Profiler.AddTimer("close", TimeUnit::Microseconds);
 
     if (openMode == Mode::Write)
     {
-        m_Profiler.m_Timers.emplace("write",
-                                    profiling::Timer("write", timeUnit));
-
         m_Profiler.m_Bytes.emplace("write", 0);
     }
     else if (openMode == Mode::Append)
@@ -61,23 +63,13 @@ void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
             "append", profiling::Timer("append", timeUnit));
         m_Profiler.Bytes.emplace("append", 0);
         */
-        m_Profiler.m_Timers.emplace("write",
-                                    profiling::Timer("write", timeUnit));
-
         m_Profiler.m_Bytes.emplace("write", 0);
-
-        m_Profiler.m_Timers.emplace("read", profiling::Timer("read", timeUnit));
-
         m_Profiler.m_Bytes.emplace("read", 0);
     }
     else if (openMode == Mode::Read)
     {
-        m_Profiler.m_Timers.emplace("read", profiling::Timer("read", timeUnit));
         m_Profiler.m_Bytes.emplace("read", 0);
     }
-
-    m_Profiler.m_Timers.emplace(
-        "close", profiling::Timer("close", TimeUnit::Microseconds));
 }
 
 void Transport::OpenChain(const std::string &name, const Mode openMode,
@@ -107,20 +99,33 @@ void Transport::Flush()
 
 size_t Transport::GetSize() { return 0; }
 
-void Transport::ProfilerStart(const std::string process) noexcept
+void Transport::Prefetch(
+    const std::vector<std::pair<size_t, size_t>> & /*ranges*/)
 {
-    if (m_Profiler.m_IsActive)
-    {
-        m_Profiler.m_Timers.at(process).Resume();
-    }
 }
 
-void Transport::ProfilerStop(const std::string process) noexcept
+size_t Transport::GetPreferredBlockSize() const { return 0; }
+
+size_t Transport::GetPreferredStripeSize() const { return 0; }
+
+void Transport::ProfilerStart(const profiling::IOChrono::TimerID timer) noexcept
 {
-    if (m_Profiler.m_IsActive)
-    {
-        m_Profiler.m_Timers.at(process).Pause();
-    }
+    m_Profiler.Start(timer);
+}
+
+void Transport::ProfilerStop(const profiling::IOChrono::TimerID timer) noexcept
+{
+    m_Profiler.Stop(timer);
+}
+
+void Transport::ProfilerStart(const std::string &process) noexcept
+{
+    m_Profiler.Start(process);
+}
+
+void Transport::ProfilerStop(const std::string &process) noexcept
+{
+    m_Profiler.Stop(process);
 }
 
 void Transport::CheckName() const
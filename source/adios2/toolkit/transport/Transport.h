@@ -13,6 +13,7 @@
 
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 /// \endcond
 
@@ -55,7 +56,12 @@ public:
 
     virtual ~Transport() = default;
 
-    void InitProfiler(const Mode openMode, const TimeUnit timeUnit);
+    /**
+     * Activates m_Profiler with the open, write, read and close timers
+     * @param trace record every operation for a timeline, see IOChrono
+     */
+    void InitProfiler(const Mode openMode, const TimeUnit timeUnit,
+                      const bool trace = false);
 
     /**
      * Opens transport, possibly asynchronously, required before SetBuffer,
@@ -129,6 +135,15 @@ public:
      */
     virtual void Read(char *buffer, size_t size, size_t start = MaxSizeT) = 0;
 
+    /**
+     * Hints that the given ranges are about to be Read, in this order.
+     * Transports may start fetching them in the background, the default
+     * ignores the hint
+     * @param ranges (start, size) pairs sorted by start
+     */
+    virtual void
+    Prefetch(const std::vector<std::pair<size_t, size_t>> &ranges);
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
@@ -154,10 +169,37 @@ public:
 
     virtual void MkDir(const std::string &fileName) = 0;
 
+    /**
+     * Preferred alignment for write offsets and sizes, writes aligned to it
+     * reach the medium without read-modify-write
+     * @return block size in bytes, 0 if the transport has no preference
+     */
+    virtual size_t GetPreferredBlockSize() const;
+
+    /**
+     * Preferred granularity of the file layout (e.g. object size), writers
+     * starting at multiples of it do not share storage units
+     * @return stripe size in bytes, 0 if the transport has no preference
+     */
+    virtual size_t GetPreferredStripeSize() const;
+
 protected:
-    void ProfilerStart(const std::string process) noexcept;
+    /** IDs of the m_Profiler timers registered by InitProfiler */
+    enum ProfilerTimers : profiling::IOChrono::TimerID
+    {
+        ProfileOpen,
+        ProfileWrite,
+        ProfileRead,
+        ProfileClose
+    };
+
+    void ProfilerStart(const profiling::IOChrono::TimerID timer) noexcept;
+
+    void ProfilerStop(const profiling::IOChrono::TimerID timer) noexcept;
+
+    void ProfilerStart(const std::string &process) noexcept;
 
-    void ProfilerStop(const std::string process) noexcept;
+    void ProfilerStop(const std::string &process) noexcept;
 
     virtual void CheckName() const;
 };
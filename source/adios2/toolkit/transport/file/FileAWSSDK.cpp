@@ -177,7 +177,7 @@ void FileAWSSDK::Open(const std::string &name, const Mode openMode,
 
     case Mode::Read:
     {
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         Aws::S3::Model::HeadObjectRequest head_object_request;
         head_object_request.SetBucket(m_BucketName);
@@ -203,7 +203,7 @@ void FileAWSSDK::Open(const std::string &name, const Mode openMode,
         }
 
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
     }
     default:
@@ -344,7 +344,7 @@ void FileAWSSDK::Close()
 {
     WaitForOpen();
     std::cout << "FileAWSSDK::Close(" << m_Name << ") Enter" << std::endl;
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     errno = 0;
     m_Errno = errno;
     if (s3Client)
@@ -367,7 +367,7 @@ void FileAWSSDK::Close()
     }
 
     m_IsOpen = false;
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 }
 
 void FileAWSSDK::Delete()
@@ -487,35 +487,35 @@ void FileDaos::Open(const std::string &name, const Mode openMode,
     {
 
     case Mode::Write:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         rc =
             dfs_open(/*DFS*/ m_Impl->Mount, /*PARENT*/ parent, fileName.c_str(),
                      S_IFREG | S_IWUSR, O_RDWR | O_CREAT, /*CID*/ 0,
                      /*chunksize*/ 0, NULL, &m_Impl->Obj);
         CheckDAOSReturnCode(rc);
         m_Errno = rc;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         rc =
             dfs_open(/*DFS*/ m_Impl->Mount, /*PARENT*/ parent, fileName.c_str(),
                      S_IFREG | S_IWUSR | S_IRUSR, O_RDWR | O_CREAT, /*CID*/ 0,
                      /*chunksize*/ 0, NULL, &m_Impl->Obj);
         CheckDAOSReturnCode(rc);
         m_Errno = rc;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         rc = dfs_open(/*DFS*/ m_Impl->Mount, /*PARENT*/ parent,
                       fileName.c_str(), S_IFREG | S_IRUSR, O_RDONLY, /*CID*/ 0,
                       /*chunksize*/ 0, NULL, &m_Impl->Obj);
         CheckDAOSReturnCode(rc);
         m_Errno = rc;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -554,7 +554,7 @@ void FileDaos::Write(const char *buffer, size_t size, size_t start)
         wsgl.sg_nr_out = 1;
         wsgl.sg_iovs = &iov;
         wsgl.sg_iovs[0].iov_len = io_size;
-        ProfilerStart("write");
+        ProfilerStart(ProfileWrite);
         // errno = 0;
 
         // const auto writtenSize = write(m_FileDescriptor, buffer, size);
@@ -579,13 +579,13 @@ void FileDaos::Write(const char *buffer, size_t size, size_t start)
         // std::cout << "rank " << m_Comm.Rank() << ": dfs_write succeeded!" <<
         // std::endl;
         m_Errno = rc;
-        ProfilerStop("write");
+        ProfilerStop(ProfileWrite);
         m_GlobalOffset += size;
         //        while (written_size < size)
         //        {
         //            io_size = size - written_size;
         //            wsgl.sg_iovs[0].iov_len = io_size;
-        //            ProfilerStart("write");
+        //            ProfilerStart(ProfileWrite);
         //            // errno = 0;
         //
         //            // const auto writtenSize = write(m_FileDescriptor,
@@ -606,7 +606,7 @@ void FileDaos::Write(const char *buffer, size_t size, size_t start)
         //	    //std::cout << "rank " << m_Comm.Rank() << ": dfs_write
         // succeeded!" << std::endl;
         //            m_Errno = rc;
-        //            ProfilerStop("write");
+        //            ProfilerStop(ProfileWrite);
         //            /*if (writtenSize == -1)
         //            {
         //                if (errno == EINTR)
@@ -670,7 +670,7 @@ void FileDaos::Read(char *buffer, size_t size, size_t start)
         rsgl.sg_nr_out = 1;
         rsgl.sg_iovs = &iov;
         rsgl.sg_iovs[0].iov_len = io_size;
-        ProfilerStart("read");
+        ProfilerStart(ProfileRead);
 
         // std::cout << "rank " << m_Comm.Rank() << ": start dfs_read..." <<
         // std::endl;
@@ -689,13 +689,13 @@ void FileDaos::Read(char *buffer, size_t size, size_t start)
         // std::cout << "rank " << m_Comm.Rank() << ": dfs_read succeeded!" <<
         // std::endl;
         m_Errno = rc;
-        ProfilerStop("read");
+        ProfilerStop(ProfileRead);
         m_GlobalOffset += size;
         //        while (read_size < size)
         //        {
         //            request_size = size - read_size;
         //            rsgl.sg_iovs[0].iov_len = request_size;
-        //            ProfilerStart("read");
+        //            ProfilerStart(ProfileRead);
         //
         //	    //std::cout << "rank " << m_Comm.Rank() << ": start
         // dfs_read..." << std::endl;
@@ -718,7 +718,7 @@ void FileDaos::Read(char *buffer, size_t size, size_t start)
         //	    //std::cout << "rank " << m_Comm.Rank() << ": dfs_read
         // succeeded!" << std::endl;
         //            m_Errno = rc;
-        //            ProfilerStop("read");
+        //            ProfilerStop(ProfileRead);
         //
         //            buffer += read_size;
         //            read_size += got_size;
@@ -768,12 +768,12 @@ void FileDaos::Flush() {}
 void FileDaos::Close()
 {
     WaitForOpen();
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     int rc;
     rc = dfs_release(m_Impl->Obj);
     m_Impl->Obj = NULL;
     m_Errno = rc;
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 
     if (rc)
     {
@@ -49,10 +49,10 @@ void FileFStream::Open(const std::string &name, const Mode openMode,
                        const bool async, const bool directio)
 {
     auto lf_AsyncOpenWrite = [&](const std::string &name) -> void {
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::out | std::fstream::binary |
                                     std::fstream::trunc);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
     };
     m_Name = name;
     CheckName();
@@ -69,25 +69,25 @@ void FileFStream::Open(const std::string &name, const Mode openMode,
         }
         else
         {
-            ProfilerStart("open");
+            ProfilerStart(ProfileOpen);
             m_FileStream.open(name, std::fstream::out | std::fstream::binary |
                                         std::fstream::trunc);
-            ProfilerStop("open");
+            ProfilerStop(ProfileOpen);
         }
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::in | std::fstream::out |
                                     std::fstream::binary);
         m_FileStream.seekp(0, std::ios_base::end);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::in | std::fstream::binary);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -109,10 +109,10 @@ void FileFStream::OpenChain(const std::string &name, Mode openMode,
                             const bool directio)
 {
     auto lf_AsyncOpenWrite = [&](const std::string &name) -> void {
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::out | std::fstream::binary |
                                     std::fstream::trunc);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
     };
 
     int token = 1;
@@ -137,7 +137,7 @@ void FileFStream::OpenChain(const std::string &name, Mode openMode,
         }
         else
         {
-            ProfilerStart("open");
+            ProfilerStart(ProfileOpen);
             if (chainComm.Rank() == 0)
             {
                 m_FileStream.open(name, std::fstream::out |
@@ -149,22 +149,22 @@ void FileFStream::OpenChain(const std::string &name, Mode openMode,
                 m_FileStream.open(name,
                                   std::fstream::out | std::fstream::binary);
             }
-            ProfilerStop("open");
+            ProfilerStop(ProfileOpen);
         }
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::in | std::fstream::out |
                                     std::fstream::binary);
         m_FileStream.seekp(0, std::ios_base::end);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileStream.open(name, std::fstream::in | std::fstream::binary);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -203,9 +203,9 @@ void FileFStream::SetBuffer(char *buffer, size_t size)
 void FileFStream::Write(const char *buffer, size_t size, size_t start)
 {
     auto lf_Write = [&](const char *buffer, size_t size) {
-        ProfilerStart("write");
+        ProfilerStart(ProfileWrite);
         m_FileStream.write(buffer, static_cast<std::streamsize>(size));
-        ProfilerStop("write");
+        ProfilerStop(ProfileWrite);
         CheckFile("couldn't write from file " + m_Name +
                   ", in call to fstream write");
     };
@@ -240,9 +240,9 @@ void FileFStream::Write(const char *buffer, size_t size, size_t start)
 void FileFStream::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
-        ProfilerStart("read");
+        ProfilerStart(ProfileRead);
         m_FileStream.read(buffer, static_cast<std::streamsize>(size));
-        ProfilerStop("read");
+        ProfilerStop(ProfileRead);
         CheckFile("couldn't read from file " + m_Name +
                   ", in call to fstream read");
     };
@@ -293,9 +293,9 @@ size_t FileFStream::GetSize()
 void FileFStream::Flush()
 {
     WaitForOpen();
-    ProfilerStart("write");
+    ProfilerStart(ProfileWrite);
     m_FileStream.flush();
-    ProfilerStart("write");
+    ProfilerStart(ProfileWrite);
     CheckFile("couldn't flush to file " + m_Name +
               ", in call to fstream flush");
 }
@@ -303,9 +303,9 @@ void FileFStream::Flush()
 void FileFStream::Close()
 {
     WaitForOpen();
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     m_FileStream.close();
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 
     CheckFile("couldn't close file " + m_Name + ", in call to fstream close");
     m_IsOpen = false;
@@ -16,8 +16,10 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <ios>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -29,24 +31,70 @@ namespace adios2
 namespace transport
 {
 
-int FileFlexNVMe::refCount = 0;
-struct flan_handle *FileFlexNVMe::flanh = nullptr;
+std::unordered_map<std::string, std::unique_ptr<FlanDevice>>
+    FileFlexNVMe::devices;
+std::mutex FileFlexNVMe::devicesMutex;
+
+namespace
+{
+/* Manifest layout, as uint64_t words: magic, logical size, chunk count, run
+ * count, then (first chunk, number of chunks, chunk size) per run of
+ * equally sized chunks */
+const uint64_t ManifestMagic = 0x4c4e4d56454c4641; // "AFLEVMNL"
+const size_t ManifestHeaderWords = 4;
+const size_t ManifestRunWords = 3;
+}
 
 FileFlexNVMe::FileFlexNVMe(helper::Comm const &comm)
 : Transport("File", "FlexNVMe", comm)
 {
-    FileFlexNVMe::refCount++;
 }
 
 FileFlexNVMe::~FileFlexNVMe() noexcept
 {
-    FileFlexNVMe::refCount--;
-    Close();
+    // Close waits on outstanding requests and writes the manifest, either
+    // can fail and must not escape the destructor
+    try
+    {
+        // No chain token passing from a destructor, other ranks may be gone
+        if (m_chainComm)
+        {
+            m_chainComm = nullptr;
+            MergeManifest();
+        }
+        Close();
+    }
+    catch (std::exception &e)
+    {
+        try
+        {
+            helper::Log("Transport", "FileFlexNVMe", "~FileFlexNVMe",
+                        "failed to close " + m_Name + ": " + e.what(),
+                        helper::FATALERROR);
+        }
+        catch (...)
+        {
+        }
+    }
+    catch (...)
+    {
+    }
+    ReleaseDevices();
 }
 
 void FileFlexNVMe::SetParameters(const Params &params)
 {
+    // Engines tag their metadata files, which are small and grow in small
+    // pieces, so they can be kept in a pool of smaller objects
+    std::string fileRole;
+    helper::SetParameterValue("FileRole", params, fileRole);
+    m_isMetadata = fileRole == "metadata";
+
     helper::SetParameterValue("device_url", params, m_deviceUrl);
+    if (m_isMetadata)
+    {
+        helper::SetParameterValue("metadata_device_url", params, m_deviceUrl);
+    }
     if (m_deviceUrl.empty())
     {
         helper::Throw<std::invalid_argument>(
@@ -54,7 +102,29 @@ void FileFlexNVMe::SetParameters(const Params &params)
             "device_url parameter has not been set");
     }
 
+    // A comma separated list stripes the file over several devices
+    m_deviceUrls.clear();
+    std::stringstream urls(m_deviceUrl);
+    std::string url;
+    while (std::getline(urls, url, ','))
+    {
+        if (!url.empty())
+        {
+            m_deviceUrls.push_back(url);
+        }
+    }
+    if (m_deviceUrls.empty())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "transport::file::FileFlexNVMe", "SetParameters",
+            "device_url parameter does not name any device");
+    }
+
     helper::SetParameterValue("pool_name", params, m_poolName);
+    if (m_isMetadata)
+    {
+        helper::SetParameterValue("metadata_pool_name", params, m_poolName);
+    }
     if (m_poolName.empty())
     {
         helper::Throw<std::invalid_argument>(
@@ -64,6 +134,10 @@ void FileFlexNVMe::SetParameters(const Params &params)
 
     std::string tmpObjSize;
     helper::SetParameterValue("object_size", params, tmpObjSize);
+    if (m_isMetadata)
+    {
+        helper::SetParameterValue("metadata_object_size", params, tmpObjSize);
+    }
     if (tmpObjSize.empty())
     {
         helper::Throw<std::invalid_argument>(
@@ -75,26 +149,84 @@ void FileFlexNVMe::SetParameters(const Params &params)
         m_objectSize = static_cast<size_t>(
             helper::StringTo<size_t>(tmpObjSize, "Object size"));
     }
+
+    std::string tmpCacheSize;
+    helper::SetParameterValue("object_cache_size", params, tmpCacheSize);
+    if (!tmpCacheSize.empty())
+    {
+        m_objectCacheSize = static_cast<size_t>(
+            helper::StringTo<size_t>(tmpCacheSize, "Object cache size"));
+    }
+
+    std::string tmpQueueDepth;
+    helper::SetParameterValue("queue_depth", params, tmpQueueDepth);
+    if (!tmpQueueDepth.empty())
+    {
+        m_queueDepth = static_cast<size_t>(
+            helper::StringTo<size_t>(tmpQueueDepth, "Queue depth"));
+        if (m_queueDepth == 0)
+        {
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "transport::file::FileFlexNVMe", "SetParameters",
+                "queue_depth parameter must be at least 1");
+        }
+    }
+
+    std::string tmpPrefetchDepth;
+    helper::SetParameterValue("prefetch_depth", params, tmpPrefetchDepth);
+    if (!tmpPrefetchDepth.empty())
+    {
+        m_prefetchDepth = static_cast<size_t>(
+            helper::StringTo<size_t>(tmpPrefetchDepth, "Prefetch depth"));
+    }
+
+    std::string tmpStripeWidth;
+    helper::SetParameterValue("stripe_width", params, tmpStripeWidth);
+    if (!tmpStripeWidth.empty())
+    {
+        m_stripeWidth = static_cast<size_t>(
+            helper::StringTo<size_t>(tmpStripeWidth, "Stripe width"));
+        if (m_stripeWidth == 0)
+        {
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "transport::file::FileFlexNVMe", "SetParameters",
+                "stripe_width parameter must be at least 1");
+        }
+    }
 }
 
 // TODO(adbo):
 //  - Async open/close?
 //  - Remove printf/cout
 void FileFlexNVMe::Open(const std::string &name, const Mode openMode,
-                        const bool /*async*/, const bool /*directio*/)
+                        const bool async, const bool /*directio*/)
+{
+    m_chainComm = nullptr;
+    OpenFile(name, openMode, async, true);
+}
+
+void FileFlexNVMe::OpenFile(const std::string &name, const Mode openMode,
+                            const bool async, const bool truncate)
 {
+    ClearPrefetch();
+
     m_Name = name;
     m_OpenMode = openMode;
+    m_async = async;
     m_baseName = NormalisedObjectName(const_cast<std::string &>(name));
     m_Cursor = 0;
 
+    m_logicalSize = 0;
+    m_chunkSizes.clear();
+    m_manifestDirty = false;
+
     switch (m_OpenMode)
     {
     case Mode::Write:
+    case Mode::Append:
     case Mode::Read:
         break;
 
-    // TODO(adbo): more open modes?
     default:
         helper::Throw<std::invalid_argument>(
             "Toolkit", "transport::file::FileFlexNVMe", "Open",
@@ -102,41 +234,108 @@ void FileFlexNVMe::Open(const std::string &name, const Mode openMode,
                 " in call to FlexNVMe open");
     }
 
-    ProfilerStart("open");
+    ProfilerStart(ProfileOpen);
+
+    InitDevices();
+    // Chunks on different devices are always transferred concurrently
+    m_async = m_async || m_devices.size() > 1;
+
+    if (m_OpenMode == Mode::Write && truncate)
+    {
+        // Like O_TRUNC, drop whatever an earlier run left under this name
+        LoadChunkLayout();
+        DeleteFileObjects();
+        m_manifestDirty = true;
+    }
+    else if (m_OpenMode == Mode::Append)
+    {
+        LoadChunkLayout();
+        m_Cursor = m_logicalSize;
+    }
 
-    InitFlan(m_poolName);
     m_IsOpen = true;
 
-    ProfilerStop("open");
+    ProfilerStop(ProfileOpen);
+}
+
+void FileFlexNVMe::InitDevices()
+{
+    if (!m_devices.empty())
+    {
+        // Reopened, we already hold our devices
+        return;
+    }
+
+    // Held across flan_init so two transports opening at once do not both
+    // initialise the same device
+    std::lock_guard<std::mutex> lock(FileFlexNVMe::devicesMutex);
+    for (const std::string &url : m_deviceUrls)
+    {
+        auto it = FileFlexNVMe::devices.find(url);
+        if (it == FileFlexNVMe::devices.end())
+        {
+            it = FileFlexNVMe::devices.emplace(url, InitFlan(url)).first;
+        }
+        else if (it->second->poolName != m_poolName ||
+                 it->second->objectSize != m_objectSize)
+        {
+            // A flan handle holds a single pool, and a device must not be
+            // initialised twice in one process
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "transport::file::FileFlexNVMe", "Open",
+                "device " + url + " is already open with pool " +
+                    it->second->poolName + " and object size " +
+                    std::to_string(it->second->objectSize) + ", " + m_Name +
+                    " needs pool " + m_poolName + " and object size " +
+                    std::to_string(m_objectSize) +
+                    ", use a separate device for metadata_device_url");
+        }
+        it->second->refCount++;
+        m_devices.push_back(it->second.get());
+    }
 }
 
-void FileFlexNVMe::InitFlan(const std::string &pool_name)
+void FileFlexNVMe::ReleaseDevices() noexcept
 {
-    if (FileFlexNVMe::flanh != nullptr)
+    if (m_devices.empty())
     {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(FileFlexNVMe::devicesMutex);
+    for (FlanDevice *device : m_devices)
+    {
+        if (--device->refCount <= 0)
+        {
+            // Our handles are all closed, and nobody else holds the device
+            // Copied, erasing destroys the device holding the key
+            const std::string url = device->url;
+            flan_close(device->handle);
+            FileFlexNVMe::devices.erase(url);
+        }
+    }
+    m_devices.clear();
+}
+
+auto FileFlexNVMe::InitFlan(const std::string &deviceUrl)
+    -> std::unique_ptr<FlanDevice>
+{
     struct fla_pool_create_arg pool_arg = {
         .flags = 0,
-        .name = const_cast<char *>(pool_name.c_str()),
-        .name_len = static_cast<int>(pool_name.length() + 1),
+        .name = const_cast<char *>(m_poolName.c_str()),
+        .name_len = static_cast<int>(m_poolName.length() + 1),
         .obj_nlb = 0, // will get set by flan_init
         .strp_nobjs = 0,
         .strp_nbytes = 0};
 
     uint64_t obj_size = m_objectSize;
+    struct flan_handle *handle = nullptr;
 
-    if (flan_init(const_cast<char *>(m_deviceUrl.c_str()), nullptr, &pool_arg,
-                  obj_size, &FileFlexNVMe::flanh))
+    if (flan_init(const_cast<char *>(deviceUrl.c_str()), nullptr, &pool_arg,
+                  obj_size, &handle))
     {
-        // We have to reset the address to null because flan_init can change its
-        // value even when it fails.
-        FileFlexNVMe::flanh = nullptr;
-
-        std::string err =
-            "failed to initialise flan in call to FlexNVMe open: " +
-            ErrnoErrMsg();
+        std::string err = "failed to initialise flan on " + deviceUrl +
+                          " in call to FlexNVMe open: " + ErrnoErrMsg();
 
         if (errno == 22)
         {
@@ -148,6 +347,19 @@ void FileFlexNVMe::InitFlan(const std::string &pool_name)
         helper::Throw<std::runtime_error>(
             "Toolkit", "transport::file::FileFlexNVMe", "Open", err);
     }
+
+    // flan_init reports how many logical blocks make up one object
+    const size_t lbaSize =
+        pool_arg.obj_nlb > 0 ? obj_size / pool_arg.obj_nlb : 0;
+
+    std::unique_ptr<FlanDevice> device(new FlanDevice());
+    device->url = deviceUrl;
+    device->handle = handle;
+    device->poolName = m_poolName;
+    device->objectSize = m_objectSize;
+    device->lbaSize = lbaSize;
+    device->refCount = 0;
+    return device;
 }
 
 auto FileFlexNVMe::ErrnoErrMsg() const -> std::string
@@ -160,11 +372,34 @@ void FileFlexNVMe::OpenChain(const std::string &name, Mode openMode,
                              const helper::Comm &chainComm, const bool async,
                              const bool directio)
 {
-    Open(name, openMode, async, directio);
+    int token = 1;
+    if (chainComm.Rank() > 0)
+    {
+        chainComm.Recv(&token, 1, chainComm.Rank() - 1, 0,
+                       "Chain token in FileFlexNVMe::OpenChain");
+    }
+
+    // Only the head of the chain truncates, the others write into the file
+    // it created
+    m_chainComm = chainComm.Size() > 1 ? &chainComm : nullptr;
+    OpenFile(name, openMode, async, chainComm.Rank() == 0);
+    if (m_chainComm && chainComm.Rank() == 0 && m_OpenMode == Mode::Write)
+    {
+        // Replaces any manifest left behind before the others open
+        WriteManifest();
+    }
+
+    if (chainComm.Rank() < chainComm.Size() - 1)
+    {
+        chainComm.Isend(&token, 1, chainComm.Rank() + 1, 0,
+                        "Sending Chain token in FileFlexNVMe::OpenChain");
+    }
 }
 
 void FileFlexNVMe::Write(const char *buffer, size_t size, size_t start)
 {
+    ClearPrefetch();
+
     if (start == MaxSizeT)
     {
         start = m_Cursor;
@@ -208,34 +443,148 @@ void FileFlexNVMe::Write(const char *buffer, size_t size, size_t start)
             break;
         }
 
-        std::string objectName = GenerateChunkName(curChunk);
-
-        uint64_t objectHandle = OpenFlanObject(
-            objectName, FLAN_OPEN_FLAG_CREATE | FLAN_OPEN_FLAG_WRITE);
-
-        if (flan_object_write(objectHandle, const_cast<char *>(writePointer),
-                              subOffset, subSize, FileFlexNVMe::flanh))
-        {
-            helper::Throw<std::runtime_error>(
-                "Toolkit", "transport::file::FileFlexNVMe", "Write",
-                "Failed to write chunk " + objectName);
-        }
-
-        CloseFlanObject(objectHandle);
+        WriteChunk(curChunk, writePointer, subOffset, subSize);
 
         curChunk++;
         writePointer += subSize;
     }
 
+    // The caller may reuse the buffer as soon as we return
+    WaitForPendingIO();
+
     m_Cursor += size;
 }
 
-#ifdef REALLY_WANT_WRITEV
 void FileFlexNVMe::WriteV(const core::iovec *iov, const int iovcnt,
                           size_t start)
 {
+    ClearPrefetch();
+
+    if (start == MaxSizeT)
+    {
+        start = m_Cursor;
+    }
+    else
+    {
+        m_Cursor = start;
+    }
+
+    // Segments of the iovec list that land in the current chunk, and where
+    // in the file the first of them starts
+    std::vector<core::iovec> pieces;
+    size_t piecesStart = start;
+    size_t curChunk = CalculateChunkLocation(start).chunkNum;
+
+    // Staging buffers for chunks gathered from several segments, they must
+    // outlive the requests writing them
+    std::vector<std::vector<char>> gathered;
+
+    auto lf_WritePieces = [&]() {
+        if (pieces.empty())
+        {
+            return;
+        }
+
+        const size_t chunkOffset =
+            CalculateChunkLocation(piecesStart).chunkOffset;
+
+        if (pieces.size() == 1)
+        {
+            // Contiguous in memory, write straight from the user buffer
+            WriteChunk(curChunk, static_cast<const char *>(pieces[0].iov_base),
+                       chunkOffset, pieces[0].iov_len);
+        }
+        else
+        {
+            size_t gatheredSize = 0;
+            for (const core::iovec &piece : pieces)
+            {
+                gatheredSize += piece.iov_len;
+            }
+
+            gathered.emplace_back(gatheredSize);
+            char *gatherPointer = gathered.back().data();
+            for (const core::iovec &piece : pieces)
+            {
+                std::memcpy(gatherPointer, piece.iov_base, piece.iov_len);
+                gatherPointer += piece.iov_len;
+            }
+
+            WriteChunk(curChunk, gathered.back().data(), chunkOffset,
+                       gatheredSize);
+        }
+
+        pieces.clear();
+    };
+
+    size_t position = start;
+    for (int c = 0; c < iovcnt; ++c)
+    {
+        const char *base = static_cast<const char *>(iov[c].iov_base);
+        size_t remaining = iov[c].iov_len;
+
+        // An iovec straddling chunk boundaries is split into one piece per
+        // chunk it touches
+        while (remaining > 0)
+        {
+            ChunkLocation loc = CalculateChunkLocation(position);
+            if (loc.chunkNum != curChunk)
+            {
+                lf_WritePieces();
+                curChunk = loc.chunkNum;
+                piecesStart = position;
+            }
+
+            const size_t pieceSize =
+                std::min(remaining, m_objectSize - loc.chunkOffset);
+            pieces.push_back({base, pieceSize});
+
+            base += pieceSize;
+            remaining -= pieceSize;
+            position += pieceSize;
+        }
+    }
+    lf_WritePieces();
+
+    // The caller may reuse the buffers as soon as we return
+    WaitForPendingIO();
+
+    m_Cursor = position;
+}
+
+void FileFlexNVMe::WriteChunk(size_t chunkNum, const char *buffer,
+                              size_t chunkOffset, size_t size)
+{
+    UpdateManifest(chunkNum, chunkOffset, size);
+
+    std::string objectName = GenerateChunkName(chunkNum);
+    FlanDevice *device = ChunkDevice(chunkNum);
+
+    uint64_t objectHandle = AcquireFlanObject(
+        device, objectName, FLAN_OPEN_FLAG_CREATE | FLAN_OPEN_FLAG_WRITE);
+
+    try
+    {
+        SubmitIO([device, objectHandle, objectName, buffer, chunkOffset,
+                  size]() {
+            if (flan_object_write(objectHandle, const_cast<char *>(buffer),
+                                  chunkOffset, size, device->handle))
+            {
+                helper::Throw<std::runtime_error>(
+                    "Toolkit", "transport::file::FileFlexNVMe", "Write",
+                    "Failed to write chunk " + objectName);
+            }
+        });
+    }
+    catch (...)
+    {
+        // Either this request failed or it was never submitted
+        DiscardFlanObject(device, objectHandle);
+        throw;
+    }
+
+    ReleaseFlanObject(device, objectHandle);
 }
-#endif
 
 void FileFlexNVMe::Read(char *buffer, size_t size, size_t start)
 {
@@ -253,6 +602,12 @@ void FileFlexNVMe::Read(char *buffer, size_t size, size_t start)
         return;
     }
 
+    if (ReadPrefetched(buffer, size, start))
+    {
+        m_Cursor += size;
+        return;
+    }
+
     ChunkLocation startLoc = CalculateChunkLocation(start);
     ChunkLocation endLoc = CalculateChunkLocation(start + size);
 
@@ -283,50 +638,129 @@ void FileFlexNVMe::Read(char *buffer, size_t size, size_t start)
         }
 
         std::string objectName = GenerateChunkName(curChunk);
+        FlanDevice *device = ChunkDevice(curChunk);
 
         // This will throw if the chunk doesn't exist
-        uint64_t objectHandle = OpenFlanObject(objectName);
-        ssize_t numBytesRead = flan_object_read(
-            objectHandle, readPointer, subOffset, subSize, FileFlexNVMe::flanh);
-        CloseFlanObject(objectHandle);
+        uint64_t objectHandle = AcquireFlanObject(device, objectName);
 
-        if (numBytesRead < subSize)
+        try
+        {
+            SubmitIO([this, device, objectHandle, readPointer, subOffset,
+                      subSize]() {
+                ssize_t numBytesRead =
+                    flan_object_read(objectHandle, readPointer, subOffset,
+                                     subSize, device->handle);
+
+                if (numBytesRead < static_cast<ssize_t>(subSize))
+                {
+                    helper::Throw<std::range_error>(
+                        "Toolkit", "transport::file::FileFlexNVMe", "Read",
+                        "Failed to read '" + m_Name +
+                            "' because more bytes were requested than were "
+                            "stored");
+                }
+            });
+        }
+        catch (...)
         {
-            helper::Throw<std::range_error>(
-                "Toolkit", "transport::file::FileFlexNVMe", "Read",
-                "Failed to read '" + m_Name +
-                    "' because more bytes were requested than were stored");
+            // Either this request failed or it was never submitted
+            DiscardFlanObject(device, objectHandle);
+            throw;
         }
 
+        ReleaseFlanObject(device, objectHandle);
+
         curChunk++;
         readPointer += subSize;
     }
 
+    WaitForPendingIO();
+
     m_Cursor += size;
 }
 
-// TODO: If there is a gap in chunks, the reported size is incorrect
-// TODO: If the chunk 0 is missing but data has been written to a non-zero
-// chunk, a not-found exception is thrown
+void FileFlexNVMe::Prefetch(
+    const std::vector<std::pair<size_t, size_t>> &ranges)
+{
+    ClearPrefetch();
+    if (m_prefetchDepth == 0)
+    {
+        return;
+    }
+
+    // One span per chunk covering every range in it, reading the gaps
+    // between nearby ranges costs less than another device request
+    for (const auto &range : ranges)
+    {
+        const size_t end = range.first + range.second;
+        size_t position = range.first;
+        while (position < end)
+        {
+            ChunkLocation loc = CalculateChunkLocation(position);
+            const size_t spanEnd =
+                std::min(m_objectSize, loc.chunkOffset + (end - position));
+
+            if (!m_prefetchQueue.empty() &&
+                m_prefetchQueue.back().chunkNum == loc.chunkNum)
+            {
+                PrefetchedChunk &span = m_prefetchQueue.back();
+                span.begin = std::min(span.begin, loc.chunkOffset);
+                span.end = std::max(span.end, spanEnd);
+            }
+            else
+            {
+                m_prefetchQueue.emplace_back();
+                PrefetchedChunk &span = m_prefetchQueue.back();
+                span.chunkNum = loc.chunkNum;
+                span.begin = loc.chunkOffset;
+                span.end = spanEnd;
+            }
+
+            position += spanEnd - loc.chunkOffset;
+        }
+    }
+
+    IssuePrefetches();
+}
+
 size_t FileFlexNVMe::GetSize()
 {
-    if (FileFlexNVMe::flanh == nullptr)
+    if (m_devices.empty())
     {
         helper::Throw<std::logic_error>(
             "Toolkit", "transport::file::FileFlexNVMe", "GetSize",
             "GetSize called before Open");
     }
 
-    struct flan_oinfo *objectInfo = nullptr;
-    int chunkNum = 0;
+    if (m_OpenMode != Mode::Read)
+    {
+        // We are the writer, so our in-memory manifest is up to date
+        return m_logicalSize;
+    }
+
+    // A writer may still be growing the file, re-read the manifest each time
+    if (ReadManifest(true))
+    {
+        return m_logicalSize;
+    }
+
+    return GetSizeFromChunks();
+}
+
+// Fallback for files written without a manifest
+// TODO: If there is a gap in chunks, the reported size is incorrect
+// TODO: If the chunk 0 is missing but data has been written to a non-zero
+// chunk, a not-found exception is thrown
+size_t FileFlexNVMe::GetSizeFromChunks()
+{
+    size_t chunkNum = 0;
     size_t totalSize = 0;
+    size_t chunkSize = 0;
 
-    // TODO(adbo): extract to function like GetChunkInfo(chunkName)
-    while ((objectInfo =
-                flan_find_oinfo(FileFlexNVMe::flanh,
-                                GenerateChunkName(chunkNum).c_str(), nullptr)))
+    while (FindFlanObject(ChunkDevice(chunkNum), GenerateChunkName(chunkNum),
+                          chunkSize))
     {
-        totalSize += objectInfo->size;
+        totalSize += chunkSize;
         chunkNum++;
     }
 
@@ -340,21 +774,95 @@ size_t FileFlexNVMe::GetSize()
     return totalSize;
 }
 
-void FileFlexNVMe::Flush() {}
+void FileFlexNVMe::Flush()
+{
+    WaitForPendingIO();
+    if (!m_chainComm)
+    {
+        // A shared manifest is only updated in chain order by Close
+        WriteManifest();
+    }
+    ClearObjectCache();
+}
 
 void FileFlexNVMe::Close()
 {
-    if (FileFlexNVMe::refCount <= 0)
+    ClearPrefetch();
+    if (m_IsOpen && m_chainComm)
+    {
+        // Each rank adds its chunks to the manifest in turn, so no update
+        // is lost to a concurrent read-modify-write. The token is passed on
+        // even on failure so the rest of the chain does not hang.
+        const helper::Comm &chainComm = *m_chainComm;
+        m_chainComm = nullptr;
+        std::exception_ptr error;
+        try
+        {
+            WaitForPendingIO();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        int token = 1;
+        if (chainComm.Rank() > 0)
+        {
+            chainComm.Recv(&token, 1, chainComm.Rank() - 1, 0,
+                           "Chain token in FileFlexNVMe::Close");
+        }
+        if (!error)
+        {
+            try
+            {
+                MergeManifest();
+                WriteManifest();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+        if (chainComm.Rank() < chainComm.Size() - 1)
+        {
+            chainComm.Isend(&token, 1, chainComm.Rank() + 1, 0,
+                            "Sending Chain token in FileFlexNVMe::Close");
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+    else
     {
-        flan_close(FileFlexNVMe::flanh);
-        FileFlexNVMe::flanh = nullptr;
+        WaitForPendingIO();
+        if (m_IsOpen)
+        {
+            WriteManifest();
+        }
     }
+    ClearObjectCache();
 
     m_IsOpen = false;
     m_Cursor = 0;
 }
 
-void FileFlexNVMe::Delete() {}
+void FileFlexNVMe::Delete()
+{
+    ClearPrefetch();
+    WaitForPendingIO();
+    if (m_OpenMode == Mode::Read)
+    {
+        // Only writers keep the chunk layout in memory
+        LoadChunkLayout();
+    }
+    DeleteFileObjects();
+    ClearObjectCache();
+
+    m_manifestDirty = false;
+    m_IsOpen = false;
+    m_Cursor = 0;
+}
 
 void FileFlexNVMe::SeekToEnd() { m_Cursor = GetSize(); }
 
@@ -372,8 +880,44 @@ void FileFlexNVMe::Seek(const size_t start)
     }
 }
 
-void FileFlexNVMe::Truncate(const size_t length) {}
+void FileFlexNVMe::Truncate(const size_t length)
+{
+    ClearPrefetch();
+    WaitForPendingIO();
+    m_logicalSize = length;
+
+    ChunkLocation endLoc = CalculateChunkLocation(length);
+    const size_t chunkCount = endLoc.chunkNum + (endLoc.chunkOffset > 0);
+    if (m_chunkSizes.size() > chunkCount)
+    {
+        // Free the objects past the new end, returning their capacity to
+        // the pool
+        DeleteChunks(chunkCount, m_chunkSizes.size());
+        m_chunkSizes.resize(chunkCount);
+    }
+    if (endLoc.chunkOffset > 0 && endLoc.chunkNum < m_chunkSizes.size())
+    {
+        m_chunkSizes[endLoc.chunkNum] =
+            std::min(m_chunkSizes[endLoc.chunkNum], endLoc.chunkOffset);
+    }
+
+    m_manifestDirty = true;
+}
 
+size_t FileFlexNVMe::GetPreferredBlockSize() const
+{
+    // lbaSize is set once at flan_init, no need for the registry lock
+    size_t blockSize = 0;
+    for (const FlanDevice *device : m_devices)
+    {
+        blockSize = std::max(blockSize, device->lbaSize);
+    }
+    return blockSize;
+}
+
+size_t FileFlexNVMe::GetPreferredStripeSize() const { return m_objectSize; }
+
+// Objects live in a flat namespace, there is nothing to create
 void FileFlexNVMe::MkDir(const std::string &fileName) {}
 
 std::string FileFlexNVMe::NormalisedObjectName(std::string &input)
@@ -397,17 +941,260 @@ std::string FileFlexNVMe::GenerateChunkName(size_t chunkNum)
     return base;
 }
 
+std::string FileFlexNVMe::GenerateManifestName()
+{
+    // '#' followed by a non-number never clashes with a chunk name
+    return m_baseName + "#manifest";
+}
+
+void FileFlexNVMe::UpdateManifest(size_t chunkNum, size_t chunkOffset,
+                                  size_t size)
+{
+    if (m_chunkSizes.size() <= chunkNum)
+    {
+        // Skipped chunks are recorded as empty
+        m_chunkSizes.resize(chunkNum + 1, 0);
+    }
+    m_chunkSizes[chunkNum] =
+        std::max(m_chunkSizes[chunkNum], chunkOffset + size);
+    m_logicalSize =
+        std::max(m_logicalSize, chunkNum * m_objectSize + chunkOffset + size);
+    m_manifestDirty = true;
+}
+
+void FileFlexNVMe::WriteManifest()
+{
+    if (!m_manifestDirty)
+    {
+        return;
+    }
+
+    std::vector<uint64_t> words = {ManifestMagic, m_logicalSize,
+                                   m_chunkSizes.size(), 0};
+    size_t chunkNum = 0;
+    while (chunkNum < m_chunkSizes.size())
+    {
+        size_t runEnd = chunkNum + 1;
+        while (runEnd < m_chunkSizes.size() &&
+               m_chunkSizes[runEnd] == m_chunkSizes[chunkNum])
+        {
+            runEnd++;
+        }
+        words.push_back(chunkNum);
+        words.push_back(runEnd - chunkNum);
+        words.push_back(m_chunkSizes[chunkNum]);
+        words[3]++;
+        chunkNum = runEnd;
+    }
+
+    const size_t manifestBytes = words.size() * sizeof(uint64_t);
+    if (manifestBytes > m_objectSize)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "transport::file::FileFlexNVMe", "WriteManifest",
+            "manifest of '" + m_Name + "' needs " +
+                std::to_string(manifestBytes) +
+                " bytes, more than object_size, file is too sparse");
+    }
+
+    std::string manifestName = GenerateManifestName();
+    FlanDevice *device = ManifestDevice();
+    uint64_t objectHandle = OpenFlanObject(
+        device, manifestName, FLAN_OPEN_FLAG_CREATE | FLAN_OPEN_FLAG_WRITE);
+    const int err = flan_object_write(objectHandle, words.data(), 0,
+                                      manifestBytes, device->handle);
+    CloseFlanObject(device, objectHandle);
+
+    if (err)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "transport::file::FileFlexNVMe", "WriteManifest",
+            "Failed to write manifest " + manifestName);
+    }
+
+    m_manifestDirty = false;
+}
+
+bool FileFlexNVMe::ReadManifest(const bool headerOnly)
+{
+    std::string manifestName = GenerateManifestName();
+    FlanDevice *device = ManifestDevice();
+    size_t manifestSize = 0;
+    if (!FindFlanObject(device, manifestName, manifestSize))
+    {
+        return false;
+    }
+
+    const size_t readBytes =
+        headerOnly ? ManifestHeaderWords * sizeof(uint64_t) : manifestSize;
+    std::vector<uint64_t> words(readBytes / sizeof(uint64_t));
+
+    uint64_t objectHandle = OpenFlanObject(device, manifestName);
+    ssize_t numBytesRead =
+        flan_object_read(objectHandle, words.data(), 0,
+                         words.size() * sizeof(uint64_t), device->handle);
+    CloseFlanObject(device, objectHandle);
+
+    if (words.size() < ManifestHeaderWords ||
+        numBytesRead < static_cast<ssize_t>(ManifestHeaderWords *
+                                            sizeof(uint64_t)) ||
+        words[0] != ManifestMagic)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "transport::file::FileFlexNVMe", "ReadManifest",
+            "manifest " + manifestName + " is corrupt");
+    }
+
+    m_logicalSize = words[1];
+    if (headerOnly)
+    {
+        return true;
+    }
+
+    const size_t runCount = words[3];
+    if (words.size() < ManifestHeaderWords + runCount * ManifestRunWords)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "transport::file::FileFlexNVMe", "ReadManifest",
+            "manifest " + manifestName + " is truncated");
+    }
+
+    m_chunkSizes.assign(words[2], 0);
+    for (size_t r = 0; r < runCount; ++r)
+    {
+        const uint64_t *run =
+            &words[ManifestHeaderWords + r * ManifestRunWords];
+        if (run[0] + run[1] > m_chunkSizes.size())
+        {
+            helper::Throw<std::runtime_error>(
+                "Toolkit", "transport::file::FileFlexNVMe", "ReadManifest",
+                "manifest " + manifestName + " is corrupt");
+        }
+        std::fill_n(m_chunkSizes.begin() + run[0], run[1], run[2]);
+    }
+
+    return true;
+}
+
+void FileFlexNVMe::MergeManifest()
+{
+    if (!m_manifestDirty)
+    {
+        return;
+    }
+
+    const size_t logicalSize = m_logicalSize;
+    std::vector<size_t> chunkSizes;
+    chunkSizes.swap(m_chunkSizes);
+    if (!ReadManifest(false))
+    {
+        m_chunkSizes.clear();
+    }
+
+    m_logicalSize = std::max(m_logicalSize, logicalSize);
+    if (m_chunkSizes.size() < chunkSizes.size())
+    {
+        m_chunkSizes.resize(chunkSizes.size(), 0);
+    }
+    for (size_t chunkNum = 0; chunkNum < chunkSizes.size(); ++chunkNum)
+    {
+        m_chunkSizes[chunkNum] =
+            std::max(m_chunkSizes[chunkNum], chunkSizes[chunkNum]);
+    }
+}
+
+void FileFlexNVMe::LoadChunkLayout()
+{
+    m_logicalSize = 0;
+    m_chunkSizes.clear();
+
+    if (ReadManifest(false))
+    {
+        return;
+    }
+
+    // Files written without a manifest are assumed to have no gaps
+    size_t chunkSize = 0;
+    while (FindFlanObject(ChunkDevice(m_chunkSizes.size()),
+                          GenerateChunkName(m_chunkSizes.size()), chunkSize))
+    {
+        m_chunkSizes.push_back(chunkSize);
+    }
+
+    if (!m_chunkSizes.empty())
+    {
+        m_logicalSize =
+            (m_chunkSizes.size() - 1) * m_objectSize + m_chunkSizes.back();
+    }
+}
+
+void FileFlexNVMe::DeleteChunks(size_t firstChunk, size_t endChunk)
+{
+    for (size_t chunkNum = firstChunk; chunkNum < endChunk; ++chunkNum)
+    {
+        DeleteFlanObject(ChunkDevice(chunkNum), GenerateChunkName(chunkNum));
+    }
+}
+
+void FileFlexNVMe::DeleteFileObjects()
+{
+    DeleteChunks(0, m_chunkSizes.size());
+    DeleteFlanObject(ManifestDevice(), GenerateManifestName());
+
+    m_logicalSize = 0;
+    m_chunkSizes.clear();
+}
+
+void FileFlexNVMe::DeleteFlanObject(FlanDevice *device,
+                                    const std::string &objectName)
+{
+    size_t objectSize = 0;
+    if (!FindFlanObject(device, objectName, objectSize))
+    {
+        // Never written, e.g. a gap in a sparse file
+        return;
+    }
+
+    auto it = m_objectCacheIndex.find(objectName);
+    if (it != m_objectCacheIndex.end())
+    {
+        CloseFlanObject(device, it->second->handle);
+        m_objectCache.erase(it->second);
+        m_objectCacheIndex.erase(it);
+    }
+
+    std::lock_guard<std::mutex> lock(device->metadataMutex);
+    if (flan_object_delete(objectName.c_str(), device->handle))
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "transport::file::FileFlexNVMe", "Delete",
+            "Failed to delete object " + objectName + ErrnoErrMsg());
+    }
+}
+
 inline auto FileFlexNVMe::CalculateChunkLocation(size_t offset) -> ChunkLocation
 {
     return {.chunkNum = offset / m_objectSize,
             .chunkOffset = offset % m_objectSize};
 }
 
-auto FileFlexNVMe::OpenFlanObject(std::string &objectName, int flags)
-    -> uint64_t
+auto FileFlexNVMe::ChunkDevice(size_t chunkNum) const -> FlanDevice *
+{
+    return m_devices[(chunkNum / m_stripeWidth) % m_devices.size()];
+}
+
+auto FileFlexNVMe::ManifestDevice() const -> FlanDevice *
 {
+    // Next to chunk 0, so unstriped files keep everything on one device
+    return ChunkDevice(0);
+}
+
+auto FileFlexNVMe::OpenFlanObject(FlanDevice *device, std::string &objectName,
+                                  int flags) -> uint64_t
+{
+    std::lock_guard<std::mutex> lock(device->metadataMutex);
     uint64_t objectHandle = 0;
-    if (flan_object_open(objectName.c_str(), FileFlexNVMe::flanh, &objectHandle,
+    if (flan_object_open(objectName.c_str(), device->handle, &objectHandle,
                          flags))
     {
         helper::Throw<std::invalid_argument>(
@@ -417,9 +1204,10 @@ auto FileFlexNVMe::OpenFlanObject(std::string &objectName, int flags)
     return objectHandle;
 }
 
-void FileFlexNVMe::CloseFlanObject(uint64_t objectHandle)
+void FileFlexNVMe::CloseFlanObject(FlanDevice *device, uint64_t objectHandle)
 {
-    if (flan_object_close(objectHandle, FileFlexNVMe::flanh))
+    std::lock_guard<std::mutex> lock(device->metadataMutex);
+    if (flan_object_close(objectHandle, device->handle))
     {
         helper::Throw<std::runtime_error>(
             "Toolkit", "transport::file::FileFlexNVMe", "CloseChunk",
@@ -427,5 +1215,305 @@ void FileFlexNVMe::CloseFlanObject(uint64_t objectHandle)
     }
 }
 
+auto FileFlexNVMe::FindFlanObject(FlanDevice *device,
+                                  const std::string &objectName,
+                                  size_t &objectSize) -> bool
+{
+    std::lock_guard<std::mutex> lock(device->metadataMutex);
+    struct flan_oinfo *objectInfo =
+        flan_find_oinfo(device->handle, objectName.c_str(), nullptr);
+    if (objectInfo == nullptr)
+    {
+        return false;
+    }
+    objectSize = static_cast<size_t>(objectInfo->size);
+    return true;
+}
+
+auto FileFlexNVMe::AcquireFlanObject(FlanDevice *device,
+                                     std::string &objectName, int flags)
+    -> uint64_t
+{
+    auto it = m_objectCacheIndex.find(objectName);
+    if (it != m_objectCacheIndex.end())
+    {
+        auto entry = it->second;
+        if ((entry->flags & flags) == flags)
+        {
+            m_objectCache.splice(m_objectCache.begin(), m_objectCache, entry);
+            m_Profiler.Count("object_cache_hits");
+            return entry->handle;
+        }
+
+        // Cached with insufficient flags (e.g. read-only and now we want to
+        // write), reopen with the union of both
+        WaitForPendingIO();
+        flags |= entry->flags;
+        CloseFlanObject(entry->device, entry->handle);
+        m_objectCache.erase(entry);
+        m_objectCacheIndex.erase(it);
+    }
+
+    m_Profiler.Count("object_cache_misses");
+    uint64_t objectHandle = OpenFlanObject(device, objectName, flags);
+
+    if (m_objectCacheSize == 0)
+    {
+        return objectHandle;
+    }
+
+    if (m_objectCache.size() >= m_objectCacheSize)
+    {
+        // The evicted handle may still be used by an in-flight request
+        WaitForPendingIO();
+    }
+
+    while (m_objectCache.size() >= m_objectCacheSize)
+    {
+        CachedObject &oldest = m_objectCache.back();
+        CloseFlanObject(oldest.device, oldest.handle);
+        m_objectCacheIndex.erase(oldest.name);
+        m_objectCache.pop_back();
+    }
+
+    m_objectCache.push_front({objectName, device, objectHandle, flags});
+    m_objectCacheIndex[objectName] = m_objectCache.begin();
+
+    return objectHandle;
+}
+
+void FileFlexNVMe::ReleaseFlanObject(FlanDevice *device,
+                                     uint64_t objectHandle)
+{
+    if (m_objectCacheSize == 0)
+    {
+        if (m_async)
+        {
+            m_uncachedHandles.emplace_back(device, objectHandle);
+        }
+        else
+        {
+            CloseFlanObject(device, objectHandle);
+        }
+    }
+}
+
+void FileFlexNVMe::DiscardFlanObject(FlanDevice *device,
+                                     uint64_t objectHandle) noexcept
+{
+    if (m_objectCacheSize == 0)
+    {
+        try
+        {
+            CloseFlanObject(device, objectHandle);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+void FileFlexNVMe::SubmitIO(std::function<void()> request)
+{
+    if (!m_async)
+    {
+        request();
+        return;
+    }
+
+    while (m_pendingIO.size() >= m_queueDepth)
+    {
+        std::future<void> oldest = std::move(m_pendingIO.front());
+        m_pendingIO.pop_front();
+        try
+        {
+            oldest.get();
+        }
+        catch (...)
+        {
+            // Settle the rest of the batch so no request is left behind to
+            // fail a later call, then report this first failure
+            std::exception_ptr error = std::current_exception();
+            try
+            {
+                WaitForPendingIO();
+            }
+            catch (...)
+            {
+            }
+            std::rethrow_exception(error);
+        }
+    }
+
+    m_pendingIO.push_back(std::async(std::launch::async, std::move(request)));
+}
+
+void FileFlexNVMe::WaitForPendingIO()
+{
+    // Every request is waited for and every handle closed even after a
+    // failure, only the first exception is rethrown
+    std::exception_ptr error;
+    while (!m_pendingIO.empty())
+    {
+        std::future<void> oldest = std::move(m_pendingIO.front());
+        m_pendingIO.pop_front();
+        try
+        {
+            oldest.get();
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    for (const auto &uncached : m_uncachedHandles)
+    {
+        try
+        {
+            CloseFlanObject(uncached.first, uncached.second);
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    m_uncachedHandles.clear();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void FileFlexNVMe::ClearObjectCache()
+{
+    for (const CachedObject &entry : m_objectCache)
+    {
+        CloseFlanObject(entry.device, entry.handle);
+    }
+    m_objectCache.clear();
+    m_objectCacheIndex.clear();
+}
+
+void FileFlexNVMe::IssuePrefetches()
+{
+    while (m_prefetched.size() < m_prefetchDepth && !m_prefetchQueue.empty())
+    {
+        m_prefetched.push_back(std::move(m_prefetchQueue.front()));
+        m_prefetchQueue.pop_front();
+
+        // Stays in place until its request completes, deque elements do
+        // not move when others are added or removed at the ends
+        PrefetchedChunk *chunk = &m_prefetched.back();
+        chunk->data.resize(chunk->end - chunk->begin);
+
+        std::string objectName = GenerateChunkName(chunk->chunkNum);
+        FlanDevice *device = ChunkDevice(chunk->chunkNum);
+
+        // Uses its own handle, cached ones may be closed by Reads meanwhile
+        chunk->ready = std::async(
+            std::launch::async, [this, device, objectName, chunk]() mutable {
+                uint64_t objectHandle = OpenFlanObject(device, objectName);
+                ssize_t numBytesRead =
+                    flan_object_read(objectHandle, chunk->data.data(),
+                                     chunk->begin, chunk->data.size(),
+                                     device->handle);
+                CloseFlanObject(device, objectHandle);
+
+                chunk->end =
+                    chunk->begin +
+                    (numBytesRead > 0 ? static_cast<size_t>(numBytesRead) : 0);
+            });
+    }
+}
+
+bool FileFlexNVMe::ReadPrefetched(char *buffer, size_t size, size_t start)
+{
+    if (m_prefetched.empty())
+    {
+        return false;
+    }
+
+    // Reads follow the hinted order, chunks before this one are done with
+    const size_t firstChunk = CalculateChunkLocation(start).chunkNum;
+    while (!m_prefetched.empty() && m_prefetched.front().chunkNum < firstChunk)
+    {
+        if (m_prefetched.front().ready.valid())
+        {
+            m_prefetched.front().ready.wait();
+        }
+        m_prefetched.pop_front();
+    }
+
+    bool hit = true;
+    size_t position = start;
+    const size_t end = start + size;
+    while (hit && position < end)
+    {
+        ChunkLocation loc = CalculateChunkLocation(position);
+        const size_t pieceEnd =
+            std::min(m_objectSize, loc.chunkOffset + (end - position));
+
+        auto it = std::find_if(m_prefetched.begin(), m_prefetched.end(),
+                               [&loc](const PrefetchedChunk &chunk) {
+                                   return chunk.chunkNum == loc.chunkNum;
+                               });
+        if (it == m_prefetched.end())
+        {
+            hit = false;
+            break;
+        }
+
+        if (!it->fetched)
+        {
+            try
+            {
+                it->ready.get();
+            }
+            catch (...)
+            {
+                // Leave it to the regular path to report the failure
+                it->end = it->begin;
+            }
+            it->fetched = true;
+        }
+
+        if (loc.chunkOffset < it->begin || pieceEnd > it->end)
+        {
+            hit = false;
+            break;
+        }
+
+        std::memcpy(buffer + (position - start),
+                    it->data.data() + (loc.chunkOffset - it->begin),
+                    pieceEnd - loc.chunkOffset);
+        position += pieceEnd - loc.chunkOffset;
+    }
+
+    m_Profiler.Count(hit ? "prefetch_hits" : "prefetch_misses");
+    IssuePrefetches();
+    return hit;
+}
+
+void FileFlexNVMe::ClearPrefetch() noexcept
+{
+    for (PrefetchedChunk &chunk : m_prefetched)
+    {
+        if (chunk.ready.valid())
+        {
+            chunk.ready.wait();
+        }
+    }
+    m_prefetched.clear();
+    m_prefetchQueue.clear();
+}
+
 } // end namespace transport
 } // end namespace adios2
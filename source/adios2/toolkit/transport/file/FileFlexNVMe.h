@@ -12,7 +12,13 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_FILE_FLEXNVME_H_
 
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <future> //std::async, std::future
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/common/ADIOSTypes.h"
@@ -35,7 +41,58 @@ struct ChunkLocation
     size_t chunkOffset;
 };
 
-/** File descriptor transport using the xNVME IO library */
+/** A flan device shared by all transports of the process */
+struct FlanDevice
+{
+    std::string url;
+    struct flan_handle *handle;
+    /* Pool and object size the device was initialised with */
+    std::string poolName;
+    size_t objectSize;
+    /* Logical block size, 0 if unknown */
+    size_t lbaSize;
+    /* Number of transports holding the device, guarded by the registry */
+    int refCount;
+    /* Serialises object lookup, open, close and delete, which modify the
+     * device's object table. Object reads and writes do not take it */
+    std::mutex metadataMutex;
+};
+
+/** Part of a chunk read ahead of the Read asking for it */
+struct PrefetchedChunk
+{
+    size_t chunkNum;
+    /* Range within the chunk held in data, end is cut short if the chunk
+     * holds less */
+    size_t begin;
+    size_t end;
+    std::vector<char> data;
+    std::future<void> ready;
+    bool fetched = false;
+};
+
+/** An open flan object handle kept around for reuse between calls */
+struct CachedObject
+{
+    std::string name;
+    FlanDevice *device;
+    uint64_t handle;
+    int flags;
+};
+
+/**
+ * File descriptor transport using the xNVME IO library.
+ * When opened with async = true, the chunks touched by a single Write/Read
+ * are transferred concurrently, with at most queue_depth requests in flight.
+ * device_url may list several comma separated devices, chunks are then
+ * striped over them stripe_width chunks at a time.
+ * Files opened with FileRole=metadata take metadata_device_url,
+ * metadata_pool_name and metadata_object_size when set, so small metadata
+ * files do not each occupy a large data object.
+ * Devices are shared between transports, so several transports (e.g. the
+ * per-thread ones of BP5Reader) may be used concurrently. A single
+ * transport must not be used from several threads at once
+ */
 class FileFlexNVMe : public Transport
 {
 
@@ -55,17 +112,22 @@ public:
 
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
-#ifdef REALLY_WANT_WRITEV
-    /* Actual writev() function, inactive for now */
+    /** Issues one object write per chunk, gathering the iovec segments
+     * that land in the same chunk */
     void WriteV(const core::iovec *iov, const int iovcnt,
                 size_t start = MaxSizeT) final;
-#endif
 
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /** Coalesces the ranges into one read per chunk and keeps up to
+     * prefetch_depth of them in flight ahead of the Reads */
+    void
+    Prefetch(const std::vector<std::pair<size_t, size_t>> &ranges) final;
+
     size_t GetSize() final;
 
-    /** Does nothing, each write is supposed to flush */
+    /** Waits for in-flight requests, persists the manifest and closes all
+     * cached object handles */
     void Flush() final;
 
     void Close() final;
@@ -82,27 +144,152 @@ public:
 
     void MkDir(const std::string &fileName) final;
 
+    /** Largest logical block size of the devices */
+    size_t GetPreferredBlockSize() const final;
+
+    /** Object size, each object holds one chunk of the file */
+    size_t GetPreferredStripeSize() const final;
+
     auto GenerateChunkName(size_t chunkNum) -> std::string;
 
 private:
     std::string m_deviceUrl = "";
+    std::vector<std::string> m_deviceUrls;
+    /* Number of consecutive chunks placed on a device before moving on */
+    size_t m_stripeWidth = 1;
+    /* Handles of m_deviceUrls, acquired at the first Open */
+    std::vector<FlanDevice *> m_devices;
     std::string m_baseName = "";
     std::string m_poolName;
+    /* Opened with FileRole=metadata, the metadata_* parameters apply */
+    bool m_isMetadata = false;
 
     size_t m_chunkWrites = 0;
     size_t m_objectSize = 0;
 
-    static struct flan_handle *flanh;
-    static int refCount;
+    /* LRU cache of open object handles, most recently used at the front.
+     * Bounded by the object_cache_size parameter, 0 disables caching */
+    size_t m_objectCacheSize = 16;
+    std::list<CachedObject> m_objectCache;
+    std::unordered_map<std::string, std::list<CachedObject>::iterator>
+        m_objectCacheIndex;
+
+    /* Async mode, set at Open, and the maximum number of chunk requests
+     * in flight at once */
+    bool m_async = false;
+    size_t m_queueDepth = 8;
+    std::deque<std::future<void>> m_pendingIO;
+    /* Handles to close once m_pendingIO drains, when caching is disabled */
+    std::vector<std::pair<FlanDevice *, uint64_t>> m_uncachedHandles;
+
+    /* Read-ahead from Prefetch hints, in read order: chunk ranges not yet
+     * fetched, and those fetched or in flight, at most m_prefetchDepth.
+     * A prefetch_depth of 0 disables read-ahead */
+    size_t m_prefetchDepth = 4;
+    std::deque<PrefetchedChunk> m_prefetchQueue;
+    std::deque<PrefetchedChunk> m_prefetched;
+
+    /* Devices initialised by this process keyed by url, shared by all
+     * transports and closed when the last one holding them is destroyed.
+     * Guarded by devicesMutex */
+    static std::unordered_map<std::string, std::unique_ptr<FlanDevice>>
+        devices;
+    static std::mutex devicesMutex;
 
     size_t m_Cursor;
 
+    /* Per-file manifest, stored in its own object next to the chunks so
+     * GetSize is a single object read instead of a scan over all chunks */
+    size_t m_logicalSize = 0;
+    std::vector<size_t> m_chunkSizes;
+    bool m_manifestDirty = false;
+    /* Set when the file is shared by a chain of ranks opened with
+     * OpenChain, their manifest updates are merged in chain order */
+    const helper::Comm *m_chainComm = nullptr;
+
     auto ErrnoErrMsg() const -> std::string;
 
-    void InitFlan(const std::string &name);
+    /* Opens the file, only deleting existing objects in Write mode if
+     * truncate is set */
+    void OpenFile(const std::string &name, const Mode openMode,
+                  const bool async, const bool truncate);
+
+    /* Acquires m_devices from the registry, initialising flan on devices
+     * not yet open in this process */
+    void InitDevices();
+    /* Gives back m_devices, closing those no other transport holds */
+    void ReleaseDevices() noexcept;
+    auto InitFlan(const std::string &deviceUrl) -> std::unique_ptr<FlanDevice>;
+    /* Device holding chunk chunkNum */
+    auto ChunkDevice(size_t chunkNum) const -> FlanDevice *;
+    /* Device holding the manifest */
+    auto ManifestDevice() const -> FlanDevice *;
+
     auto NormalisedObjectName(std::string &input) -> std::string;
-    auto OpenFlanObject(std::string &objectName, int flags = FLAN_OPEN_FLAG_READ) -> uint64_t;
-    void CloseFlanObject(uint64_t objectHandle);
+    auto OpenFlanObject(FlanDevice *device, std::string &objectName,
+                        int flags = FLAN_OPEN_FLAG_READ) -> uint64_t;
+    void CloseFlanObject(FlanDevice *device, uint64_t objectHandle);
+    /* Looks up the stored size of objectName, returns false if it does not
+     * exist */
+    auto FindFlanObject(FlanDevice *device, const std::string &objectName,
+                        size_t &objectSize) -> bool;
+
+    /* Returns an open handle for objectName opened with at least flags,
+     * reusing a cached handle when possible */
+    auto AcquireFlanObject(FlanDevice *device, std::string &objectName,
+                           int flags = FLAN_OPEN_FLAG_READ) -> uint64_t;
+    /* Gives back a handle obtained from AcquireFlanObject, closing it if
+     * caching is disabled */
+    void ReleaseFlanObject(FlanDevice *device, uint64_t objectHandle);
+    /* Like ReleaseFlanObject for a handle no request will use, closing
+     * it right away and ignoring close errors */
+    void DiscardFlanObject(FlanDevice *device, uint64_t objectHandle) noexcept;
+    /* Runs request inline, or on a worker in async mode, waiting for the
+     * oldest request first when the queue depth is reached. If that one
+     * failed, waits for the rest and rethrows without running request */
+    void SubmitIO(std::function<void()> request);
+    /* Waits for all in-flight requests and closes uncached handles, then
+     * rethrows the first failure */
+    void WaitForPendingIO();
+    /* Closes and forgets every cached object handle */
+    void ClearObjectCache();
+
+    /* Starts fetching queued chunk ranges while fewer than m_prefetchDepth
+     * are held */
+    void IssuePrefetches();
+    /* Serves a Read from prefetched chunks, returns false if any part of it
+     * was not prefetched */
+    auto ReadPrefetched(char *buffer, size_t size, size_t start) -> bool;
+    /* Waits for in-flight read-ahead and drops everything prefetched */
+    void ClearPrefetch() noexcept;
+
+    /* Writes size bytes at chunkOffset within chunk chunkNum, through
+     * SubmitIO */
+    void WriteChunk(size_t chunkNum, const char *buffer, size_t chunkOffset,
+                    size_t size);
+
+    auto GenerateManifestName() -> std::string;
+    /* Records a write of size bytes at chunkOffset within chunk chunkNum */
+    void UpdateManifest(size_t chunkNum, size_t chunkOffset, size_t size);
+    /* Persists the manifest if it changed since it was last written */
+    void WriteManifest();
+    /* Folds the stored manifest into the layout written by this rank */
+    void MergeManifest();
+    /* Loads the manifest (only the logical size if headerOnly), returns
+     * false if the file has none */
+    auto ReadManifest(const bool headerOnly) -> bool;
+    /* Sums chunk sizes one lookup at a time, for files without a manifest */
+    auto GetSizeFromChunks() -> size_t;
+    /* Loads the chunk layout of an existing file, from its manifest or by
+     * probing chunks */
+    void LoadChunkLayout();
+
+    /* Deletes the existing chunk objects in [firstChunk, endChunk) */
+    void DeleteChunks(size_t firstChunk, size_t endChunk);
+    /* Deletes all chunks of the file and its manifest */
+    void DeleteFileObjects();
+    /* Deletes an object if it exists, closing any cached handle to it */
+    void DeleteFlanObject(FlanDevice *device, const std::string &objectName);
 
     /* Given a overall offset, calculate which chunk that position corresponds
      * to, and what the offset is within that chunk */
@@ -90,25 +90,25 @@ void FileIME::Open(const std::string &name, const Mode openMode,
     switch (m_OpenMode)
     {
     case Mode::Write:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileDescriptor = ime_client_native2_open(
             m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileDescriptor =
             ime_client_native2_open(m_Name.c_str(), O_RDWR | O_CREAT, 0777);
         lseek(m_FileDescriptor, 0, SEEK_END);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_FileDescriptor =
             ime_client_native2_open(m_Name.c_str(), O_RDONLY, 0000);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -137,10 +137,10 @@ void FileIME::Write(const char *buffer, size_t size, size_t start)
     auto lf_Write = [&](const char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("write");
+            ProfilerStart(ProfileWrite);
             const auto writtenSize =
                 ime_client_native2_write(m_FileDescriptor, buffer, size);
-            ProfilerStop("write");
+            ProfilerStop(ProfileWrite);
 
             if (writtenSize == -1)
             {
@@ -197,10 +197,10 @@ void FileIME::Read(char *buffer, size_t size, size_t start)
     auto lf_Read = [&](char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("read");
+            ProfilerStart(ProfileRead);
             const auto readSize =
                 ime_client_native2_read(m_FileDescriptor, buffer, size);
-            ProfilerStop("read");
+            ProfilerStop(ProfileRead);
 
             if (readSize == -1)
             {
@@ -275,14 +275,14 @@ void FileIME::Flush()
 
 void FileIME::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     if (m_SyncToPFS)
     {
         ime_client_native2_fsync(m_FileDescriptor);
         ime_client_native2_bfs_sync(m_FileDescriptor, true);
     }
     const int status = ime_client_native2_close(m_FileDescriptor);
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 
     if (status == -1)
     {
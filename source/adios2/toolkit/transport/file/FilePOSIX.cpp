@@ -79,12 +79,12 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
 {
     auto lf_AsyncOpenWrite = [&](const std::string &name,
                                  const bool directio) -> int {
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         int flag = __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio);
         int FD = open(m_Name.c_str(), flag, 0666);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         return FD;
     };
 
@@ -104,32 +104,32 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         }
         else
         {
-            ProfilerStart("open");
+            ProfilerStart(ProfileOpen);
             errno = 0;
             m_FileDescriptor = open(
                 m_Name.c_str(),
                 __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio), 0666);
             m_Errno = errno;
-            ProfilerStop("open");
+            ProfilerStop(ProfileOpen);
         }
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         m_FileDescriptor = open(
             m_Name.c_str(), __GetOpenFlag(O_RDWR | O_CREAT, directio), 0777);
         lseek(m_FileDescriptor, 0, SEEK_END);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -150,12 +150,12 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
 {
     auto lf_AsyncOpenWrite = [&](const std::string &name,
                                  const bool directio) -> int {
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         int flag = __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio);
         int FD = open(m_Name.c_str(), flag, 0666);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         return FD;
     };
 
@@ -185,7 +185,7 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
         }
         else
         {
-            ProfilerStart("open");
+            ProfilerStart(ProfileOpen);
             errno = 0;
             if (chainComm.Rank() == 0)
             {
@@ -201,12 +201,12 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
                 lseek(m_FileDescriptor, 0, SEEK_SET);
             }
             m_Errno = errno;
-            ProfilerStop("open");
+            ProfilerStop(ProfileOpen);
         }
         break;
 
     case Mode::Append:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         if (chainComm.Rank() == 0)
         {
@@ -221,15 +221,15 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
         }
         lseek(m_FileDescriptor, 0, SEEK_END);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case Mode::Read:
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         errno = 0;
         m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
         m_Errno = errno;
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -255,11 +255,11 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     auto lf_Write = [&](const char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("write");
+            ProfilerStart(ProfileWrite);
             errno = 0;
             const auto writtenSize = write(m_FileDescriptor, buffer, size);
             m_Errno = errno;
-            ProfilerStop("write");
+            ProfilerStop(ProfileWrite);
 
             if (writtenSize == -1)
             {
@@ -322,7 +322,7 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
 void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
 {
     auto lf_Write = [&](const core::iovec *iov, const int iovcnt) {
-        ProfilerStart("write");
+        ProfilerStart(ProfileWrite);
         errno = 0;
         size_t nBytesExpected = 0;
         for (int i = 0; i < iovcnt; ++i)
@@ -332,7 +332,7 @@ void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
         const iovec *v = reinterpret_cast<const iovec *>(iov);
         const auto ret = writev(m_FileDescriptor, v, iovcnt);
         m_Errno = errno;
-        ProfilerStop("write");
+        ProfilerStop(ProfileWrite);
 
         size_t written;
         if (ret == -1)
@@ -417,11 +417,11 @@ void FilePOSIX::Read(char *buffer, size_t size, size_t start)
     auto lf_Read = [&](char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("read");
+            ProfilerStart(ProfileRead);
             errno = 0;
             const auto readSize = read(m_FileDescriptor, buffer, size);
             m_Errno = errno;
-            ProfilerStop("read");
+            ProfilerStop(ProfileRead);
 
             if (readSize == -1)
             {
@@ -508,11 +508,11 @@ void FilePOSIX::Flush()
 void FilePOSIX::Close()
 {
     WaitForOpen();
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     errno = 0;
     const int status = close(m_FileDescriptor);
     m_Errno = errno;
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 
     if (status == -1)
     {
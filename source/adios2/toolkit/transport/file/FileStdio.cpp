@@ -216,10 +216,10 @@ void FileStdio::SetBuffer(char *buffer, size_t size)
 void FileStdio::Write(const char *buffer, size_t size, size_t start)
 {
     auto lf_Write = [&](const char *buffer, size_t size) {
-        ProfilerStart("write");
+        ProfilerStart(ProfileWrite);
         const auto writtenSize =
             std::fwrite(buffer, sizeof(char), size, m_File);
-        ProfilerStop("write");
+        ProfilerStop(ProfileWrite);
 
         CheckFile("couldn't write to file " + m_Name +
                   ", in call to stdio fwrite");
@@ -273,9 +273,9 @@ void FileStdio::Write(const char *buffer, size_t size, size_t start)
 void FileStdio::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
-        ProfilerStart("read");
+        ProfilerStart(ProfileRead);
         const auto readSize = std::fread(buffer, sizeof(char), size, m_File);
-        ProfilerStop("read");
+        ProfilerStop(ProfileRead);
 
         CheckFile("couldn't read to file " + m_Name +
                   ", in call to stdio fread");
@@ -348,9 +348,9 @@ size_t FileStdio::GetSize()
 void FileStdio::Flush()
 {
     WaitForOpen();
-    ProfilerStart("write");
+    ProfilerStart(ProfileWrite);
     const int status = std::fflush(m_File);
-    ProfilerStop("write");
+    ProfilerStop(ProfileWrite);
 
     if (status == EOF)
     {
@@ -363,9 +363,9 @@ void FileStdio::Flush()
 void FileStdio::Close()
 {
     WaitForOpen();
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     const int status = std::fclose(m_File);
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
 
     if (status == EOF)
     {
@@ -41,11 +41,11 @@ void NullTransport::Open(const std::string &name, const Mode openMode,
                                           "Open", "transport is already open");
     }
 
-    ProfilerStart("open");
+    ProfilerStart(ProfileOpen);
     Impl->IsOpen = true;
     Impl->CurPos = 0;
     Impl->Capacity = 0;
-    ProfilerStop("open");
+    ProfilerStop(ProfileOpen);
 }
 
 void NullTransport::SetBuffer(char *buffer, size_t size) { return; }
@@ -58,13 +58,13 @@ void NullTransport::Write(const char *buffer, size_t size, size_t start)
                                           "Write", "transport is not open yet");
     }
 
-    ProfilerStart("write");
+    ProfilerStart(ProfileWrite);
     Impl->CurPos = start + size;
     if (Impl->CurPos > Impl->Capacity)
     {
         Impl->Capacity = Impl->CurPos;
     }
-    ProfilerStop("write");
+    ProfilerStop(ProfileWrite);
 }
 
 void NullTransport::Read(char *buffer, size_t size, size_t start)
@@ -75,7 +75,7 @@ void NullTransport::Read(char *buffer, size_t size, size_t start)
                                           "Read", "transport is not open yet");
     }
 
-    ProfilerStart("read");
+    ProfilerStart(ProfileRead);
     if (start + size > Impl->Capacity)
     {
         helper::Throw<std::out_of_range>("Toolkit", "transport::NullTransport",
@@ -83,7 +83,7 @@ void NullTransport::Read(char *buffer, size_t size, size_t start)
     }
     std::memset(buffer, 0, size);
     Impl->CurPos = start + size;
-    ProfilerStop("read");
+    ProfilerStop(ProfileRead);
 }
 
 size_t NullTransport::GetSize() { return Impl->Capacity; }
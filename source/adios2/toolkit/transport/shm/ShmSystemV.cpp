@@ -61,21 +61,21 @@ void ShmSystemV::Open(const std::string &name, const Mode openMode,
     switch (m_OpenMode)
     {
     case (Mode::Write):
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_ShmID = shmget(key, m_Size, IPC_CREAT | 0666);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case (Mode::Append):
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_ShmID = shmget(key, m_Size, 0);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     case (Mode::Read):
-        ProfilerStart("open");
+        ProfilerStart(ProfileOpen);
         m_ShmID = shmget(key, m_Size, 0);
-        ProfilerStop("open");
+        ProfilerStop(ProfileOpen);
         break;
 
     default:
@@ -94,24 +94,24 @@ void ShmSystemV::Open(const std::string &name, const Mode openMode,
 void ShmSystemV::Write(const char *buffer, size_t size, size_t start)
 {
     CheckSizes(size, start, "in call to Write");
-    ProfilerStart("write");
+    ProfilerStart(ProfileWrite);
     std::memcpy(&m_Buffer[start], buffer, size);
-    ProfilerStop("write");
+    ProfilerStop(ProfileWrite);
 }
 
 void ShmSystemV::Read(char *buffer, size_t size, size_t start)
 {
     CheckSizes(size, start, "in call to Read");
-    ProfilerStart("read");
+    ProfilerStart(ProfileRead);
     std::memcpy(buffer, &m_Buffer[start], size);
-    ProfilerStop("read");
+    ProfilerStop(ProfileRead);
 }
 
 void ShmSystemV::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(ProfileClose);
     int result = shmdt(m_Buffer);
-    ProfilerStop("close");
+    ProfilerStop(ProfileClose);
     if (result < 1)
     {
         helper::Throw<std::ios_base::failure>(
@@ -122,9 +122,9 @@ void ShmSystemV::Close()
 
     if (m_RemoveAtClose)
     {
-        ProfilerStart("close");
+        ProfilerStart(ProfileClose);
         const int remove = shmctl(m_ShmID, IPC_RMID, NULL);
-        ProfilerStop("close");
+        ProfilerStop(ProfileClose);
         if (remove < 1)
         {
             helper::Throw<std::ios_base::failure>(
@@ -10,6 +10,7 @@
 
 #include "TransportMan.h"
 
+#include <algorithm> //std::max
 #include <ios>
 #include <iostream>
 #include <set>
@@ -417,6 +418,28 @@ size_t TransportMan::GetFileSize(const size_t transportIndex) const
     return itTransport->second->GetSize();
 }
 
+size_t TransportMan::GetPreferredBlockSize() const noexcept
+{
+    size_t blockSize = 0;
+    for (const auto &transportPair : m_Transports)
+    {
+        blockSize =
+            std::max(blockSize, transportPair.second->GetPreferredBlockSize());
+    }
+    return blockSize;
+}
+
+size_t TransportMan::GetPreferredStripeSize() const noexcept
+{
+    size_t stripeSize = 0;
+    for (const auto &transportPair : m_Transports)
+    {
+        stripeSize = std::max(stripeSize,
+                              transportPair.second->GetPreferredStripeSize());
+    }
+    return stripeSize;
+}
+
 void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
                             const size_t transportIndex)
 {
@@ -426,6 +449,16 @@ void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
     itTransport->second->Read(buffer, size, start);
 }
 
+void TransportMan::PrefetchFile(
+    const std::vector<std::pair<size_t, size_t>> &ranges,
+    const size_t transportIndex)
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to PrefetchFile with index " +
+                               std::to_string(transportIndex));
+    itTransport->second->Prefetch(ranges);
+}
+
 void TransportMan::FlushFiles(const int transportIndex)
 {
     if (transportIndex == -1)
@@ -653,6 +686,13 @@ std::shared_ptr<Transport> TransportMan::OpenFileTransport(
         return helper::StringToTimeUnit(profileUnits);
     };
 
+    auto lf_GetProfileTrace = [&](const std::string defaultValue,
+                                  const Params &parameters) -> bool {
+        std::string trace = defaultValue;
+        helper::SetParameterValue("profiletrace", parameters, trace);
+        return helper::StringTo<bool>(trace, "");
+    };
+
     auto lf_GetAsyncOpen = [&](const std::string defaultAsync,
                                const Params &parameters) -> bool {
         std::string AsyncOpen = defaultAsync;
@@ -677,7 +717,8 @@ std::shared_ptr<Transport> TransportMan::OpenFileTransport(
     if (profile)
     {
         transport->InitProfiler(openMode,
-                                lf_GetTimeUnits(DefaultTimeUnit, parameters));
+                                lf_GetTimeUnits(DefaultTimeUnit, parameters),
+                                lf_GetProfileTrace("false", parameters));
     }
 
     transport->SetParameters(parameters);
@@ -168,6 +168,18 @@ public:
 
     size_t GetFileSize(const size_t transportIndex = 0) const;
 
+    /**
+     * Largest preferred write block size among the open transports
+     * @return block size in bytes, 0 if no transport has a preference
+     */
+    size_t GetPreferredBlockSize() const noexcept;
+
+    /**
+     * Largest preferred stripe size among the open transports
+     * @return stripe size in bytes, 0 if no transport has a preference
+     */
+    size_t GetPreferredStripeSize() const noexcept;
+
     /**
      * Read contents from a single file and assign it to buffer
      * @param buffer
@@ -178,6 +190,14 @@ public:
     void ReadFile(char *buffer, const size_t size, const size_t start = 0,
                   const size_t transportIndex = 0);
 
+    /**
+     * Announces upcoming reads from a single file, see Transport::Prefetch
+     * @param ranges (start, size) pairs sorted by start
+     * @param transportIndex
+     */
+    void PrefetchFile(const std::vector<std::pair<size_t, size_t>> &ranges,
+                      const size_t transportIndex = 0);
+
     /**
      * Flush file or files depending on transport index. Throws an exception
      * if transport is not a file when transportIndex > -1.
@@ -197,6 +197,85 @@ TEST_P(BPAppendAfterStepsP, Test)
 #endif
 }
 
+TEST_F(BPAppendAfterSteps, BurstBuffer)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    /* The first run goes through the burst buffer, appending with a burst
+     * buffer path must write to the target directly and keep the first
+     * steps */
+    const std::string filename =
+        "AppendBurstBuffer_N" + std::to_string(mpiSize) + ".bp";
+    const size_t nSteps = 2;
+
+    adios2::IO ioWrite = adios.DeclareIO("TestIOWriteBB");
+    ioWrite.SetEngine(engineName);
+    ioWrite.SetParameter("BurstBufferPath", "bb");
+    adios2::Dims shape{static_cast<unsigned int>(mpiSize * Nx)};
+    adios2::Dims start{static_cast<unsigned int>(mpiRank * Nx)};
+    adios2::Dims count{static_cast<unsigned int>(Nx)};
+    auto var0 = ioWrite.DefineVariable<int32_t>("var", shape, start, count);
+    auto var1 = ioWrite.DefineVariable<size_t>("step");
+
+    for (const adios2::Mode mode : {adios2::Mode::Write, adios2::Mode::Append})
+    {
+        const size_t beginStep = (mode == adios2::Mode::Write ? 0 : nSteps);
+        adios2::Engine engine = ioWrite.Open(filename, mode);
+        for (size_t step = beginStep; step < beginStep + nSteps; ++step)
+        {
+            auto d = GenerateData(step, mpiRank, mpiSize);
+            engine.BeginStep();
+            engine.Put(var0, d.data());
+            engine.Put(var1, step);
+            engine.EndStep();
+        }
+        engine.Close();
+#if ADIOS2_USE_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    }
+
+    adios2::IO ioRead = adios.DeclareIO("TestIOReadBB");
+    ioRead.SetEngine(engineName);
+    adios2::Engine engine_s =
+        ioRead.Open(filename, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(engine_s.Steps(), 2 * nSteps);
+
+    adios2::Variable<int> var = ioRead.InquireVariable<int32_t>("var");
+    adios2::Variable<size_t> varStep = ioRead.InquireVariable<size_t>("step");
+    ASSERT_TRUE(var);
+    ASSERT_TRUE(varStep);
+    for (size_t readStep = 0; readStep < 2 * nSteps; readStep++)
+    {
+        var.SetStepSelection(adios2::Box<size_t>(readStep, 1));
+        var.SetSelection({{Nx * mpiRank}, {Nx}});
+        std::vector<int> res;
+        engine_s.Get<int>(var, res, adios2::Mode::Sync);
+        auto d = GenerateData(readStep, mpiRank, mpiSize);
+        EXPECT_EQ(ArrayToString(res.data(), res.size()),
+                  ArrayToString(d.data(), d.size()));
+
+        varStep.SetStepSelection(adios2::Box<size_t>(readStep, 1));
+        size_t stepInFile;
+        engine_s.Get<size_t>(varStep, stepInFile);
+        EXPECT_EQ(stepInFile, readStep);
+    }
+    engine_s.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
 INSTANTIATE_TEST_SUITE_P(
     BPAppendAfterSteps, BPAppendAfterStepsP,
     ::testing::Values(std::make_tuple(1, 0), std::make_tuple(1, 1),
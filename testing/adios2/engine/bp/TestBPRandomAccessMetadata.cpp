@@ -0,0 +1,166 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Test "MaxMetadataStepsInMemory" parameter for reading a BP file in random
+ * access mode
+ */
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+constexpr std::size_t NSteps = 12;
+constexpr std::size_t Nx = 8;
+
+// MaxMetadataStepsInMemory
+using ParamType = std::size_t;
+
+class BPRandomAccessMetadataTest : public ::testing::TestWithParam<ParamType>
+{
+public:
+    BPRandomAccessMetadataTest() = default;
+
+    static int32_t Value(std::size_t step, std::size_t i)
+    {
+        return static_cast<int32_t>(step * 100 + i);
+    }
+
+    void CreateOutput(const std::string &fname)
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("TestIOWrite");
+        io.SetEngine(engineName);
+        io.DefineAttribute<std::string>("note", "random access");
+        auto g = io.DefineVariable<int32_t>("g", {Nx}, {0}, {Nx / 2});
+        auto s = io.DefineVariable<int32_t>("s");
+        auto e = io.DefineVariable<int32_t>("e", {Nx}, {0}, {Nx});
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (std::size_t step = 0; step < NSteps; ++step)
+        {
+            std::vector<int32_t> data(Nx);
+            for (std::size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = Value(step, i);
+            }
+            const int32_t value = static_cast<int32_t>(step);
+
+            writer.BeginStep();
+            // two blocks per step
+            g.SetSelection({{0}, {Nx / 2}});
+            writer.Put(g, data.data(), adios2::Mode::Sync);
+            g.SetSelection({{Nx / 2}, {Nx / 2}});
+            writer.Put(g, data.data() + Nx / 2, adios2::Mode::Sync);
+            writer.Put(s, value, adios2::Mode::Sync);
+            if (step % 2 == 0)
+            {
+                writer.Put(e, data.data(), adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+};
+
+TEST_P(BPRandomAccessMetadataTest, ReadStepsOutOfOrder)
+{
+    const std::string fname =
+        "BPRandomAccessMetadata" + std::to_string(GetParam()) + ".bp";
+    CreateOutput(fname);
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("TestIORead");
+    io.SetEngine(engineName);
+    io.SetParameter("MaxMetadataStepsInMemory", std::to_string(GetParam()));
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+
+    auto attr = io.InquireAttribute<std::string>("note");
+    ASSERT_TRUE(attr);
+    EXPECT_EQ(attr.Data().front(), "random access");
+
+    auto g = io.InquireVariable<int32_t>("g");
+    auto s = io.InquireVariable<int32_t>("s");
+    auto e = io.InquireVariable<int32_t>("e");
+    ASSERT_TRUE(g);
+    ASSERT_TRUE(s);
+    ASSERT_TRUE(e);
+    EXPECT_EQ(g.Steps(), NSteps);
+    EXPECT_EQ(e.Steps(), NSteps / 2);
+
+    // revisits steps long evicted with a small limit
+    const std::vector<std::size_t> steps = {7,  0, 11, 3, 3, 9, 1,
+                                            10, 5, 2,  8, 4, 6, 0};
+    for (const auto step : steps)
+    {
+        g.SetStepSelection({step, 1});
+        EXPECT_EQ(g.Shape(), adios2::Dims({Nx}));
+        std::vector<int32_t> data;
+        reader.Get(g, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), Nx);
+        for (std::size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(data[i], Value(step, i)) << "step=" << step;
+        }
+
+        auto blocks = reader.BlocksInfo(g, step);
+        ASSERT_EQ(blocks.size(), 2);
+        for (std::size_t b = 0; b < blocks.size(); ++b)
+        {
+            EXPECT_EQ(blocks[b].Start, adios2::Dims({b * Nx / 2}));
+            EXPECT_EQ(blocks[b].Count, adios2::Dims({Nx / 2}));
+            EXPECT_EQ(blocks[b].Min, Value(step, b * Nx / 2));
+            EXPECT_EQ(blocks[b].Max, Value(step, (b + 1) * Nx / 2 - 1));
+        }
+
+        int32_t value = -1;
+        s.SetStepSelection({step, 1});
+        reader.Get(s, value, adios2::Mode::Sync);
+        EXPECT_EQ(value, static_cast<int32_t>(step));
+    }
+
+    // relative steps of a variable missing from every other step
+    for (std::size_t rel = NSteps / 2; rel > 0; --rel)
+    {
+        e.SetStepSelection({rel - 1, 1});
+        std::vector<int32_t> data;
+        reader.Get(e, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), Nx);
+        EXPECT_EQ(data.front(), Value(2 * (rel - 1), 0)) << "rel=" << rel;
+    }
+
+    // deferred Gets needing more steps than the limit at once
+    std::vector<int32_t> all(NSteps * Nx);
+    g.SetStepSelection({0, NSteps});
+    reader.Get(g, all.data());
+    reader.PerformGets();
+    for (std::size_t step = 0; step < NSteps; ++step)
+    {
+        for (std::size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(all[step * Nx + i], Value(step, i)) << "step=" << step;
+        }
+    }
+    reader.Close();
+}
+
+INSTANTIATE_TEST_SUITE_P(BPRandomAccessMetadata, BPRandomAccessMetadataTest,
+                         ::testing::Values<std::size_t>(0, 1, 3));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+namespace
+{
+const size_t NSteps = 2;
+const size_t NBlocks = 16;
+// 1D blocks are read straight into user memory
+const size_t N1 = 100;
+// 2D blocks are read into a staging buffer, then copied
+const size_t Rows = 7;
+const size_t Cols = 9;
+// written between the blocks, never read, 8000 bytes apart
+const size_t NGap = 1000;
+
+double Value1D(size_t step, size_t i)
+{
+    return static_cast<double>(step * 1000000 + i);
+}
+
+double Value2D(size_t step, size_t row, size_t col)
+{
+    return static_cast<double>(step * 1000000 + row * Cols + col);
+}
+
+/* ReadCoalesceGap, Threads */
+using ParamType = std::tuple<std::string, std::string>;
+
+} // end anonymous namespace
+
+class BPReadCoalesceTest : public ::testing::TestWithParam<ParamType>
+{
+public:
+    BPReadCoalesceTest() = default;
+};
+
+TEST_P(BPReadCoalesceTest, GappedBlocks)
+{
+    const std::string gap = std::get<0>(GetParam());
+    const std::string threads = std::get<1>(GetParam());
+    const std::string fname =
+        "BPReadCoalesce_" + gap + "_" + threads + ".bp";
+
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        auto var1 = io.DefineVariable<double>("a1d", {NBlocks * N1}, {0},
+                                              {N1});
+        auto var2 = io.DefineVariable<double>("a2d", {NBlocks * Rows, Cols},
+                                              {0, 0}, {Rows, Cols});
+        auto varGap = io.DefineVariable<double>("gap", {}, {}, {NGap});
+
+        std::vector<double> data1(N1), data2(Rows * Cols), gapData(NGap, -1.0);
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < N1; ++i)
+                {
+                    data1[i] = Value1D(step, b * N1 + i);
+                }
+                for (size_t r = 0; r < Rows; ++r)
+                {
+                    for (size_t c = 0; c < Cols; ++c)
+                    {
+                        data2[r * Cols + c] = Value2D(step, b * Rows + r, c);
+                    }
+                }
+                var1.SetSelection({{b * N1}, {N1}});
+                var2.SetSelection({{b * Rows, 0}, {Rows, Cols}});
+                // in file order: gap, 1D block, 2D block
+                writer.Put(varGap, gapData.data(), adios2::Mode::Sync);
+                writer.Put(var1, data1.data(), adios2::Mode::Sync);
+                writer.Put(var2, data2.data(), adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("ReadCoalesceGap", gap);
+    io.SetParameter("Threads", threads);
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+        auto var1 = io.InquireVariable<double>("a1d");
+        auto var2 = io.InquireVariable<double>("a2d");
+        ASSERT_TRUE(var1);
+        ASSERT_TRUE(var2);
+
+        // whole 1D array, every block goes to user memory directly
+        std::vector<double> full1(NBlocks * N1);
+        var1.SetSelection({{0}, {NBlocks * N1}});
+        reader.Get(var1, full1.data());
+
+        // 2D sub-box cutting every block, all pieces are staged
+        const size_t rowStart = 3;
+        const size_t rowCount = NBlocks * Rows - 6;
+        const size_t colStart = 2;
+        const size_t colCount = Cols - 4;
+        std::vector<double> box2(rowCount * colCount);
+        var2.SetSelection({{rowStart, colStart}, {rowCount, colCount}});
+        reader.Get(var2, box2.data());
+        reader.PerformGets();
+
+        for (size_t i = 0; i < full1.size(); ++i)
+        {
+            ASSERT_EQ(full1[i], Value1D(step, i)) << "a1d[" << i << "]";
+        }
+        for (size_t r = 0; r < rowCount; ++r)
+        {
+            for (size_t c = 0; c < colCount; ++c)
+            {
+                ASSERT_EQ(box2[r * colCount + c],
+                          Value2D(step, rowStart + r, colStart + c))
+                    << "a2d[" << rowStart + r << "][" << colStart + c << "]";
+            }
+        }
+
+        // 1D selection starting and ending inside a block, read with the 2D
+        // block in between so direct and staged reads merge
+        const size_t start1 = N1 / 2;
+        const size_t count1 = (NBlocks - 1) * N1;
+        std::vector<double> part1(count1);
+        std::vector<double> block2(Rows * Cols);
+        var1.SetSelection({{start1}, {count1}});
+        var2.SetSelection({{Rows, 0}, {Rows, Cols}});
+        reader.Get(var1, part1.data());
+        reader.Get(var2, block2.data());
+        reader.EndStep();
+
+        for (size_t i = 0; i < count1; ++i)
+        {
+            ASSERT_EQ(part1[i], Value1D(step, start1 + i))
+                << "a1d[" << start1 + i << "]";
+        }
+        for (size_t r = 0; r < Rows; ++r)
+        {
+            for (size_t c = 0; c < Cols; ++c)
+            {
+                ASSERT_EQ(block2[r * Cols + c], Value2D(step, Rows + r, c));
+            }
+        }
+    }
+    reader.Close();
+}
+
+// The gaps are 8000 bytes: 0 merges only adjacent reads, 4000 also the reads
+// between two gaps, 64KB and 1MB merge all reads of a step into one
+INSTANTIATE_TEST_SUITE_P(BPReadCoalesce, BPReadCoalesceTest,
+                         ::testing::Combine(::testing::Values("0", "4000",
+                                                              "64KB", "1MB"),
+                                            ::testing::Values("1", "4")));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    return RUN_ALL_TESTS();
+}
@@ -256,6 +256,156 @@ TEST_P(BPReadMultithreadedTestP, ReadStream)
 #endif
 }
 
+TEST_P(BPReadMultithreadedTestP, ReadStreamManyBlocks)
+{
+    // Many blocks per step, each read with a gap to the next one, so the
+    // reads are spread over the threads in every step
+    int mpiRank = 0, mpiSize = 1;
+    int nThreads = GetThreads();
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const std::string filename =
+        "BPReadMultithreadedBlocks" + std::to_string(mpiSize) + ".bp";
+    const size_t NBlocks = 32;
+    const size_t NRows = 64;
+    const size_t NCols = 256;
+    const size_t rankRow = NBlocks * NRows * mpiRank;
+    auto lf_Value = [&](size_t step, size_t row, size_t col) {
+        return static_cast<int32_t>(step * 1000000 + (rankRow + row) * NCols +
+                                    col);
+    };
+
+    {
+        adios2::IO ioWrite = adios.DeclareIO("TestIOWrite");
+        ioWrite.SetEngine(engineName);
+        auto var = ioWrite.DefineVariable<int32_t>(
+            "v", {NBlocks * NRows * mpiSize, NCols}, {rankRow, 0},
+            {NRows, NCols});
+        adios2::Engine writer = ioWrite.Open(filename, adios2::Mode::Write);
+        std::vector<int32_t> block(NRows * NCols);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t r = 0; r < NRows; ++r)
+                {
+                    for (size_t c = 0; c < NCols; ++c)
+                    {
+                        block[r * NCols + c] = lf_Value(step, b * NRows + r, c);
+                    }
+                }
+                var.SetSelection({{rankRow + b * NRows, 0}, {NRows, NCols}});
+                writer.Put(var, block.data(), adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    adios2::IO ioRead = adios.DeclareIO("TestIORead");
+    ioRead.SetEngine(engineName);
+    ioRead.SetParameter("Threads", std::to_string(nThreads));
+    ioRead.SetParameter("ReadCoalesceGap", "0");
+    adios2::Engine reader = ioRead.Open(filename, adios2::Mode::Read);
+
+    std::vector<int32_t> res;
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        reader.BeginStep();
+        auto var = ioRead.InquireVariable<int32_t>("v");
+        // all but the first and last column
+        var.SetSelection({{rankRow, 1}, {NBlocks * NRows, NCols - 2}});
+        reader.Get(var, res, adios2::Mode::Deferred);
+        reader.EndStep();
+
+        ASSERT_EQ(res.size(), NBlocks * NRows * (NCols - 2));
+        for (size_t r = 0; r < NBlocks * NRows; ++r)
+        {
+            for (size_t c = 0; c < NCols - 2; ++c)
+            {
+                ASSERT_EQ(res[r * (NCols - 2) + c], lf_Value(step, r, c + 1))
+                    << "step=" << step << " row=" << r << " col=" << c;
+            }
+        }
+    }
+    reader.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+TEST_P(BPReadMultithreadedTestP, ReadStreamAsync)
+{
+    // The Gets of a step are read in the background while the data of the
+    // previous step is checked
+    int mpiRank = 0, mpiSize = 1;
+    int nThreads = GetThreads();
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    CreateOutput();
+    std::string filename =
+        "BPReadMultithreaded" + std::to_string(mpiSize) + ".bp";
+    adios2::IO ioRead = adios.DeclareIO("TestIORead");
+    ioRead.SetEngine(engineName);
+    ioRead.SetParameter("Threads", std::to_string(nThreads));
+    ioRead.SetParameter("AsyncRead", "true");
+    adios2::Engine reader = ioRead.Open(filename, adios2::Mode::Read);
+
+    std::vector<std::vector<int32_t>> res(2, std::vector<int32_t>(2 * Nx));
+    auto lf_Check = [&](size_t step) {
+        auto d = GenerateData(static_cast<int>(step), mpiRank, mpiSize);
+        const std::vector<int32_t> &r = res[step % 2];
+        for (size_t i = 0; i < 2 * Nx; ++i)
+        {
+            EXPECT_EQ(r[i], d[0]) << "step=" << step << " i=" << i;
+        }
+    };
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+        auto v1 = ioRead.InquireVariable<int32_t>("v1");
+        auto v4 = ioRead.InquireVariable<int32_t>("v4");
+        v1.SetSelection({{Nx * mpiRank}, {Nx}});
+        v4.SetSelection({{Nx * mpiRank}, {Nx}});
+        reader.Get(v1, res[step % 2].data());
+        reader.Get(v4, res[step % 2].data() + Nx);
+        reader.EndStep();
+        if (step > 0)
+        {
+            lf_Check(step - 1);
+        }
+    }
+    // waits for the reads of the last step
+    reader.PerformGets();
+    EXPECT_TRUE(reader.GetsCompleted());
+    lf_Check(NSteps - 1);
+
+    EXPECT_EQ(reader.BeginStep(adios2::StepMode::Read, 1.0f),
+              adios2::StepStatus::EndOfStream);
+    reader.Close();
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
 INSTANTIATE_TEST_SUITE_P(BPReadMultithreadedTest, BPReadMultithreadedTestP,
                          ::testing::Values(1, 2, 3, 0));
 
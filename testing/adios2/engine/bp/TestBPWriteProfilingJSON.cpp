@@ -15,6 +15,8 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <adios2.h>
 
@@ -312,6 +314,103 @@ TEST_F(BPWriteProfilingJSONTest, ADIOS2BPWriteProfilingJSON_Off)
     }
 }
 
+TEST_F(BPWriteProfilingJSONTest, ADIOS2BPWriteProfileTrace)
+{
+    // ProfileTrace is a BP5 parameter
+    if (engineName != "BP5")
+    {
+        return;
+    }
+
+    const std::string fname = "foo/ADIOS2BPWriteProfileTrace.bp";
+
+    int mpiRank = 0, mpiSize = 1;
+    const std::size_t Nx = 8;
+    const std::size_t NSteps = 3;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    {
+#if ADIOS2_USE_MPI
+        adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+        adios2::ADIOS adios;
+#endif
+        adios2::IO io = adios.DeclareIO("TestIO");
+        auto var_r64 = io.DefineVariable<double>(
+            "r64", {Nx * static_cast<size_t>(mpiSize)},
+            {Nx * static_cast<size_t>(mpiRank)}, {Nx});
+
+        io.SetEngine(engineName);
+        io.SetParameters({{"ProfileTrace", "On"}});
+        io.AddTransport("file", {{"Library", "POSIX"}});
+
+        adios2::Engine engine = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            SmallTestData currentTestData =
+                generateNewSmallTestData(m_TestData, step, mpiRank, mpiSize);
+            engine.BeginStep();
+            engine.Put(var_r64, currentTestData.R64.data());
+            engine.EndStep();
+        }
+        engine.Close();
+    }
+
+    if (mpiRank == 0)
+    {
+        // the summary is still written next to the trace
+        std::ifstream profilingJSONFile(fname + "/profiling.json");
+        EXPECT_TRUE(profilingJSONFile.good());
+
+        std::ifstream traceJSONFile(fname + "/profiling_trace.json");
+        ASSERT_TRUE(traceJSONFile.good());
+        const json traceJSON = json::parse(traceJSONFile);
+        const json &events = traceJSON.at("traceEvents");
+
+        std::vector<int> processNames(mpiSize, 0);
+        std::vector<size_t> endSteps(mpiSize, 0);
+        std::vector<size_t> writes(mpiSize, 0);
+        for (const auto &event : events)
+        {
+            const int pid = event.at("pid").get<int>();
+            ASSERT_GE(pid, 0);
+            ASSERT_LT(pid, mpiSize);
+            const std::string ph = event.at("ph").get<std::string>();
+            if (ph == "M")
+            {
+                ++processNames[pid];
+                continue;
+            }
+            ASSERT_EQ(ph, "X");
+            EXPECT_GE(event.at("dur").get<int64_t>(), 0);
+            const std::string name = event.at("name").get<std::string>();
+            const std::string cat = event.at("cat").get<std::string>();
+            if (cat == "engine" && name == "endstep")
+            {
+                ++endSteps[pid];
+            }
+            else if (cat.compare(0, 10, "transport_") == 0 && name == "write")
+            {
+                EXPECT_EQ(event.at("args").at("type").get<std::string>(),
+                          "File_POSIX");
+                ++writes[pid];
+            }
+        }
+
+        for (int r = 0; r < mpiSize; ++r)
+        {
+            EXPECT_EQ(processNames[r], 1) << "rank " << r;
+            EXPECT_EQ(endSteps[r], NSteps) << "rank " << r;
+        }
+        // rank 0 is always an aggregator
+        EXPECT_GT(writes[0], 0);
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
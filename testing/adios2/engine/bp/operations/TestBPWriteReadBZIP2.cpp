@@ -845,6 +845,204 @@ void BZIP2Accuracy3DSel(const std::string accuracy)
     }
 }
 
+void BZIP2AsyncCompression()
+{
+    // Each process writes NBlocks blocks of Nx per step, some of them flushed
+    // by PerformPuts() before EndStep()
+    const std::string fname("BPWR_BZIP2_Async.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t NBlocks = 4;
+    const size_t NSteps = 3;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t rankStart = NBlocks * Nx * mpiRank;
+    auto lf_Value = [&](size_t step, size_t i) {
+        return static_cast<double>(step * 10000 + rankStart + i);
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        io.SetEngine(engineName.empty() ? "BPFile" : engineName);
+        io.SetParameters({{"AsyncCompression", "true"}, {"Threads", "2"}});
+
+        const adios2::Dims shape{NBlocks * Nx * mpiSize};
+        adios2::Variable<double> var_r64 = io.DefineVariable<double>(
+            "r64", shape, {rankStart}, {Nx});
+        adios2::Operator BZIP2Op =
+            adios.DefineOperator("BZIP2Compressor", adios2::ops::LosslessBZIP2);
+        var_r64.AddOperation(
+            BZIP2Op, {{adios2::ops::bzip2::key::blockSize100k,
+                       adios2::ops::bzip2::value::blockSize100k_1}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<std::vector<double>> blocks(NBlocks,
+                                                std::vector<double>(Nx));
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    blocks[b][i] = lf_Value(step, b * Nx + i);
+                }
+                var_r64.SetSelection({{rankStart + b * Nx}, {Nx}});
+                bpWriter.Put(var_r64, blocks[b].data());
+                if (b == 1)
+                {
+                    bpWriter.PerformPuts();
+                }
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName.empty() ? "BPFile" : engineName);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        size_t t = 0;
+        std::vector<double> decompressedR64s;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_r64 = io.InquireVariable<double>("r64");
+            EXPECT_TRUE(var_r64);
+            var_r64.SetSelection({{rankStart}, {NBlocks * Nx}});
+            bpReader.Get(var_r64, decompressedR64s);
+            bpReader.EndStep();
+
+            ASSERT_EQ(decompressedR64s.size(), NBlocks * Nx);
+            for (size_t i = 0; i < NBlocks * Nx; ++i)
+            {
+                ASSERT_EQ(decompressedR64s[i], lf_Value(t, i))
+                    << "t=" << t << " i=" << i << " rank=" << mpiRank;
+            }
+            ++t;
+        }
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+void BZIP2SubBlocks(const bool async)
+{
+    // Each process writes one Nx x Ny block per step, compressed in
+    // sub-blocks of a few rows, and reads back parts of it
+    const std::string fname(async ? "BPWR_BZIP2_SubBlocksAsync.bp"
+                                  : "BPWR_BZIP2_SubBlocks.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t Ny = 50;
+    const size_t NSteps = 2;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t rankStart = Nx * mpiRank;
+    auto lf_Value = [&](size_t step, size_t x, size_t y) {
+        return static_cast<double>(step * 1000000 + (rankStart + x) * Ny + y);
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        io.SetEngine(engineName.empty() ? "BPFile" : engineName);
+        io.SetParameters({{"CompressionSubBlockSize", "4096"},
+                          {"AsyncCompression", async ? "true" : "false"},
+                          {"Threads", "4"}});
+
+        adios2::Variable<double> var_r64 = io.DefineVariable<double>(
+            "r64", {Nx * mpiSize, Ny}, {rankStart, 0}, {Nx, Ny});
+        adios2::Operator BZIP2Op =
+            adios.DefineOperator("BZIP2Compressor", adios2::ops::LosslessBZIP2);
+        var_r64.AddOperation(
+            BZIP2Op, {{adios2::ops::bzip2::key::blockSize100k,
+                       adios2::ops::bzip2::value::blockSize100k_1}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> block(Nx * Ny);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                for (size_t y = 0; y < Ny; ++y)
+                {
+                    block[x * Ny + y] = lf_Value(step, x, y);
+                }
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, block.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName.empty() ? "BPFile" : engineName);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        size_t t = 0;
+        const size_t selX = 17, selNx = 33, selY = 5, selNy = 20;
+        std::vector<double> selection, whole;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_r64 = io.InquireVariable<double>("r64");
+            EXPECT_TRUE(var_r64);
+            var_r64.SetSelection({{rankStart + selX, selY}, {selNx, selNy}});
+            bpReader.Get(var_r64, selection, adios2::Mode::Sync);
+            var_r64.SetBlockSelection(mpiRank);
+            bpReader.Get(var_r64, whole, adios2::Mode::Sync);
+            bpReader.EndStep();
+
+            ASSERT_EQ(selection.size(), selNx * selNy);
+            for (size_t x = 0; x < selNx; ++x)
+            {
+                for (size_t y = 0; y < selNy; ++y)
+                {
+                    ASSERT_EQ(selection[x * selNy + y],
+                              lf_Value(t, selX + x, selY + y))
+                        << "t=" << t << " x=" << x << " y=" << y
+                        << " rank=" << mpiRank;
+                }
+            }
+            ASSERT_EQ(whole.size(), Nx * Ny);
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                for (size_t y = 0; y < Ny; ++y)
+                {
+                    ASSERT_EQ(whole[x * Ny + y], lf_Value(t, x, y))
+                        << "t=" << t << " x=" << x << " y=" << y
+                        << " rank=" << mpiRank;
+                }
+            }
+            ++t;
+        }
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
 class BPWriteReadBZIP2 : public ::testing::TestWithParam<std::string>
 {
 public:
@@ -878,6 +1076,21 @@ TEST_P(BPWriteReadBZIP2, ADIOS2BPWriteReadBZIP23DSel)
     BZIP2Accuracy3DSel(GetParam());
 }
 
+TEST(BPWriteReadBZIP2Async, ADIOS2BPWriteReadBZIP2AsyncCompression)
+{
+    BZIP2AsyncCompression();
+}
+
+TEST(BPWriteReadBZIP2SubBlocks, ADIOS2BPWriteReadBZIP2SubBlocks)
+{
+    BZIP2SubBlocks(false);
+}
+
+TEST(BPWriteReadBZIP2SubBlocks, ADIOS2BPWriteReadBZIP2SubBlocksAsync)
+{
+    BZIP2SubBlocks(true);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     BZIP2Accuracy, BPWriteReadBZIP2,
     ::testing::Values(adios2::ops::bzip2::value::blockSize100k_1,
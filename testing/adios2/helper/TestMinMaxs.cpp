@@ -2,6 +2,7 @@
  * Distributed under the OSI-approved Apache License, Version 2.0.  See
  * accompanying file Copyright.txt for details.
  */
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
@@ -9,6 +10,7 @@
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 
 #include <adios2.h>
 #include <adios2/common/ADIOSTypes.h>
@@ -1170,6 +1172,138 @@ TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_4D_3x2x5x4)
     }
 }
 
+template <typename T>
+void CheckMinMaxVectorized()
+{
+    // Sizes around the vector widths and their remainders
+    for (size_t size : {1, 3, 15, 16, 17, 63, 64, 65, 129, 1000, 4099})
+    {
+        std::vector<T> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            // Pseudo random, with the extremes anywhere in the array
+            data[i] = static_cast<T>((i * 7919 + size * 31) % 251);
+        }
+        if (std::is_signed<T>::value)
+        {
+            data[(size * 3) / 4] = static_cast<T>(-100);
+        }
+
+        T min, max;
+        adios2::helper::GetMinMaxVectorized(data.data(), size, min, max);
+        auto bounds = std::minmax_element(data.begin(), data.end());
+        EXPECT_EQ(*bounds.first, min) << "size " << size;
+        EXPECT_EQ(*bounds.second, max) << "size " << size;
+    }
+}
+
+template <typename T>
+void CheckCopyMinMax(const unsigned int threads)
+{
+    // Sizes within one block, across blocks and past the streaming size
+    for (size_t size : {1, 17, 4099, 100000, 1000003})
+    {
+        std::vector<T> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<T>((i * 7919 + size * 31) % 251);
+        }
+        data[size / 2] = static_cast<T>(-1);
+
+        // One byte off so the destination is not aligned
+        std::vector<char> buffer(size * sizeof(T) + 1);
+        T min, max;
+        adios2::helper::CopyMinMax(data.data(), size, buffer.data() + 1, min,
+                                   max, threads);
+        auto bounds = std::minmax_element(data.begin(), data.end());
+        EXPECT_EQ(*bounds.first, min) << "size " << size;
+        EXPECT_EQ(*bounds.second, max) << "size " << size;
+        EXPECT_EQ(0, std::memcmp(data.data(), buffer.data() + 1,
+                                 size * sizeof(T)))
+            << "size " << size;
+    }
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_Vectorized)
+{
+    CheckMinMaxVectorized<int8_t>();
+    CheckMinMaxVectorized<uint8_t>();
+    CheckMinMaxVectorized<int16_t>();
+    CheckMinMaxVectorized<uint16_t>();
+    CheckMinMaxVectorized<int32_t>();
+    CheckMinMaxVectorized<uint32_t>();
+    CheckMinMaxVectorized<int64_t>();
+    CheckMinMaxVectorized<uint64_t>();
+    CheckMinMaxVectorized<float>();
+    CheckMinMaxVectorized<double>();
+    CheckMinMaxVectorized<long double>();
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_VectorizedNaN)
+{
+    std::vector<double> data(100, 1.0);
+    data[10] = std::numeric_limits<double>::quiet_NaN();
+    data[50] = -2.0;
+    data[90] = 3.0;
+
+    double min, max;
+    adios2::helper::GetMinMaxVectorized(data.data(), data.size(), min, max);
+    EXPECT_EQ(-2.0, min);
+    EXPECT_EQ(3.0, max);
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_Threads)
+{
+    std::vector<float> data(3000001);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<float>((i * 7919) % 100003);
+    }
+    data[2999999] = -1.0f;
+
+    float min, max;
+    adios2::helper::GetMinMaxThreads(data.data(), data.size(), min, max, 4);
+    EXPECT_EQ(-1.0f, min);
+    EXPECT_EQ(100002.0f, max);
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_CopyMinMax)
+{
+    CheckCopyMinMax<uint8_t>(1);
+    CheckCopyMinMax<int32_t>(1);
+    CheckCopyMinMax<float>(1);
+    CheckCopyMinMax<double>(1);
+    CheckCopyMinMax<long double>(1);
+    CheckCopyMinMax<double>(3);
+}
+
+TEST(ADIOS2MinMaxs, ADIOS2MinMaxs_CopyMinMaxNaN)
+{
+    // With 3 threads the chunks start at 0, 333334 and 666668
+    const size_t size = 1000003;
+    const size_t stride = size / 3;
+    std::vector<double> data(size, 1.0);
+    data[stride] = std::numeric_limits<double>::quiet_NaN();
+    data[stride + 1] = std::numeric_limits<double>::quiet_NaN();
+    data[stride + 10] = -2.0;
+    data[stride + 20] = 3.0;
+    // a whole chunk of NaN adds nothing
+    for (size_t i = 2 * stride; i < size; ++i)
+    {
+        data[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<double> buffer(size);
+    for (unsigned int threads : {1, 3})
+    {
+        double min, max;
+        adios2::helper::CopyMinMax(data.data(), size, buffer.data(), min, max,
+                                   threads);
+        EXPECT_EQ(-2.0, min) << "threads " << threads;
+        EXPECT_EQ(3.0, max) << "threads " << threads;
+    }
+}
+
 int main(int argc, char **argv)
 {
 
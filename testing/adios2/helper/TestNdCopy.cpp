@@ -0,0 +1,247 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <adios2/common/ADIOSTypes.h>
+#include <adios2/helper/adiosMemory.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+size_t RowMajorIndex(const adios2::Dims &count, const adios2::Dims &point)
+{
+    size_t index = 0;
+    for (size_t d = 0; d < count.size(); ++d)
+    {
+        index = index * count[d] + point[d];
+    }
+    return index;
+}
+
+size_t ColumnMajorIndex(const adios2::Dims &count, const adios2::Dims &point)
+{
+    size_t index = 0;
+    for (size_t d = count.size(); d > 0; --d)
+    {
+        index = index * count[d - 1] + point[d - 1];
+    }
+    return index;
+}
+
+/* element size, row-major input, reverse endianess, threads */
+using ParamType = std::tuple<size_t, bool, bool, unsigned int>;
+
+} // end anonymous namespace
+
+class NdCopyTransposeTest : public ::testing::TestWithParam<ParamType>
+{
+public:
+    NdCopyTransposeTest() = default;
+
+    /** copies a whole box between row-major and column-major buffers */
+    void Transpose(const adios2::Dims &count)
+    {
+        const size_t elmSize = std::get<0>(GetParam());
+        const bool inIsRowMajor = std::get<1>(GetParam());
+        const bool reverseEndian = std::get<2>(GetParam());
+        const unsigned int threads = std::get<3>(GetParam());
+
+        const size_t nElements = std::accumulate(
+            count.begin(), count.end(), size_t(1), std::multiplies<size_t>());
+        std::vector<char> in(nElements * elmSize);
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            in[i] = static_cast<char>(i * 7 + i / elmSize);
+        }
+        std::vector<char> out(in.size(), 0);
+
+        const adios2::Dims start(count.size(), 0);
+        const int ret = adios2::helper::NdCopy(
+            in.data(), adios2::helper::DimsArray(start),
+            adios2::helper::DimsArray(count), inIsRowMajor, true, out.data(),
+            adios2::helper::DimsArray(start), adios2::helper::DimsArray(count),
+            !inIsRowMajor, !reverseEndian, static_cast<int>(elmSize),
+            adios2::helper::CoreDims(), adios2::helper::CoreDims(),
+            adios2::helper::CoreDims(), adios2::helper::CoreDims(), false,
+            adios2::MemorySpace::Host, threads);
+        ASSERT_EQ(ret, 0);
+
+        adios2::Dims point(count.size(), 0);
+        for (size_t n = 0; n < nElements; ++n)
+        {
+            const size_t rowIndex = RowMajorIndex(count, point);
+            const size_t colIndex = ColumnMajorIndex(count, point);
+            const char *src =
+                in.data() + (inIsRowMajor ? rowIndex : colIndex) * elmSize;
+            const char *dst =
+                out.data() + (inIsRowMajor ? colIndex : rowIndex) * elmSize;
+            for (size_t k = 0; k < elmSize; ++k)
+            {
+                const char expected =
+                    reverseEndian ? src[elmSize - 1 - k] : src[k];
+                ASSERT_EQ(dst[k], expected) << "element " << n;
+            }
+
+            for (size_t d = count.size(); d > 0; --d)
+            {
+                if (++point[d - 1] < count[d - 1])
+                {
+                    break;
+                }
+                point[d - 1] = 0;
+            }
+        }
+    }
+};
+
+TEST_P(NdCopyTransposeTest, Transpose2D) { Transpose({67, 131}); }
+
+// large enough to use several threads
+TEST_P(NdCopyTransposeTest, Transpose3D) { Transpose({129, 97, 130}); }
+
+TEST_P(NdCopyTransposeTest, Transpose4D) { Transpose({5, 1, 33, 9}); }
+
+TEST_P(NdCopyTransposeTest, Degenerate) { Transpose({1, 70, 1}); }
+
+INSTANTIATE_TEST_SUITE_P(
+    NdCopy, NdCopyTransposeTest,
+    ::testing::Combine(::testing::Values<size_t>(1, 2, 4, 8, 12),
+                       ::testing::Bool(), ::testing::Bool(),
+                       ::testing::Values<unsigned int>(1, 4)));
+
+/* column-major to column-major of a sub-box, copied by runs */
+TEST(NdCopyTest, ColumnMajorSubBox)
+{
+    const adios2::Dims inStart = {2, 0, 1};
+    const adios2::Dims inCount = {10, 6, 8};
+    const adios2::Dims outStart = {4, 1, 0};
+    const adios2::Dims outCount = {5, 4, 12};
+
+    std::vector<double> in(inCount[0] * inCount[1] * inCount[2]);
+    std::iota(in.begin(), in.end(), 0.0);
+    std::vector<double> out(outCount[0] * outCount[1] * outCount[2], -1.0);
+
+    const int ret = adios2::helper::NdCopy(
+        reinterpret_cast<const char *>(in.data()),
+        adios2::helper::DimsArray(inStart), adios2::helper::DimsArray(inCount),
+        false, true, reinterpret_cast<char *>(out.data()),
+        adios2::helper::DimsArray(outStart),
+        adios2::helper::DimsArray(outCount), false, true, sizeof(double));
+    ASSERT_EQ(ret, 0);
+
+    adios2::Dims point(3);
+    for (point[0] = 0; point[0] < 16; ++point[0])
+    {
+        for (point[1] = 0; point[1] < 8; ++point[1])
+        {
+            for (point[2] = 0; point[2] < 16; ++point[2])
+            {
+                bool inside = true;
+                adios2::Dims inPoint(3), outPoint(3);
+                for (size_t d = 0; d < 3; ++d)
+                {
+                    inside = inside && point[d] >= inStart[d] &&
+                             point[d] < inStart[d] + inCount[d] &&
+                             point[d] >= outStart[d] &&
+                             point[d] < outStart[d] + outCount[d];
+                    inPoint[d] = point[d] - inStart[d];
+                    outPoint[d] = point[d] - outStart[d];
+                }
+                if (inside)
+                {
+                    // both buffers use the same (row-major) index order
+                    EXPECT_EQ(out[RowMajorIndex(outCount, outPoint)],
+                              in[RowMajorIndex(inCount, inPoint)]);
+                }
+            }
+        }
+    }
+}
+
+/* replaying a plan copies what NdCopy copies between row-major buffers */
+TEST(NdCopyTest, PlanMatchesNdCopy)
+{
+    struct Case
+    {
+        adios2::Dims inStart, inCount, outStart, outCount;
+        size_t elmSize;
+        unsigned int threads;
+    };
+    const std::vector<Case> cases = {
+        // thin slab: one short run per row
+        {{0, 0}, {300, 40}, {10, 5}, {200, 3}, 8, 1},
+        // full rows merge into a single run, split over threads
+        {{0, 0, 0}, {64, 128, 160}, {0, 0, 0}, {64, 128, 160}, 8, 4},
+        // runs over the two fastest dimensions, partial overlap
+        {{3, 0, 0}, {20, 30, 17}, {0, 0, 0}, {10, 30, 17}, 4, 1},
+        // sub-box in every dimension, many threads on small runs
+        {{0, 0, 0}, {512, 256, 20}, {1, 2, 3}, {510, 250, 9}, 8, 3},
+        {{5}, {100}, {0}, {50}, 1, 2},
+        // 4D, threads start inside runs of different rows and planes
+        {{0, 0, 0, 0}, {6, 40, 50, 30}, {1, 3, 2, 4}, {4, 30, 40, 7}, 8, 5},
+        // no overlap
+        {{0, 0}, {4, 4}, {4, 0}, {4, 4}, 2, 1},
+    };
+    for (const Case &c : cases)
+    {
+        const adios2::helper::DimsArray inStart(c.inStart);
+        const adios2::helper::DimsArray inCount(c.inCount);
+        const adios2::helper::DimsArray outStart(c.outStart);
+        const adios2::helper::DimsArray outCount(c.outCount);
+        const size_t inSize =
+            std::accumulate(c.inCount.begin(), c.inCount.end(), c.elmSize,
+                            std::multiplies<size_t>());
+        const size_t outSize =
+            std::accumulate(c.outCount.begin(), c.outCount.end(), c.elmSize,
+                            std::multiplies<size_t>());
+        std::vector<char> in(inSize);
+        for (size_t i = 0; i < inSize; ++i)
+        {
+            in[i] = static_cast<char>(i * 13 + i / 251);
+        }
+        std::vector<char> expected(outSize, 0);
+        std::vector<char> out(outSize, 0);
+
+        adios2::helper::NdCopy(in.data(), inStart, inCount, true, true,
+                               expected.data(), outStart, outCount, true, true,
+                               static_cast<int>(c.elmSize));
+        const adios2::helper::NdCopyPlan plan = adios2::helper::NdCopyMakePlan(
+            inStart, inCount, outStart, outCount, c.elmSize);
+        adios2::helper::NdCopyExecutePlan(plan, in.data(), out.data(),
+                                          c.threads);
+        EXPECT_EQ(out, expected);
+    }
+}
+
+/* a plan holds the first run and strides, not one entry per run */
+TEST(NdCopyTest, PlanIsStrided)
+{
+    const adios2::helper::DimsArray inStart(adios2::Dims{0, 0, 0});
+    const adios2::helper::DimsArray inCount(adios2::Dims{400, 300, 256});
+    const adios2::helper::DimsArray outStart(adios2::Dims{10, 20, 1});
+    const adios2::helper::DimsArray outCount(adios2::Dims{380, 200, 3});
+    const adios2::helper::NdCopyPlan plan = adios2::helper::NdCopyMakePlan(
+        inStart, inCount, outStart, outCount, 8);
+    EXPECT_EQ(plan.NumRuns, 380u * 200u);
+    EXPECT_EQ(plan.RunSize, 3u * 8u);
+    EXPECT_EQ(plan.InOffset, ((10u * 300u + 20u) * 256u + 1u) * 8u);
+    EXPECT_EQ(plan.OutOffset, 0u);
+    EXPECT_EQ(plan.Count, std::vector<size_t>({380, 200}));
+    EXPECT_EQ(plan.InStride, std::vector<size_t>({300u * 256u * 8u, 2048u}));
+    EXPECT_EQ(plan.OutStride, std::vector<size_t>({200u * 3u * 8u, 24u}));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <iostream>
 #include <numeric> //std::iota
+#include <sstream>
 #include <stdexcept>
 
 #include <adios2.h>
@@ -46,6 +47,123 @@ void WriteXmlQuery1D(const std::string &queryFile, const std::string &ioName,
     file.close();
 }
 
+// WriteXmlQuery1D evaluated element by element, thresholds parsed as T
+template <class T>
+std::vector<adios2::Dims> ExpectedPoints1D(const std::vector<T> &data)
+{
+    auto lf_Value = [](const std::string &str) {
+        std::stringstream convert(str);
+        T value;
+        convert >> value;
+        return value;
+    };
+    const T gt = lf_Value("6.6");
+    const T lt = lf_Value("-0.17");
+    const T andLt = lf_Value("2.9");
+    const T andGt = lf_Value("2.8");
+
+    std::vector<adios2::Dims> points;
+    for (size_t i = 5; i < 5 + 80; ++i)
+    {
+        const T v = data[i];
+        if (v > gt || v < lt || (v < andLt && v > andGt))
+        {
+            points.push_back({i});
+        }
+    }
+    return points;
+}
+
+// 2D arrays written in blocks, queried in a box cutting through several
+const size_t Rows2D = 20;
+const size_t Cols2D = 30;
+const size_t BlockRows2D = 5;
+const size_t BlockCols2D = 10;
+const adios2::Dims BoxStart2D = {3, 4};
+const adios2::Dims BoxCount2D = {14, 20};
+
+double Temperature2D(size_t step, size_t row, size_t col)
+{
+    return static_cast<double>((row * 31 + col * 17 + step * 7) % 100);
+}
+
+double Pressure2D(size_t step, size_t row, size_t col)
+{
+    return static_cast<double>((row * 13 + col * 29 + step * 3) % 50);
+}
+
+void WriteXmlVarQuery2D(std::ofstream &file, const std::string &varName,
+                        const std::string &gt, const std::string &lt)
+{
+    file << "   <var name=\"" << varName << "\">" << std::endl;
+    file << "      <boundingbox  start=\"" << BoxStart2D[0] << ","
+         << BoxStart2D[1] << "\" count=\"" << BoxCount2D[0] << ","
+         << BoxCount2D[1] << "\"/>" << std::endl;
+    file << "       <op value=\"AND\">" << std::endl;
+    file << "         <range  compare=\"GT\" value=\"" << gt << "\"/>"
+         << std::endl;
+    file << "         <range  compare=\"LT\" value=\"" << lt << "\"/>"
+         << std::endl;
+    file << "       </op>" << std::endl;
+    file << "   </var>" << std::endl;
+}
+
+// 20 < temperature < 75 in the box
+void WriteXmlQuery2D(const std::string &queryFile, const std::string &ioName)
+{
+    std::ofstream file(queryFile.c_str());
+    file << "<adios-query>" << std::endl;
+    file << " <io name=\"" << ioName << "\">" << std::endl;
+    WriteXmlVarQuery2D(file, "temperature", "20", "75");
+    file << " </io>" << std::endl;
+    file << "</adios-query>" << std::endl;
+    file.close();
+}
+
+// 20 < temperature < 75 op 10 < pressure < 30 in the box
+void WriteXmlCompositeQuery2D(const std::string &queryFile,
+                              const std::string &ioName, const std::string &op)
+{
+    std::ofstream file(queryFile.c_str());
+    file << "<adios-query>" << std::endl;
+    file << " <io name=\"" << ioName << "\">" << std::endl;
+    file << "  <tag name=\"T\">" << std::endl;
+    WriteXmlVarQuery2D(file, "temperature", "20", "75");
+    file << "  </tag>" << std::endl;
+    file << "  <tag name=\"P\">" << std::endl;
+    WriteXmlVarQuery2D(file, "pressure", "10", "30");
+    file << "  </tag>" << std::endl;
+    file << "  <query op=\"" << op << "\">" << std::endl;
+    file << "    <T/>" << std::endl;
+    file << "    <P/>" << std::endl;
+    file << "  </query>" << std::endl;
+    file << " </io>" << std::endl;
+    file << "</adios-query>" << std::endl;
+    file.close();
+}
+
+// the queries above evaluated element by element, op is "", "AND" or "OR"
+std::vector<adios2::Dims> ExpectedPoints2D(size_t step, const std::string &op)
+{
+    std::vector<adios2::Dims> points;
+    for (size_t r = BoxStart2D[0]; r < BoxStart2D[0] + BoxCount2D[0]; ++r)
+    {
+        for (size_t c = BoxStart2D[1]; c < BoxStart2D[1] + BoxCount2D[1]; ++c)
+        {
+            const double t = Temperature2D(step, r, c);
+            const double p = Pressure2D(step, r, c);
+            const bool tHit = t > 20 && t < 75;
+            const bool pHit = p > 10 && p < 30;
+            if ((op.empty() && tHit) || (op == "AND" && tHit && pHit) ||
+                (op == "OR" && (tHit || pHit)))
+            {
+                points.push_back({r, c});
+            }
+        }
+    }
+    return points;
+}
+
 void LoadTestData(QueryTestData &input, int step, int rank, int dataSize)
 {
     input.m_IntData.clear();
@@ -72,6 +190,14 @@ public:
     void QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
                      const std::string &engineName);
 
+    void WriteFile2D(const std::string &fname, adios2::ADIOS &adios,
+                     const std::string &engineName);
+    void QueryVar2D(const std::string &fname, adios2::ADIOS &adios,
+                    const std::string &engineName);
+    void QueryComposite2D(const std::string &fname, adios2::ADIOS &adios,
+                          const std::string &engineName,
+                          const std::string &op);
+
     QueryTestData m_TestData;
 
     // Number of rows
@@ -114,6 +240,12 @@ void BPQueryTest::QueryIntVar(const std::string &fname, adios2::ADIOS &adios,
         adios2::Box<adios2::Dims> empty;
         w.GetResultCoverage(empty, touched_blocks);
         ASSERT_EQ(touched_blocks.size(), rr[bpReader.CurrentStep()]);
+
+        std::vector<adios2::Dims> points;
+        w.GetResultPoints(empty, points);
+        LoadTestData(m_TestData, static_cast<int>(bpReader.CurrentStep()), 0,
+                     static_cast<int>(Nx));
+        EXPECT_EQ(points, ExpectedPoints1D(m_TestData.m_IntData));
         bpReader.EndStep();
     }
     bpReader.Close();
@@ -150,6 +282,13 @@ void BPQueryTest::QueryDoubleVar(const std::string &fname, adios2::ADIOS &adios,
         adios2::Box<adios2::Dims> empty;
         w.GetResultCoverage(empty, touched_blocks);
         ASSERT_EQ(touched_blocks.size(), rr[bpReader.CurrentStep()]);
+
+        std::vector<adios2::Dims> points;
+        w.GetResultPoints(empty, points);
+        LoadTestData(m_TestData, static_cast<int>(bpReader.CurrentStep()), 0,
+                     static_cast<int>(Nx));
+        EXPECT_EQ(points,
+                  ExpectedPoints1D(m_TestData.m_DoubleData));
         bpReader.EndStep();
     }
     bpReader.Close();
@@ -235,6 +374,123 @@ void BPQueryTest::WriteFile(const std::string &fname, adios2::ADIOS &adios,
         bpWriter.Close();
     }
 }
+void BPQueryTest::WriteFile2D(const std::string &fname, adios2::ADIOS &adios,
+                              const std::string &engineName)
+{
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    adios2::IO io = adios.DeclareIO("TestQueryIOWriter2D" + engineName);
+    io.SetEngine(engineName);
+    if (engineName.compare("BP4") == 0)
+    {
+        io.SetParameters("statslevel=1");
+        io.SetParameters("statsblocksize=10");
+    }
+
+    const adios2::Dims shape{Rows2D, Cols2D};
+    const adios2::Dims count{BlockRows2D, BlockCols2D};
+    auto varT = io.DefineVariable<double>("temperature", shape, {0, 0}, count);
+    auto varP = io.DefineVariable<double>("pressure", shape, {0, 0}, count);
+
+    // blocks are dealt out to the processes
+    std::vector<double> dataT(BlockRows2D * BlockCols2D);
+    std::vector<double> dataP(BlockRows2D * BlockCols2D);
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        bpWriter.BeginStep();
+        size_t block = 0;
+        for (size_t r0 = 0; r0 < Rows2D; r0 += BlockRows2D)
+        {
+            for (size_t c0 = 0; c0 < Cols2D; c0 += BlockCols2D, ++block)
+            {
+                if (block % mpiSize != static_cast<size_t>(mpiRank))
+                    continue;
+                for (size_t r = 0; r < BlockRows2D; ++r)
+                {
+                    for (size_t c = 0; c < BlockCols2D; ++c)
+                    {
+                        dataT[r * BlockCols2D + c] =
+                            Temperature2D(step, r0 + r, c0 + c);
+                        dataP[r * BlockCols2D + c] =
+                            Pressure2D(step, r0 + r, c0 + c);
+                    }
+                }
+                varT.SetSelection({{r0, c0}, count});
+                varP.SetSelection({{r0, c0}, count});
+                bpWriter.Put(varT, dataT.data(), adios2::Mode::Sync);
+                bpWriter.Put(varP, dataP.data(), adios2::Mode::Sync);
+            }
+        }
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+}
+
+void BPQueryTest::QueryVar2D(const std::string &fname, adios2::ADIOS &adios,
+                             const std::string &engineName)
+{
+    std::string ioName = "IOQueryTest2D" + engineName;
+    adios2::IO io = adios.DeclareIO(ioName.c_str());
+    io.SetEngine(engineName);
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlQuery2D(queryFile, ioName);
+    adios2::QueryWorker w = adios2::QueryWorker(queryFile, bpReader);
+
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        const size_t step = bpReader.CurrentStep();
+
+        // the query reads through the variable, with its own selection and
+        // without the user's memory selection, then restores both
+        auto var = io.InquireVariable<double>("temperature");
+        const adios2::Dims start{1, 2};
+        const adios2::Dims count{3, 4};
+        var.SetSelection({start, count});
+        var.SetMemorySelection({{1, 1}, {count[0] + 2, count[1] + 2}});
+
+        std::vector<adios2::Dims> points;
+        adios2::Box<adios2::Dims> empty;
+        w.GetResultPoints(empty, points);
+        EXPECT_EQ(points, ExpectedPoints2D(step, ""));
+
+        EXPECT_EQ(var.Start(), start);
+        EXPECT_EQ(var.Count(), count);
+        bpReader.EndStep();
+    }
+    bpReader.Close();
+}
+
+void BPQueryTest::QueryComposite2D(const std::string &fname,
+                                   adios2::ADIOS &adios,
+                                   const std::string &engineName,
+                                   const std::string &op)
+{
+    std::string ioName = "IOQueryTest2D" + op + engineName;
+    adios2::IO io = adios.DeclareIO(ioName.c_str());
+    io.SetEngine(engineName);
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::string queryFile = "./" + ioName + "test.xml";
+    WriteXmlCompositeQuery2D(queryFile, ioName, op);
+    adios2::QueryWorker w = adios2::QueryWorker(queryFile, bpReader);
+
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        std::vector<adios2::Dims> points;
+        adios2::Box<adios2::Dims> empty;
+        w.GetResultPoints(empty, points);
+        EXPECT_EQ(points, ExpectedPoints2D(bpReader.CurrentStep(), op));
+        bpReader.EndStep();
+    }
+    bpReader.Close();
+}
+
 //******************************************************************************
 // 1D  test data
 //******************************************************************************
@@ -287,6 +543,31 @@ TEST_F(BPQueryTest, BP4)
     }
 }
 
+//******************************************************************************
+// 2D multi-block test data, single and composite queries
+//******************************************************************************
+
+TEST_F(BPQueryTest, BP4MultiBlock2D)
+{
+    std::string engineName = "BP4";
+    const std::string fname(engineName + "Query2D.bp");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    WriteFile2D(fname, adios, engineName);
+
+    if (mpiSize == 1)
+    {
+        QueryVar2D(fname, adios, engineName);
+        QueryComposite2D(fname, adios, engineName, "AND");
+        QueryComposite2D(fname, adios, engineName, "OR");
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
@@ -0,0 +1,184 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Microbenchmark of the handoffs used by the shm toolkit and the
+ * TwoLevelShm aggregator: two threads pass a turn back and forth, the same
+ * way a producer and the consumer pass a buffer of the shm ring, and take a
+ * shm::Spinlock from each other. It reports the latency of one handoff (lock
+ * acquisition) and how much CPU time the two threads burn while waiting on
+ * each other (200% means both threads are busy all the time).
+ *
+ * Usage: PerfShmHandoff [handoffs] [work-us]
+ *   handoffs: number of handoffs in each test (default 100000)
+ *   work-us:  time each thread works between handoffs, in microseconds,
+ *             emulating buffer copies and writes (default 0)
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "adios2/toolkit/shm/AtomicWait.h"
+#include "adios2/toolkit/shm/Spinlock.h"
+
+using Clock = std::chrono::steady_clock;
+
+size_t NHandoffs = 100000;
+std::chrono::microseconds Work(0);
+
+static void DoWork()
+{
+    if (Work.count() > 0)
+    {
+        const auto end = Clock::now() + Work;
+        while (Clock::now() < end)
+        {
+        }
+    }
+}
+
+static void Report(const std::string &name, const Clock::time_point start,
+                   const std::clock_t cpuStart)
+{
+    const double wall =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    const double cpu =
+        static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(12)
+              << wall * 1e6 / static_cast<double>(NHandoffs)
+              << " us/handoff" << std::setprecision(1) << std::setw(10)
+              << 100.0 * cpu / wall << " % CPU" << std::endl;
+}
+
+/* The old way: sleep 10us between checks of the turn */
+static void PollPingPong()
+{
+    std::atomic<uint32_t> turn(0);
+    auto player = [&](const uint32_t me) {
+        for (uint32_t i = me; i < 2 * NHandoffs; i += 2)
+        {
+            while (turn.load(std::memory_order_acquire) != i)
+            {
+                std::this_thread::sleep_for(
+                    std::chrono::duration<double>(0.00001));
+            }
+            DoWork();
+            turn.store(i + 1, std::memory_order_release);
+        }
+    };
+    const auto start = Clock::now();
+    const std::clock_t cpuStart = std::clock();
+    std::thread other(player, 1);
+    player(0);
+    other.join();
+    Report("sleep-poll", start, cpuStart);
+}
+
+/* Spin briefly, then block in the kernel (see MPIShmChain::WaitForTurn) */
+static void WaitPingPong()
+{
+    std::atomic<uint32_t> turn(0);
+    std::atomic<uint32_t> waiters(0);
+    auto player = [&](const uint32_t me) {
+        for (uint32_t i = me; i < 2 * NHandoffs; i += 2)
+        {
+            uint32_t t = turn.load(std::memory_order_acquire);
+            if (t != i)
+            {
+                waiters.fetch_add(1);
+                while ((t = turn.load()) != i)
+                {
+                    adios2::shm::AtomicWait(turn, t);
+                }
+                waiters.fetch_sub(1);
+            }
+            DoWork();
+            turn.store(i + 1);
+            if (waiters.load())
+            {
+                adios2::shm::AtomicNotifyAll(turn);
+            }
+        }
+    };
+    const auto start = Clock::now();
+    const std::clock_t cpuStart = std::clock();
+    std::thread other(player, 1);
+    player(0);
+    other.join();
+    Report("wait/notify", start, cpuStart);
+}
+
+/* The old shm::Spinlock: sleep 10us between attempts to take the lock */
+class SleepLock
+{
+public:
+    SleepLock() { flag_.clear(); }
+    void lock()
+    {
+        while (flag_.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(
+                std::chrono::duration<double>(0.00001));
+        }
+    }
+    void unlock() { flag_.clear(std::memory_order_release); }
+
+private:
+    std::atomic_flag flag_;
+};
+
+/* Both threads take the lock and work while holding it, so that the other
+   one has to wait for the lock most of the time */
+template <class Lock>
+static void LockPingPong(const std::string &name)
+{
+    Lock lock;
+    auto player = [&](const size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            lock.lock();
+            DoWork();
+            lock.unlock();
+        }
+    };
+    const auto start = Clock::now();
+    const std::clock_t cpuStart = std::clock();
+    std::thread other(player, NHandoffs / 2);
+    player(NHandoffs - NHandoffs / 2);
+    other.join();
+    Report(name, start, cpuStart);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        NHandoffs = std::strtoull(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+        Work = std::chrono::microseconds(std::strtoll(argv[2], nullptr, 10));
+    }
+    if (!NHandoffs)
+    {
+        std::cerr << "Usage: " << argv[0] << " [handoffs] [work-us]"
+                  << std::endl;
+        return 1;
+    }
+    std::cout << NHandoffs << " handoffs, " << Work.count()
+              << " us work per handoff, "
+              << std::thread::hardware_concurrency() << " hardware threads"
+              << std::endl;
+    PollPingPong();
+    WaitPingPong();
+    LockPingPong<SleepLock>("sleep-lock");
+    LockPingPong<adios2::shm::Spinlock>("Spinlock");
+    return 0;
+}
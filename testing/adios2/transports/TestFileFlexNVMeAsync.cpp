@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+#include <tuple>
+
+// (queue_depth, object_cache_size)
+using ParamType = std::tuple<size_t, size_t>;
+
+class AsyncTestSuite : public Disk::DiskTestClassWithParams<ParamType>
+{
+protected:
+    AsyncTestSuite() : Disk::DiskTestClassWithParams<ParamType>(4096, 64, 32) {}
+
+    auto GetAsyncParams() -> adios2::Params
+    {
+        adios2::Params params = GetParams();
+        params["queue_depth"] = std::to_string(std::get<0>(GetParam()));
+        params["object_cache_size"] = std::to_string(std::get<1>(GetParam()));
+        return params;
+    }
+};
+
+const size_t MAX_NUM_CHUNKS = 24;
+
+TEST_P(AsyncTestSuite, CanWriteAndReadMultipleChunksAsyncTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetAsyncParams());
+
+    transport.Open("helloworld", adios2::Mode::Write, true);
+
+    Rng rng;
+    const size_t MIN_NUM_CHUNKS = 2;
+    size_t bufferSize = rng.RandRange(MIN_NUM_CHUNKS * m_blockSize,
+                                      MAX_NUM_CHUNKS * m_blockSize);
+
+    std::string data = rng.RandString(bufferSize - 1);
+
+    transport.Write(data.c_str(), bufferSize, 0);
+    transport.Flush();
+
+    std::string readData(bufferSize, '\0');
+    transport.Read(&readData[0], bufferSize, 0);
+    readData.pop_back();
+
+    ASSERT_EQ(data, readData);
+}
+
+TEST_P(AsyncTestSuite, CannotReadNonExistentChunkAsyncTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetAsyncParams());
+
+    transport.Open("helloworld", adios2::Mode::Write, true);
+
+    std::string data(m_blockSize, 'a');
+    transport.Write(data.c_str(), m_blockSize, 0);
+
+    // The second chunk does not exist
+    std::string readData(2 * m_blockSize, '\0');
+    ASSERT_ANY_THROW(transport.Read(&readData[0], 2 * m_blockSize, 0));
+}
+
+TEST_P(AsyncTestSuite, FailedRequestsLeaveNoStaleErrorAsyncTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetAsyncParams());
+
+    transport.Open("helloworld", adios2::Mode::Write, true);
+
+    // One full chunk followed by three half chunks
+    std::string data(m_blockSize, 'a');
+    std::string half(m_blockSize / 2, 'b');
+    transport.Write(data.c_str(), m_blockSize, 0);
+    for (size_t chunk = 1; chunk < 4; ++chunk)
+    {
+        transport.Write(half.c_str(), half.size(), chunk * m_blockSize);
+    }
+
+    // The requests for all but the first chunk come up short
+    std::string readData(4 * m_blockSize, '\0');
+    ASSERT_ANY_THROW(transport.Read(&readData[0], 4 * m_blockSize, 0));
+
+    // None of the failed requests is left to fail a later call
+    std::string readBack(m_blockSize, '\0');
+    ASSERT_NO_THROW(transport.Read(&readBack[0], m_blockSize, 0));
+    ASSERT_EQ(data, readBack);
+    ASSERT_NO_THROW(transport.Flush());
+    ASSERT_NO_THROW(transport.Close());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FlexNVMe, AsyncTestSuite,
+    ::testing::Combine(::testing::Values<size_t>(1, 4, 16),
+                       ::testing::Values<size_t>(0, 1, 16)));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
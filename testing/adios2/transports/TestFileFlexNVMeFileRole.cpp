@@ -0,0 +1,144 @@
+#include <adios2.h>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+#include <vector>
+
+class FileRoleTestSuite : public Disk::DiskTestClass
+{
+protected:
+    FileRoleTestSuite()
+    : Disk::DiskTestClass(4096, 64, 32), m_metadataDisk(4096, 64, 32)
+    {
+    }
+
+    // Large objects for data, the metadata device keeps small ones
+    auto GetRoleParams() -> adios2::Params
+    {
+        adios2::Params params = GetParams();
+        params["object_size"] = std::to_string(4 * m_blockSize);
+        params["metadata_device_url"] = m_metadataDisk.device.GetDeviceUrl();
+        params["metadata_object_size"] = std::to_string(m_blockSize);
+        return params;
+    }
+
+    Disk::BaseDiskTestClass m_metadataDisk;
+};
+
+TEST_F(FileRoleTestSuite, UsesMetadataObjectSizeTest)
+{
+    adios2::Params params = GetRoleParams();
+
+    adios2::transport::FileFlexNVMe data(adios2::helper::CommDummy());
+    data.SetParameters(params);
+    data.Open("data.0", adios2::Mode::Write);
+    ASSERT_EQ(4 * m_blockSize, data.GetPreferredStripeSize());
+
+    params["FileRole"] = "metadata";
+    adios2::transport::FileFlexNVMe metadata(adios2::helper::CommDummy());
+    metadata.SetParameters(params);
+    metadata.Open("md.0", adios2::Mode::Write);
+    ASSERT_EQ(m_blockSize, metadata.GetPreferredStripeSize());
+}
+
+TEST_F(FileRoleTestSuite, CanWriteAndReadMetadataTest)
+{
+    Rng rng;
+    std::string data = rng.RandString(3 * m_blockSize + 1);
+
+    adios2::Params params = GetRoleParams();
+    params["FileRole"] = "metadata";
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(params);
+    writer.Open("md.0", adios2::Mode::Write);
+    writer.Write(data.c_str(), data.size(), 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(params);
+    reader.Open("md.0", adios2::Mode::Read);
+    ASSERT_EQ(data.size(), reader.GetSize());
+
+    std::string readData(data.size(), '\0');
+    reader.Read(&readData[0], data.size(), 0);
+    ASSERT_EQ(data, readData);
+
+    // Stored on the metadata device only
+    adios2::transport::FileFlexNVMe dataReader(adios2::helper::CommDummy());
+    dataReader.SetParameters(GetRoleParams());
+    dataReader.Open("md.0", adios2::Mode::Read);
+    ASSERT_THROW(dataReader.GetSize(), std::invalid_argument);
+}
+
+TEST_F(FileRoleTestSuite, CannotShareDeviceBetweenObjectSizesTest)
+{
+    adios2::Params params = GetRoleParams();
+    params.erase("metadata_device_url");
+
+    adios2::transport::FileFlexNVMe data(adios2::helper::CommDummy());
+    data.SetParameters(params);
+    data.Open("data.0", adios2::Mode::Write);
+
+    params["FileRole"] = "metadata";
+    adios2::transport::FileFlexNVMe metadata(adios2::helper::CommDummy());
+    metadata.SetParameters(params);
+    ASSERT_THROW(metadata.Open("md.0", adios2::Mode::Write),
+                 std::invalid_argument);
+}
+
+TEST_F(FileRoleTestSuite, BP5KeepsMetadataApartTest)
+{
+    adios2::Params params = GetRoleParams();
+    const std::vector<double> values = {1.0, 2.0, 3.0, 4.0};
+
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("writer");
+        io.SetEngine("BP5");
+        io.AddTransport("File", params);
+        auto var = io.DefineVariable<double>("values", {values.size()}, {0},
+                                             {values.size()});
+
+        adios2::Engine writer = io.Open("role.bp", adios2::Mode::Write);
+        for (int step = 0; step < 3; ++step)
+        {
+            writer.BeginStep();
+            writer.Put(var, values.data());
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("reader");
+    io.SetEngine("BP5");
+    io.AddTransport("File", params);
+
+    adios2::Engine reader = io.Open("role.bp", adios2::Mode::Read);
+    size_t steps = 0;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        auto var = io.InquireVariable<double>("values");
+        std::vector<double> readValues;
+        reader.Get(var, readValues, adios2::Mode::Sync);
+        reader.EndStep();
+        ASSERT_EQ(values, readValues);
+        steps++;
+    }
+    reader.Close();
+    ASSERT_EQ(3, steps);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -102,6 +102,47 @@ TEST_F(GetSizeTestSuite, CanGetSizeOfSingleByteChunkTest)
     ASSERT_EQ(dataSize, transport.GetSize());
 }
 
+TEST_F(GetSizeTestSuite, CanGetSizeOfSparseChunksFromReaderTest)
+{
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    size_t startChunk = rng.RandRange(1, MAX_NUM_CHUNKS);
+    size_t dataSize = rng.RandRange(1, m_blockSize);
+
+    // Chunks before startChunk are never written
+    std::string data = rng.RandString(dataSize);
+    writer.Write(data.c_str(), dataSize, startChunk * m_blockSize);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+
+    ASSERT_EQ(startChunk * m_blockSize + dataSize, reader.GetSize());
+}
+
+TEST_F(GetSizeTestSuite, CanGetSizeAfterTruncateTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetParams());
+
+    transport.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    size_t dataSize =
+        rng.RandRange(2 * m_blockSize, MAX_NUM_CHUNKS * m_blockSize);
+    std::string data = rng.RandString(dataSize);
+    transport.Write(data.c_str(), dataSize, 0);
+
+    size_t newSize = rng.RandRange(1, dataSize - 1);
+    transport.Truncate(newSize);
+
+    ASSERT_EQ(newSize, transport.GetSize());
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
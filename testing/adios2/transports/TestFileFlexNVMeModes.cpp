@@ -0,0 +1,129 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+
+class ModesTestSuite : public Disk::DiskTestClass
+{
+protected:
+    ModesTestSuite() : Disk::DiskTestClass(4096, 64, 32) {}
+};
+
+const size_t MAX_NUM_CHUNKS = 8;
+
+TEST_F(ModesTestSuite, CanAppendToClosedFileTest)
+{
+    Rng rng;
+    size_t origSize = rng.RandRange(1, MAX_NUM_CHUNKS * m_blockSize);
+    size_t appendSize = rng.RandRange(1, MAX_NUM_CHUNKS * m_blockSize);
+    std::string data = rng.RandString(origSize + appendSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), origSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe appender(adios2::helper::CommDummy());
+    appender.SetParameters(GetParams());
+    appender.Open("helloworld", adios2::Mode::Append);
+    ASSERT_EQ(origSize, appender.GetSize());
+
+    // Without an offset, appending starts at the end of the file
+    appender.Write(data.c_str() + origSize, appendSize);
+    ASSERT_EQ(origSize + appendSize, appender.GetSize());
+    appender.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+    ASSERT_EQ(data.size(), reader.GetSize());
+
+    std::string readData(data.size(), '\0');
+    reader.Read(&readData[0], data.size(), 0);
+    ASSERT_EQ(data, readData);
+}
+
+TEST_F(ModesTestSuite, RewriteDropsStaleChunksTest)
+{
+    Rng rng;
+    size_t origSize = MAX_NUM_CHUNKS * m_blockSize;
+    size_t newSize = rng.RandRange(1, m_blockSize);
+    std::string data = rng.RandString(origSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), origSize, 0);
+    writer.Close();
+
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), newSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+    ASSERT_EQ(newSize, reader.GetSize());
+
+    std::string readData(m_blockSize, '\0');
+    ASSERT_THROW(reader.Read(&readData[0], m_blockSize, m_blockSize),
+                 std::invalid_argument);
+}
+
+TEST_F(ModesTestSuite, TruncateReleasesChunksTest)
+{
+    Rng rng;
+    size_t origSize = MAX_NUM_CHUNKS * m_blockSize;
+    size_t numChunks = rng.RandRange(1, MAX_NUM_CHUNKS - 1);
+    std::string data = rng.RandString(origSize);
+
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetParams());
+    transport.Open("helloworld", adios2::Mode::Write);
+    transport.Write(data.c_str(), origSize, 0);
+
+    transport.Truncate(numChunks * m_blockSize);
+    ASSERT_EQ(numChunks * m_blockSize, transport.GetSize());
+
+    std::string readData(m_blockSize, '\0');
+    ASSERT_THROW(
+        transport.Read(&readData[0], m_blockSize, numChunks * m_blockSize),
+        std::invalid_argument);
+    ASSERT_NO_THROW(transport.Read(&readData[0], m_blockSize, 0));
+}
+
+TEST_F(ModesTestSuite, DeleteRemovesFileTest)
+{
+    Rng rng;
+    size_t dataSize = rng.RandRange(1, MAX_NUM_CHUNKS * m_blockSize);
+    std::string data = rng.RandString(dataSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), dataSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe deleter(adios2::helper::CommDummy());
+    deleter.SetParameters(GetParams());
+    deleter.Open("helloworld", adios2::Mode::Read);
+    deleter.Delete();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+    ASSERT_THROW(reader.GetSize(), std::invalid_argument);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
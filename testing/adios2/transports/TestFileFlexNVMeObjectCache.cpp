@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+
+class ObjectCacheTestSuite : public Disk::DiskTestClass
+{
+protected:
+    ObjectCacheTestSuite() : Disk::DiskTestClass(4096, 64, 32) {}
+
+    auto GetCacheParams(size_t cacheSize) -> adios2::Params
+    {
+        adios2::Params params = GetParams();
+        params["object_cache_size"] = std::to_string(cacheSize);
+        return params;
+    }
+};
+
+const size_t NUM_CHUNKS = 8;
+
+TEST_F(ObjectCacheTestSuite, CanWriteAndReadWithCacheDisabledTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetCacheParams(0));
+
+    transport.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    size_t bufferSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(bufferSize - 1);
+
+    transport.Write(data.c_str(), bufferSize, 0);
+
+    std::string readData(bufferSize, '\0');
+    transport.Read(&readData[0], bufferSize, 0);
+    readData.pop_back();
+
+    ASSERT_EQ(data, readData);
+}
+
+TEST_F(ObjectCacheTestSuite, CanWriteAndReadWithCacheSmallerThanFileTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetCacheParams(1));
+
+    transport.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    size_t bufferSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(bufferSize - 1);
+
+    transport.Write(data.c_str(), bufferSize, 0);
+
+    std::string readData(bufferSize, '\0');
+    transport.Read(&readData[0], bufferSize, 0);
+    readData.pop_back();
+
+    ASSERT_EQ(data, readData);
+}
+
+TEST_F(ObjectCacheTestSuite, CountsHitsAndMissesTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetCacheParams(NUM_CHUNKS));
+    transport.InitProfiler(adios2::Mode::Write, adios2::TimeUnit::Microseconds);
+
+    transport.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    size_t bufferSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(bufferSize - 1);
+
+    transport.Write(data.c_str(), bufferSize, 0);
+    transport.Write(data.c_str(), bufferSize, 0);
+
+    auto &counters = transport.m_Profiler.m_Counters;
+    ASSERT_EQ(NUM_CHUNKS, counters["object_cache_misses"]);
+    ASSERT_EQ(NUM_CHUNKS, counters["object_cache_hits"]);
+
+    // Flushing closes every cached handle, so the next write misses again
+    transport.Flush();
+    transport.Write(data.c_str(), m_blockSize, 0);
+    ASSERT_EQ(NUM_CHUNKS + 1, counters["object_cache_misses"]);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
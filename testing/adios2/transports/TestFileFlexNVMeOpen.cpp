@@ -19,6 +19,21 @@ TEST_F(OpenTestSuite, CanOpenTest)
     e.Open("helloworld", adios2::Mode::Write);
 }
 
+TEST_F(OpenTestSuite, AdvertisesAlignmentTest)
+{
+    adios2::transport::FileFlexNVMe e(adios2::helper::CommDummy());
+    e.SetParameters(GetParams());
+
+    e.Open("helloworld", adios2::Mode::Write);
+
+    ASSERT_EQ(m_blockSize, e.GetPreferredStripeSize());
+
+    // An object is a whole number of logical blocks
+    size_t blockSize = e.GetPreferredBlockSize();
+    ASSERT_GT(blockSize, 0);
+    ASSERT_EQ(0, m_blockSize % blockSize);
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// prefetch_depth
+using ParamType = size_t;
+
+class PrefetchTestSuite : public Disk::DiskTestClassWithParams<ParamType>
+{
+protected:
+    PrefetchTestSuite() : Disk::DiskTestClassWithParams<ParamType>(4096, 64, 32)
+    {
+    }
+
+    auto GetPrefetchParams() -> adios2::Params
+    {
+        adios2::Params params = GetParams();
+        params["prefetch_depth"] = std::to_string(GetParam());
+        return params;
+    }
+
+    // Ranges of random length with random gaps between them, sorted by
+    // start as BP5Reader hands them over
+    auto RandRanges(Rng &rng, size_t fileSize)
+        -> std::vector<std::pair<size_t, size_t>>
+    {
+        std::vector<std::pair<size_t, size_t>> ranges;
+        size_t position = rng.RandRange(0, m_blockSize);
+        while (position < fileSize)
+        {
+            size_t length = rng.RandRange(1, 2 * m_blockSize);
+            length = std::min(length, fileSize - position);
+            ranges.emplace_back(position, length);
+            position += length + rng.RandRange(0, m_blockSize);
+        }
+        return ranges;
+    }
+};
+
+const size_t NUM_CHUNKS = 16;
+
+TEST_P(PrefetchTestSuite, CanReadPrefetchedRangesTest)
+{
+    Rng rng;
+    const size_t fileSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(fileSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetPrefetchParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), fileSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetPrefetchParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+
+    auto ranges = RandRanges(rng, fileSize);
+    reader.Prefetch(ranges);
+    for (const auto &range : ranges)
+    {
+        std::string readData(range.second, '\0');
+        reader.Read(&readData[0], range.second, range.first);
+        ASSERT_EQ(data.substr(range.first, range.second), readData);
+    }
+}
+
+TEST_P(PrefetchTestSuite, CanReadOutsideHintsTest)
+{
+    Rng rng;
+    const size_t fileSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(fileSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetPrefetchParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), fileSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetPrefetchParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+
+    // Hint the second half, then read all of it backwards
+    reader.Prefetch({{fileSize / 2, fileSize / 2}});
+    for (size_t chunk = NUM_CHUNKS; chunk > 0; --chunk)
+    {
+        const size_t start = (chunk - 1) * m_blockSize;
+        std::string readData(m_blockSize, '\0');
+        reader.Read(&readData[0], m_blockSize, start);
+        ASSERT_EQ(data.substr(start, m_blockSize), readData);
+    }
+}
+
+TEST_P(PrefetchTestSuite, WriteDropsPrefetchedDataTest)
+{
+    Rng rng;
+    const size_t fileSize = 4 * m_blockSize;
+    std::string data = rng.RandString(fileSize);
+    std::string newData = rng.RandString(fileSize);
+
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetPrefetchParams());
+    transport.Open("helloworld", adios2::Mode::Write);
+    transport.Write(data.c_str(), fileSize, 0);
+
+    transport.Prefetch({{0, fileSize}});
+    transport.Write(newData.c_str(), fileSize, 0);
+
+    std::string readData(fileSize, '\0');
+    transport.Read(&readData[0], fileSize, 0);
+    ASSERT_EQ(newData, readData);
+}
+
+INSTANTIATE_TEST_SUITE_P(FlexNVMe, PrefetchTestSuite,
+                         ::testing::Values<size_t>(0, 1, 4, 32));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
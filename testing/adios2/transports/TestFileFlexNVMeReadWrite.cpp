@@ -10,6 +10,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <vector>
 
 class ReadWriteTestSuite : public Disk::DiskTestClass
 {
@@ -224,6 +225,39 @@ TEST_F(ReadWriteTestSuite, CanAppendDataTest)
     ASSERT_EQ(data, readData);
 }
 
+TEST_F(ReadWriteTestSuite, CanWriteVAcrossChunksTest)
+{
+    adios2::transport::FileFlexNVMe transport(adios2::helper::CommDummy());
+    transport.SetParameters(GetParams());
+
+    transport.Open("helloworld", adios2::Mode::Write);
+
+    Rng rng;
+    const size_t NUM_SEGMENTS = 32;
+    std::vector<std::string> segments;
+    std::string data;
+    for (size_t i = 0; i < NUM_SEGMENTS; i++)
+    {
+        // Mix of segments smaller and larger than a chunk
+        segments.push_back(rng.RandString(rng.RandRange(1, 2 * m_blockSize)));
+        data += segments.back();
+    }
+
+    std::vector<adios2::core::iovec> iov;
+    for (const std::string &segment : segments)
+    {
+        iov.push_back({segment.data(), segment.size()});
+    }
+
+    const size_t writeOffset = rng.RandRange(0, m_blockSize);
+    transport.WriteV(iov.data(), static_cast<int>(iov.size()), writeOffset);
+
+    std::string readData(data.size(), '\0');
+    transport.Read(&readData[0], data.size(), writeOffset);
+
+    ASSERT_EQ(data, readData);
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <string>
+
+// stripe_width
+using ParamType = size_t;
+
+class StripingTestSuite : public Disk::DiskTestClassWithParams<ParamType>
+{
+protected:
+    StripingTestSuite()
+    : Disk::DiskTestClassWithParams<ParamType>(4096, 64, 32),
+      m_secondDisk(4096, 64, 32)
+    {
+    }
+
+    auto GetStripedParams() -> adios2::Params
+    {
+        adios2::Params params = GetParams();
+        params["device_url"] = device.GetDeviceUrl() + "," +
+                               m_secondDisk.device.GetDeviceUrl();
+        params["stripe_width"] = std::to_string(GetParam());
+        return params;
+    }
+
+    Disk::BaseDiskTestClass m_secondDisk;
+};
+
+const size_t MAX_NUM_CHUNKS = 24;
+
+TEST_P(StripingTestSuite, CanWriteAndReadStripedChunksTest)
+{
+    Rng rng;
+    size_t bufferSize =
+        rng.RandRange(2 * m_blockSize, MAX_NUM_CHUNKS * m_blockSize);
+    std::string data = rng.RandString(bufferSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetStripedParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), bufferSize, 0);
+    writer.Close();
+
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetStripedParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+    ASSERT_EQ(bufferSize, reader.GetSize());
+
+    std::string readData(bufferSize, '\0');
+    reader.Read(&readData[0], bufferSize, 0);
+    ASSERT_EQ(data, readData);
+}
+
+TEST_P(StripingTestSuite, CannotReadStripedChunksFromOneDeviceTest)
+{
+    Rng rng;
+    size_t bufferSize = (2 * GetParam() + 1) * m_blockSize;
+    std::string data = rng.RandString(bufferSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetStripedParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), bufferSize, 0);
+    writer.Close();
+
+    // The chunks after the first stripe live on the second device
+    adios2::transport::FileFlexNVMe reader(adios2::helper::CommDummy());
+    reader.SetParameters(GetParams());
+    reader.Open("helloworld", adios2::Mode::Read);
+
+    std::string readData(bufferSize, '\0');
+    ASSERT_THROW(reader.Read(&readData[0], bufferSize, 0),
+                 std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(FlexNVMe, StripingTestSuite,
+                         ::testing::Values<size_t>(1, 3));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
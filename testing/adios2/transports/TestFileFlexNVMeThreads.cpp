@@ -0,0 +1,110 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "adios2/helper/adiosCommDummy.h"
+#include "adios2/toolkit/transport/file/FileFlexNVMe.h"
+
+#include "disk/DiskTestClass.h"
+#include "util.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+// Number of threads, each with its own transport
+using ParamType = size_t;
+
+class ThreadsTestSuite : public Disk::DiskTestClassWithParams<ParamType>
+{
+protected:
+    ThreadsTestSuite() : Disk::DiskTestClassWithParams<ParamType>(4096, 64, 32)
+    {
+    }
+};
+
+const size_t NUM_CHUNKS = 16;
+
+// Mirrors BP5Reader::PerformGets, where each thread opens the file through
+// its own transport and reads a disjoint part of it
+TEST_P(ThreadsTestSuite, CanReadFromSeveralThreadsTest)
+{
+    Rng rng;
+    const size_t bufferSize = NUM_CHUNKS * m_blockSize;
+    std::string data = rng.RandString(bufferSize);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), bufferSize, 0);
+    writer.Close();
+
+    const size_t numThreads = GetParam();
+    const size_t partSize = bufferSize / numThreads;
+    std::vector<std::future<std::string>> parts;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        parts.push_back(std::async(std::launch::async, [&, t]() {
+            adios2::transport::FileFlexNVMe reader(
+                adios2::helper::CommDummy());
+            reader.SetParameters(GetParams());
+            reader.Open("helloworld", adios2::Mode::Read);
+
+            std::string part(partSize, '\0');
+            reader.Read(&part[0], partSize, t * partSize);
+            reader.Close();
+            return part;
+        }));
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        ASSERT_EQ(data.substr(t * partSize, partSize), parts[t].get());
+    }
+}
+
+// Transports come and go in every thread, the device must stay open while
+// any of them holds it
+TEST_P(ThreadsTestSuite, CanOpenAndCloseFromSeveralThreadsTest)
+{
+    Rng rng;
+    std::string data = rng.RandString(m_blockSize + 1);
+
+    adios2::transport::FileFlexNVMe writer(adios2::helper::CommDummy());
+    writer.SetParameters(GetParams());
+    writer.Open("helloworld", adios2::Mode::Write);
+    writer.Write(data.c_str(), data.size(), 0);
+    writer.Close();
+
+    std::vector<std::future<void>> threads;
+    for (size_t t = 0; t < GetParam(); ++t)
+    {
+        threads.push_back(std::async(std::launch::async, [&]() {
+            for (int i = 0; i < 8; ++i)
+            {
+                adios2::transport::FileFlexNVMe reader(
+                    adios2::helper::CommDummy());
+                reader.SetParameters(GetParams());
+                reader.Open("helloworld", adios2::Mode::Read);
+                ASSERT_EQ(data.size(), reader.GetSize());
+
+                std::string readData(data.size(), '\0');
+                reader.Read(&readData[0], data.size(), 0);
+                ASSERT_EQ(data, readData);
+            }
+        }));
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.get();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FlexNVMe, ThreadsTestSuite,
+                         ::testing::Values<size_t>(1, 2, 4, 8));
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}